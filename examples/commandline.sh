@@ -27,11 +27,12 @@ rm -f rng.state
 echo "Graph Generation: `date +%s`"
 for n in 10 20 30 40 50 100 200 400
 do
+	# generate all the gnp graphs with $n nodes in one pass, one file per
+	# probability. Graphs are nested: each one contains the previous ones.
+	ggen generate-graph gnp-sweep $n 0.05,0.1,0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.9,1 "graphs/$n.%p.dotfile" -l 0 -r rng.state
 	for p in 0.05 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1
 	do
-		# generate a gnp graph with $n nodes and $p probability
 		dotfile="graphs/$n.$p.dotfile"
-		ggen generate-graph gnp $n $p -l 0 -o $dotfile -r rng.state
 		# add a single source to the graph
 		sourcefile="graphs/$n.$p.sourcefile"
 		ggen transform-graph add-source source -l 0 -i $dotfile -o $sourcefile
@@ -70,12 +71,11 @@ do
 	do
 		propfile="graphs/$n.$p.propfile"
 		analysisfile="graphs/$n.$p.analysis"
+		summaryfile="graphs/$n.$p.summary.json"
 		echo "Minimum Spanning Tree" >> $analysisfile
 		ggen analyse-graph mst -i $propfile -l 0 >> $analysisfile
-		echo "Longest Path" >> $analysisfile
-		ggen analyse-graph lp -i $propfile -l 0 >> $analysisfile
-		echo "Outdegree" >> $analysisfile
-		ggen analyse-graph out-degree -i $propfile -l 0 >> $analysisfile
+		# depth, degrees and the other metrics in a single read of the graph
+		ggen analyse-graph summary -i $propfile -l 0 --vertex-weight weight --edge-weight size -o $summaryfile
 	done
 done
 
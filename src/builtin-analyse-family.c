@@ -0,0 +1,190 @@
+/* Copyright Swann Perarnau 2009
+*
+*   contact : Swann.Perarnau@imag.fr
+*
+* This software is a computer program whose purpose is to help the
+* random generation of graph structures and adding various properties
+* on those structures.
+*
+* This software is governed by the CeCILL  license under French law and
+* abiding by the rules of distribution of free software.  You can  use,
+* modify and/ or redistribute the software under the terms of the CeCILL
+* license as circulated by CEA, CNRS and INRIA at the following URL
+* "http://www.cecill.info".
+*
+* As a counterpart to the access to the source code and  rights to copy,
+* modify and redistribute granted by the license, users are provided only
+* with a limited warranty  and the software's author,  the holder of the
+* economic rights,  and the successive licensors  have only  limited
+* liability.
+*
+* In this respect, the user's attention is drawn to the risks associated
+* with loading,  using,  modifying and/or developing or reproducing the
+* software by the user in light of its specific status of free software,
+* that may mean  that it is complicated to manipulate,  and  that  also
+* therefore means  that it is reserved for developers  and  experienced
+* professionals having in-depth computer knowledge. Users are therefore
+* encouraged to load and test the software's suitability as regards their
+* requirements in conditions enabling the security of their systems and/or
+* data to be ensured and,  more generally, to use and operate it in the
+* same conditions as regards security.
+*
+* The fact that you are presently reading this means that you have had
+* knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* GGen is a random graph generator :
+* it provides means to generate a graph following a
+* collection of methods found in the litterature.
+*
+* This is a research project founded by the MOAIS Team,
+* INRIA, Grenoble Universities.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "builtin.h"
+#include "ggen.h"
+#include "utils.h"
+
+/* cmd declarations, we need this to be able to declare
+ * the general struct
+ */
+static int cmd_cholesky(int argc, char** argv);
+static int cmd_denselu(int argc, char** argv);
+static int cmd_fibonacci(int argc, char** argv);
+static int cmd_forkjoin(int argc, char** argv);
+static int cmd_strassen(int argc, char** argv);
+
+const char* help_analyse_family[] = {
+	"Families:\n",
+	"cholesky                     : block cholesky factorization\n",
+	"denselu                      : dense LU decomposition\n",
+	"fibonacci                    : recursive fibonacci\n",
+	"forkjoin                     : fork-join graphs\n",
+	"strassen                     : fast matrix multiply\n",
+	"The properties of the graph the generator of the same name would\n",
+	"build are computed from its arguments alone.\n",
+	NULL
+};
+
+static const char* cholesky_help[] = {
+	"\nCholesky:\n",
+	"Arguments:\n",
+	"     - n                     : size of matrix in blocks\n",
+	NULL
+};
+
+static const char* denselu_help[] = {
+	"\nDense LU:\n",
+	"Arguments:\n",
+	"     - size                  : size of one side of the matrix in blocks\n",
+	NULL
+};
+
+static const char* fibonacci_help[] = {
+	"\nFibonacci:\n",
+	"Arguments:\n",
+	"     - n                     : fibonacci number to `compute`\n",
+	"     - cutoff                : tasks not generated for smaller values\n",
+	NULL
+};
+
+static const char* forkjoin_help[] = {
+	"\nFork-Join:\n",
+	"Arguments:\n",
+	"     - phases                : number of phases\n",
+	"     - diameter              : number of forks per phase\n",
+	NULL
+};
+
+static const char* strassen_help[] = {
+	"\nStrassen:\n",
+	"Arguments:\n",
+	"     - size                  : size of one side of the matrix\n",
+	"     - depth                 : depth cutoff point\n",
+	"     - cutoff                : size cutoff point\n",
+	NULL
+};
+
+struct second_lvl_cmd cmds_analyse_family[] = {
+	{ "cholesky" , 1, cholesky_help , cmd_cholesky  },
+	{ "denselu"  , 1, denselu_help  , cmd_denselu   },
+	{ "fibonacci", 2, fibonacci_help, cmd_fibonacci },
+	{ "forkjoin" , 2, forkjoin_help , cmd_forkjoin  },
+	{ "strassen" , 3, strassen_help , cmd_strassen  },
+	{ 0, 0, 0, 0},
+};
+
+/* the arguments of all families are integers, in the order of their
+ * generator
+ */
+static int analyse_family(const char *family, int argc, char **argv)
+{
+	int err = 0;
+	unsigned long params[3],i;
+	int j;
+	struct ggen_family_metrics m;
+	igraph_strvector_t kernels;
+	igraph_vector_t counts;
+
+	for(j = 0; j < argc; j++)
+	{
+		err = s2ul(argv[j],&params[j]);
+		if(err) return err;
+	}
+
+	err = igraph_strvector_init(&kernels,0);
+	if(err) goto ret;
+	err = igraph_vector_init(&counts,0);
+	if(err) goto names;
+
+	if(ggen_analyze_family(family,params,argc,&m,&kernels,&counts))
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		igraph_vector_destroy(&counts);
+		igraph_strvector_destroy(&kernels);
+		return 1;
+	}
+
+	fprintf(outfile,"vertices: %lu\nedges: %lu\ncritical-path: %lu\n"
+		"width: %lu\n",m.vertices,m.edges,m.critical_path,m.width);
+	/* same format as analyse-graph kernel-count */
+	for(i = 0; i < igraph_strvector_size(&kernels); i++)
+		if(VECTOR(counts)[i] > 0)
+			fprintf(outfile,"%s,%lu\n",STR(kernels,i),
+				(unsigned long)VECTOR(counts)[i]);
+	igraph_vector_destroy(&counts);
+names:
+	igraph_strvector_destroy(&kernels);
+ret:
+	if(err)
+		error("igraph error: %s\n",igraph_strerror(err));
+	return err;
+}
+
+static int cmd_cholesky(int argc, char** argv)
+{
+	return analyse_family("cholesky",argc,argv);
+}
+
+static int cmd_denselu(int argc, char** argv)
+{
+	return analyse_family("denselu",argc,argv);
+}
+
+static int cmd_fibonacci(int argc, char** argv)
+{
+	return analyse_family("fibonacci",argc,argv);
+}
+
+static int cmd_forkjoin(int argc, char** argv)
+{
+	return analyse_family("forkjoin",argc,argv);
+}
+
+static int cmd_strassen(int argc, char** argv)
+{
+	return analyse_family("strassen",argc,argv);
+}
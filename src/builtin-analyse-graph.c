@@ -65,6 +65,16 @@ const char* help_analyse[] = {
 	"longest-antichain    : computes the longest antichain of the graph\n",
 	"lsa                  : computes the lowest single ancestor of all vertices in the graph\n",
 	"edge-disjoint-paths  : computes a set of edge-disjoint paths in the graph\n",
+	"                       methods: shortest (default), minimum\n",
+	"kernel-count         : gives the number of tasks of each kernel type\n",
+	"critical-path        : computes the weighted critical path, with the top level,\n",
+	"                       bottom level and slack of each vertex\n",
+	"chains               : computes a minimum chain decomposition of the graph,\n",
+	"                       with the chain of each vertex\n",
+	"summary              : computes several metrics at once, on a single\n",
+	"                       record written as json (default) or csv\n",
+	"                       metrics: counts, degrees, ends, depth,\n",
+	"                       critical-path, width, levels, transitive\n",
 	NULL,
 };
 
@@ -306,16 +316,33 @@ static int cmd_lsa(int argc, char **argv)
 static int cmd_edge_disjoint_paths(int argc, char **argv)
 {
 	int err = 0;
-	unsigned long i,cnt;
+	unsigned long i;
 	char name[GGEN_DEFAULT_NAME_SIZE];
 	char *s = NULL;
-	igraph_vector_t *paths;
+	igraph_vector_t paths;
 	igraph_integer_t from, to;
+	enum ggen_paths_t m;
+
+	if(method == NULL || !strcmp(method,"shortest"))
+		m = GGEN_PATHS_SHORTEST;
+	else if(!strcmp(method,"minimum"))
+		m = GGEN_PATHS_MINIMUM;
+	else
+	{
+		error("Unknown method %s\n",method);
+		return 1;
+	}
 
-	paths = ggen_analyze_edge_disjoint_paths(&g);
-	if(paths == NULL)
+	err = igraph_vector_init(&paths,0);
+	if(err)
+	{
+		error("igraph error: %s\n",igraph_strerror(err));
+		return err;
+	}
+	if(ggen_analyze_path_decomposition(&g,m,&paths,NULL))
 	{
 		error("ggen error: %s\n",ggen_error_strerror());
+		igraph_vector_destroy(&paths);
 		return 1;
 	}
 
@@ -325,13 +352,355 @@ static int cmd_edge_disjoint_paths(int argc, char **argv)
 		s = ggen_vname(&g, name, (unsigned long)from);
 		fprintf(outfile,"%s -> ",s==NULL?name:s);
 		s = ggen_vname(&g, name, (unsigned long)to);
-		fprintf(outfile,"%s : %lu\n",s==NULL?name:s, (unsigned long)VECTOR(*paths)[i]);
+		fprintf(outfile,"%s : %lu\n",s==NULL?name:s, (unsigned long)VECTOR(paths)[i]);
 	}
-	igraph_vector_destroy(paths);
-	free(paths);
+	igraph_vector_destroy(&paths);
 	return 0;
 }
 
+static int cmd_kernel_count(int argc, char **argv)
+{
+	int err = 0;
+	unsigned long i;
+	igraph_strvector_t names;
+	igraph_vector_t types, count;
+
+	err = igraph_strvector_init(&names,0);
+	if(err) goto ret;
+	err = igraph_vector_init(&types,0);
+	if(err) goto names;
+
+	if(ggen_get_kernels(&g,&names,&types))
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		igraph_vector_destroy(&types);
+		igraph_strvector_destroy(&names);
+		return 1;
+	}
+
+	err = igraph_vector_init(&count,igraph_strvector_size(&names));
+	if(err) goto types;
+
+	/* kernel types are indexes, no need to compare names */
+	for(i = 0; i < igraph_vcount(&g); i++)
+		if(VECTOR(types)[i] >= 0)
+			VECTOR(count)[(long)VECTOR(types)[i]]++;
+
+	for(i = 0; i < igraph_strvector_size(&names); i++)
+		if(VECTOR(count)[i] > 0)
+			fprintf(outfile,"%s,%lu\n",STR(names,i),
+				(unsigned long)VECTOR(count)[i]);
+	igraph_vector_destroy(&count);
+types:
+	igraph_vector_destroy(&types);
+names:
+	igraph_strvector_destroy(&names);
+ret:
+	if(err)
+		error("igraph error: %s\n",igraph_strerror(err));
+	return err;
+}
+
+/* weights come from --vertex-weight and --edge-weight, with --annotate the
+ * levels are written back into the graph instead of being printed.
+ */
+static int cmd_critical_path(int argc, char **argv)
+{
+	int err = 0, status = 0;
+	unsigned long i;
+	char name[GGEN_DEFAULT_NAME_SIZE];
+	char *s = NULL;
+	igraph_vector_t path, top, bottom, slack;
+	double length;
+
+	err = igraph_vector_init(&path,0);
+	if(err) goto ret;
+	err = igraph_vector_init(&top,0);
+	if(err) goto path;
+	err = igraph_vector_init(&bottom,0);
+	if(err) goto top;
+	err = igraph_vector_init(&slack,0);
+	if(err) goto bottom;
+
+	if(ggen_analyze_critical_path(&g,vertex_weight,edge_weight,&path,&top,
+				      &bottom,&slack,&length))
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		igraph_vector_destroy(&slack);
+		igraph_vector_destroy(&bottom);
+		igraph_vector_destroy(&top);
+		igraph_vector_destroy(&path);
+		return 1;
+	}
+
+	if(annotate)
+	{
+		err = SETVANV(&g,"top_level",&top);
+		if(!err)
+			err = SETVANV(&g,"bottom_level",&bottom);
+		if(!err)
+			err = SETVANV(&g,"slack",&slack);
+		if(!err)
+			err = SETGAN(&g,"critical_path",length);
+		if(!err && ggen_write_graph(&g,outfile))
+		{
+			error("Writing graph failed\n");
+			status = 1;
+		}
+		goto slack;
+	}
+
+	fprintf(outfile,"length: %g\n",length);
+	fprintf(outfile,"path: ");
+	for(i = 0; i < igraph_vector_size(&path); i++)
+	{
+		s = ggen_vname(&g, name, (unsigned long)VECTOR(path)[i]);
+		fprintf(outfile,"%s%s",i ? "," : "",s==NULL?name:s);
+	}
+	fprintf(outfile,"\n");
+	for(i = 0; i < igraph_vcount(&g); i++)
+	{
+		s = ggen_vname(&g, name, i);
+		fprintf(outfile,"%s,%g,%g,%g\n",s==NULL?name:s,VECTOR(top)[i],
+			VECTOR(bottom)[i],VECTOR(slack)[i]);
+	}
+slack:
+	igraph_vector_destroy(&slack);
+bottom:
+	igraph_vector_destroy(&bottom);
+top:
+	igraph_vector_destroy(&top);
+path:
+	igraph_vector_destroy(&path);
+ret:
+	if(err)
+		error("igraph error: %s\n",igraph_strerror(err));
+	return err ? err : status;
+}
+
+static int cmd_chains(int argc, char **argv)
+{
+	int err = 0, status = 0;
+	unsigned long i,width;
+	char name[GGEN_DEFAULT_NAME_SIZE];
+	char *s = NULL;
+	igraph_vector_t chains;
+
+	err = igraph_vector_init(&chains,0);
+	if(err) goto ret;
+
+	if(ggen_analyze_chain_decomposition(&g,&chains,NULL,&width))
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		igraph_vector_destroy(&chains);
+		return 1;
+	}
+
+	if(annotate)
+	{
+		err = SETVANV(&g,"chain",&chains);
+		if(!err)
+			err = SETGAN(&g,"width",width);
+		if(!err && ggen_write_graph(&g,outfile))
+		{
+			error("Writing graph failed\n");
+			status = 1;
+		}
+		goto chains;
+	}
+
+	fprintf(outfile,"width: %lu\n",width);
+	for(i = 0; i < igraph_vcount(&g); i++)
+	{
+		s = ggen_vname(&g, name, i);
+		fprintf(outfile,"%s,%lu\n",s==NULL?name:s,
+			(unsigned long)VECTOR(chains)[i]);
+	}
+chains:
+	igraph_vector_destroy(&chains);
+ret:
+	if(err)
+		error("igraph error: %s\n",igraph_strerror(err));
+	return err ? err : status;
+}
+
+/* summary metrics, in the order of the output */
+static const struct {
+	const char *name;
+	unsigned int flag;
+} summary_metrics[] = {
+	{ "counts", GGEN_SUMMARY_COUNTS },
+	{ "degrees", GGEN_SUMMARY_DEGREES },
+	{ "ends", GGEN_SUMMARY_ENDS },
+	{ "depth", GGEN_SUMMARY_DEPTH },
+	{ "critical-path", GGEN_SUMMARY_CRITICAL_PATH },
+	{ "width", GGEN_SUMMARY_WIDTH },
+	{ "levels", GGEN_SUMMARY_LEVELS },
+	{ "transitive", GGEN_SUMMARY_TRANSITIVE },
+};
+
+/* parse the comma-separated list of --metrics, all of them by default */
+static int parse_metrics(const char *list, unsigned int *flags)
+{
+	const char *p = list;
+	size_t len;
+	int i;
+
+	if(list == NULL)
+	{
+		*flags = GGEN_SUMMARY_ALL;
+		return 0;
+	}
+	*flags = 0;
+	while(*p != '\0')
+	{
+		len = strcspn(p,",");
+		for(i = 0; i < ARRAY_SIZE(summary_metrics); i++)
+			if(strlen(summary_metrics[i].name) == len &&
+			   !strncmp(summary_metrics[i].name,p,len))
+				break;
+		if(i == ARRAY_SIZE(summary_metrics))
+		{
+			error("Unknown metric %.*s\n",(int)len,p);
+			return 1;
+		}
+		*flags |= summary_metrics[i].flag;
+		p += len;
+		if(*p == ',')
+			p++;
+	}
+	if(*flags == 0)
+	{
+		error("No metric selected\n");
+		return 1;
+	}
+	return 0;
+}
+
+/* a distribution, as a json array or space-separated for csv */
+static void print_distribution(const igraph_vector_t *v, int json)
+{
+	long i;
+
+	fprintf(outfile,"%s",json ? "[" : "");
+	for(i = 0; i < igraph_vector_size(v); i++)
+		fprintf(outfile,"%s%lu",i ? (json ? "," : " ") : "",
+			(unsigned long)VECTOR(*v)[i]);
+	fprintf(outfile,"%s",json ? "]" : "");
+}
+
+/* the graph is read and checked once, and all the metrics share the same
+ * sweeps, see ggen_analyze_summary. json gives one object per line, csv a
+ * header line and a row.
+ */
+static int cmd_summary(int argc, char **argv)
+{
+	unsigned int flags;
+	int json, i, first = 1;
+	struct ggen_summary sum;
+
+	if(summary_format == NULL || !strcmp(summary_format,"json"))
+		json = 1;
+	else if(!strcmp(summary_format,"csv"))
+		json = 0;
+	else
+	{
+		error("Unknown format %s\n",summary_format);
+		return 1;
+	}
+	if(parse_metrics(metrics,&flags))
+		return 1;
+
+	if(ggen_analyze_summary(&g,flags,vertex_weight,edge_weight,&sum))
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		return 1;
+	}
+
+	if(!json)
+	{
+		for(i = 0; i < ARRAY_SIZE(summary_metrics); i++)
+		{
+			if(!(flags & summary_metrics[i].flag))
+				continue;
+			switch(summary_metrics[i].flag)
+			{
+				case GGEN_SUMMARY_COUNTS:
+					fprintf(outfile,"%svertices,edges",
+						first ? "" : ",");
+					break;
+				case GGEN_SUMMARY_DEGREES:
+					fprintf(outfile,"%sin_degrees,out_degrees",
+						first ? "" : ",");
+					break;
+				case GGEN_SUMMARY_ENDS:
+					fprintf(outfile,"%ssources,sinks",
+						first ? "" : ",");
+					break;
+				case GGEN_SUMMARY_CRITICAL_PATH:
+					fprintf(outfile,"%scritical_path",
+						first ? "" : ",");
+					break;
+				default:
+					fprintf(outfile,"%s%s",first ? "" : ",",
+						summary_metrics[i].name);
+			}
+			first = 0;
+		}
+		fprintf(outfile,"\n");
+		first = 1;
+	}
+	else
+		fprintf(outfile,"{");
+
+	for(i = 0; i < ARRAY_SIZE(summary_metrics); i++)
+	{
+		if(!(flags & summary_metrics[i].flag))
+			continue;
+		fprintf(outfile,"%s",first ? "" : ",");
+		first = 0;
+		switch(summary_metrics[i].flag)
+		{
+			case GGEN_SUMMARY_COUNTS:
+				fprintf(outfile,json ? "\"vertices\":%lu,\"edges\":%lu"
+					: "%lu,%lu",sum.vertices,sum.edges);
+				break;
+			case GGEN_SUMMARY_DEGREES:
+				fprintf(outfile,"%s",json ? "\"in_degrees\":" : "");
+				print_distribution(&sum.in_degrees,json);
+				fprintf(outfile,"%s",json ? ",\"out_degrees\":" : ",");
+				print_distribution(&sum.out_degrees,json);
+				break;
+			case GGEN_SUMMARY_ENDS:
+				fprintf(outfile,json ? "\"sources\":%lu,\"sinks\":%lu"
+					: "%lu,%lu",sum.sources,sum.sinks);
+				break;
+			case GGEN_SUMMARY_DEPTH:
+				fprintf(outfile,json ? "\"depth\":%lu" : "%lu",
+					sum.depth);
+				break;
+			case GGEN_SUMMARY_CRITICAL_PATH:
+				fprintf(outfile,json ? "\"critical_path\":%g" : "%g",
+					sum.critical_path);
+				break;
+			case GGEN_SUMMARY_WIDTH:
+				fprintf(outfile,json ? "\"width\":%lu" : "%lu",
+					sum.width);
+				break;
+			case GGEN_SUMMARY_LEVELS:
+				fprintf(outfile,"%s",json ? "\"levels\":" : "");
+				print_distribution(&sum.levels,json);
+				break;
+			case GGEN_SUMMARY_TRANSITIVE:
+				fprintf(outfile,json ? "\"transitive\":%g" : "%g",
+					sum.transitive);
+				break;
+		}
+	}
+	fprintf(outfile,"%s\n",json ? "}" : "");
+	ggen_summary_destroy(&sum);
+	return 0;
+}
 
 struct second_lvl_cmd  cmds_analyse[] = {
 	{ "nb-vertices", 0, NULL, cmd_nb_vertices },
@@ -345,5 +714,9 @@ struct second_lvl_cmd  cmds_analyse[] = {
 	{ "longest-antichain", 0, NULL, cmd_longest_antichain },
 	{ "lsa", 0, NULL, cmd_lsa },
 	{ "edge-disjoint-paths", 0, NULL, cmd_edge_disjoint_paths },
+	{ "kernel-count", 0, NULL, cmd_kernel_count },
+	{ "critical-path", 0, NULL, cmd_critical_path },
+	{ "chains", 0, NULL, cmd_chains },
+	{ "summary", 0, NULL, cmd_summary },
 	{ 0, 0, 0, 0},
 };
@@ -114,14 +114,37 @@ struct second_lvl_cmd cmds_dataflow[] = {
 	{ 0, 0, 0, 0},
 };
 
+/* the --stream option: tasks and their edges are written as soon as they are
+ * traced, the graph is never built. Takes the result of the ggen_stream
+ * function.
+ */
+static int stream_done(struct ggen_edge_sink *sink, int err)
+{
+	if(err)
+		error("ggen error: %s\n",ggen_error_strerror());
+	ggen_edge_sink_free(sink);
+	// the graph is already written
+	g_p = NULL;
+	return err;
+}
+
 static int cmd_cholesky(int argc, char** argv)
 {
 	int err = 0;
+	struct ggen_edge_sink *sink;
 	unsigned long n;
 
 	err = s2ul(argv[0],&n);
 	if(err) goto ret;
 
+	if(stream_format != NULL)
+	{
+		sink = stream_sink(stream_format,outfile);
+		if(sink == NULL)
+			return 1;
+		return stream_done(sink,ggen_stream_cholesky(n,sink));
+	}
+
 	g_p = ggen_generate_cholesky(n);
 	if(g_p == NULL)
 	{
@@ -135,11 +158,20 @@ ret:
 static int cmd_denselu(int argc, char** argv)
 {
 	int err = 0;
+	struct ggen_edge_sink *sink;
 	unsigned long size;
 
 	err = s2ul(argv[0],&size);
 	if(err) goto ret;
 
+	if(stream_format != NULL)
+	{
+		sink = stream_sink(stream_format,outfile);
+		if(sink == NULL)
+			return 1;
+		return stream_done(sink,ggen_stream_denselu(size,sink));
+	}
+
 	g_p = ggen_generate_denselu(size);
 	if(g_p == NULL)
 	{
@@ -153,6 +185,7 @@ ret:
 static int cmd_poisson2d(int argc, char** argv)
 {
 	int err = 0;
+	struct ggen_edge_sink *sink;
 	unsigned long n,iter;
 
 	err = s2ul(argv[0],&n);
@@ -161,6 +194,14 @@ static int cmd_poisson2d(int argc, char** argv)
 	err = s2ul(argv[1],&iter);
 	if(err) goto ret;
 
+	if(stream_format != NULL)
+	{
+		sink = stream_sink(stream_format,outfile);
+		if(sink == NULL)
+			return 1;
+		return stream_done(sink,ggen_stream_poisson2d(n,iter,sink));
+	}
+
 	g_p = ggen_generate_poisson2d(n, iter);
 	if(g_p == NULL)
 	{
@@ -174,11 +215,20 @@ ret:
 static int cmd_sparselu(int argc, char** argv)
 {
 	int err = 0;
+	struct ggen_edge_sink *sink;
 	unsigned long size;
 
 	err = s2ul(argv[0],&size);
 	if(err) goto ret;
 
+	if(stream_format != NULL)
+	{
+		sink = stream_sink(stream_format,outfile);
+		if(sink == NULL)
+			return 1;
+		return stream_done(sink,ggen_stream_sparselu(size,sink));
+	}
+
 	g_p = ggen_generate_sparselu(size);
 	if(g_p == NULL)
 	{
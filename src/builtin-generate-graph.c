@@ -60,6 +60,8 @@
  */
 static int cmd_gnp(int argc, char** argv);
 static int cmd_gnm(int argc, char** argv);
+static int cmd_gnp_sweep(int argc, char** argv);
+static int cmd_gnm_sweep(int argc, char** argv);
 static int cmd_lbl(int argc, char** argv);
 static int cmd_fifo(int argc, char** argv);
 static int cmd_ro(int argc, char** argv);
@@ -69,6 +71,8 @@ const char* help_generate[] = {
 	"Methods:\n",
 	"gnp                      : the classical adjacency matrix method\n",
 	"gnm                      : selection of edges in the complete graph\n",
+	"gnp-sweep                : nested gnp graphs for a list of probabilities\n",
+	"gnm-sweep                : nested gnm graphs for a list of edge counts\n",
 	"lbl                      : the classical layer by layer method\n",
 	"ro                       : generation of a DAG by intersection of total orders\n",
 	"fifo                     : succeeding expension and contraction phases\n",
@@ -82,6 +86,10 @@ static const char* gnp_help[] = {
 	"Arguments:\n",
 	"     - number of vertices    : how many vertices in this graph\n",
 	"     - probability           : the probability for each edge of the complete graph to be present\n",
+	"Methods:\n",
+	"     - matrix (default)      : flip a coin for each cell of the adjacency matrix, O(n^2)\n",
+	"     - sparse                : jump from edge to edge using geometric skips, O(n+m)\n",
+	"Streaming (--stream) uses the sparse method, in constant memory.\n",
 	NULL
 };
 
@@ -91,6 +99,34 @@ static const char* gnm_help[] = {
 	"Arguments:\n",
 	"     - number of vertices    : how many vertices in this graph\n",
 	"     - number of edges       : how many edges to choose\n",
+	"Methods:\n",
+	"     - matrix (default)      : draw pairs of vertices until enough edges are found, O(n^2)\n",
+	"     - sparse                : sample edge indices without replacement, O(m)\n",
+	"Streaming (--stream) uses the sparse method.\n",
+	NULL
+};
+
+static const char* gnp_sweep_help[] = {
+	"\nErdos GNP sweep:\n",
+	"Generate in a single pass one GNP graph for each probability of a list.\n",
+	"The graphs are nested: the graph of a smaller probability is a subgraph of the others.\n",
+	"Each graph is written to its own file, the output option is ignored.\n",
+	"Arguments:\n",
+	"     - number of vertices    : how many vertices in each graph\n",
+	"     - probabilities         : comma separated list of probabilities\n",
+	"     - output template       : file name of each graph, %p is replaced by the probability\n",
+	NULL
+};
+
+static const char* gnm_sweep_help[] = {
+	"\nErdos GNM sweep:\n",
+	"Generate in a single pass one GNM graph for each number of edges of a list.\n",
+	"The graphs are nested: the graph with fewer edges is a subgraph of the others.\n",
+	"Each graph is written to its own file, the output option is ignored.\n",
+	"Arguments:\n",
+	"     - number of vertices    : how many vertices in each graph\n",
+	"     - numbers of edges      : comma separated list of edge counts\n",
+	"     - output template       : file name of each graph, %m is replaced by the number of edges\n",
 	NULL
 };
 
@@ -126,12 +162,57 @@ static const char* fifo_help[] = {
 struct second_lvl_cmd cmds_generate[] = {
 	{ "gnp", 2, gnp_help, cmd_gnp },
 	{ "gnm", 2, gnm_help, cmd_gnm },
+	{ "gnp-sweep", 3, gnp_sweep_help, cmd_gnp_sweep },
+	{ "gnm-sweep", 3, gnm_sweep_help, cmd_gnm_sweep },
 	{ "lbl", 3, lbl_help, cmd_lbl },
 	{ "ro", 2, ro_help, cmd_ro },
 	{ "fifo" , 3, fifo_help, cmd_fifo },
 	{ 0, 0, 0, 0},
 };
 
+/* the --stream option: edges are written to the output as soon as they are
+ * generated, instead of building the graph first. streaming is the method of
+ * the command able to do it, NULL if none.
+ */
+static int stream_check(const char *streaming)
+{
+	if(stream_format == NULL)
+		return 0;
+	if(streaming == NULL)
+	{
+		error("Streaming not available for this command\n");
+		return 1;
+	}
+	if(method != NULL && strcmp(method,streaming))
+	{
+		error("Streaming only available with the %s method\n",streaming);
+		return 1;
+	}
+	return 0;
+}
+
+static int cmd_stream(unsigned long n, double p, unsigned long m, int integer)
+{
+	int err = 0;
+	struct ggen_edge_sink *sink;
+
+	sink = stream_sink(stream_format,outfile);
+	if(sink == NULL)
+		return 1;
+
+	if(integer)
+		err = ggen_stream_erdos_gnm(rng,n,m,sink);
+	else
+		err = ggen_stream_erdos_gnp(rng,n,p,sink);
+	if(err)
+		error("ggen error: %s\n",ggen_error_strerror());
+
+	ggen_edge_sink_free(sink);
+	// the graph is already written
+	g_p = NULL;
+	return err;
+}
+
 static int cmd_gnp(int argc, char** argv)
 {
 	int err = 0;
@@ -144,7 +225,22 @@ static int cmd_gnp(int argc, char** argv)
 	err = s2d(argv[1],&prob);
 	if(err) goto ret;
 
-	g_p = ggen_generate_erdos_gnp(rng,number,prob);
+	err = stream_check("sparse");
+	if(err) goto ret;
+
+	if(stream_format != NULL)
+		return cmd_stream(number,prob,0,0);
+
+	if(method == NULL || !strcmp(method,"matrix"))
+		g_p = ggen_generate_erdos_gnp(rng,number,prob);
+	else if(!strcmp(method,"sparse"))
+		g_p = ggen_generate_erdos_gnp_sparse(rng,number,prob);
+	else
+	{
+		error("Unknown method %s\n",method);
+		err = 1;
+		goto ret;
+	}
 	if(g_p == NULL)
 	{
 		error("ggen error: %s\n",ggen_error_strerror());
@@ -165,7 +261,22 @@ static int cmd_gnm(int argc, char** argv)
 	err = s2ul(argv[1],&m);
 	if(err) goto ret;
 
-	g_p = ggen_generate_erdos_gnm(rng,n,m);
+	err = stream_check("sparse");
+	if(err) goto ret;
+
+	if(stream_format != NULL)
+		return cmd_stream(n,0.0,m,1);
+
+	if(method == NULL || !strcmp(method,"matrix"))
+		g_p = ggen_generate_erdos_gnm(rng,n,m);
+	else if(!strcmp(method,"sparse"))
+		g_p = ggen_generate_erdos_gnm_sparse(rng,n,m);
+	else
+	{
+		error("Unknown method %s\n",method);
+		err = 1;
+		goto ret;
+	}
 	if(g_p == NULL)
 	{
 		error("ggen error: %s\n",ggen_error_strerror());
@@ -175,12 +286,165 @@ ret:
 	return err;
 }
 
+/* split a comma separated list of numbers, tokens are kept to name the
+ * output files
+ */
+static int sweep_parse(char *list, int integer, igraph_vector_t *values, char ***tokens)
+{
+	int err = 0;
+	unsigned long i,count = 1,l;
+	double d;
+	char *c;
+
+	for(c = list; *c != '\0'; c++)
+		if(*c == ',')
+			count++;
+
+	*tokens = calloc(count,sizeof(char *));
+	if(*tokens == NULL)
+		return 1;
+
+	err = igraph_vector_init(values,count);
+	if(err)
+	{
+		free(*tokens);
+		return 1;
+	}
+
+	for(i = 0, c = strtok(list,","); c != NULL; i++, c = strtok(NULL,","))
+	{
+		(*tokens)[i] = c;
+		if(integer)
+		{
+			err = s2ul(c,&l);
+			d = l;
+		}
+		else
+			err = s2d(c,&d);
+		if(err) break;
+		VECTOR(*values)[i] = d;
+	}
+	// empty items
+	if(i != count)
+		err = 1;
+
+	if(err)
+	{
+		error("Invalid list of values\n");
+		igraph_vector_destroy(values);
+		free(*tokens);
+	}
+	return err;
+}
+
+/* write each graph of the sweep to the template, with key replaced by the
+ * token of its value
+ */
+static int sweep_write(igraph_vector_ptr_t *graphs, char **tokens, const char *template, const char *key)
+{
+	int err = 0;
+	unsigned long i;
+	char *fname;
+	FILE *f;
+
+	if(strstr(template,key) == NULL)
+	{
+		error("Output template must contain %s\n",key);
+		return 1;
+	}
+
+	for(i = 0; i < igraph_vector_ptr_size(graphs) && !err; i++)
+	{
+		fname = template_fill(template,key,tokens[i]);
+		if(fname == NULL)
+			return 1;
+
+		info("Writing graph to %s\n",fname);
+		f = fopen(fname,"w");
+		if(f == NULL)
+		{
+			error("Failed to open file %s for output\n",fname);
+			err = 1;
+		}
+		else
+		{
+			err = ggen_write_graph(VECTOR(*graphs)[i],f);
+			fclose(f);
+			if(err)
+				error("Writing graph failed\n");
+		}
+		free(fname);
+	}
+	return err;
+}
+
+static int cmd_sweep(int argc, char** argv, int integer)
+{
+	int err = 0;
+	unsigned long n;
+	igraph_vector_t values;
+	igraph_vector_ptr_t *graphs;
+	char **tokens;
+
+	err = stream_check(NULL);
+	if(err) goto ret;
+
+	if(batch)
+	{
+		error("Batch mode not available for sweeps\n");
+		err = 1;
+		goto ret;
+	}
+
+	err = s2ul(argv[0],&n);
+	if(err) goto ret;
+
+	err = sweep_parse(argv[1],integer,&values,&tokens);
+	if(err) goto ret;
+
+	if(integer)
+		graphs = ggen_generate_erdos_gnm_sweep(rng,n,&values);
+	else
+		graphs = ggen_generate_erdos_gnp_sweep(rng,n,&values);
+	if(graphs == NULL)
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		err = 1;
+		goto free_values;
+	}
+
+	err = sweep_write(graphs,tokens,argv[2],integer ? "%m" : "%p");
+
+	igraph_vector_ptr_destroy_all(graphs);
+	free(graphs);
+free_values:
+	igraph_vector_destroy(&values);
+	free(tokens);
+ret:
+	// graphs are already written
+	g_p = NULL;
+	return err;
+}
+
+static int cmd_gnp_sweep(int argc, char** argv)
+{
+	return cmd_sweep(argc,argv,0);
+}
+
+static int cmd_gnm_sweep(int argc, char** argv)
+{
+	return cmd_sweep(argc,argv,1);
+}
+
 static int cmd_lbl(int argc, char** argv)
 {
 	int err = 0;
 	unsigned long n,l;
 	double p;
 
+	err = stream_check(NULL);
+	if(err) goto ret;
+
 	err = s2ul(argv[0],&n);
 	if(err) goto ret;
 
@@ -205,6 +469,9 @@ static int cmd_ro(int argc, char** argv)
 	int err = 0;
 	unsigned long n,o;
 
+	err = stream_check(NULL);
+	if(err) goto ret;
+
 	err = s2ul(argv[0],&n);
 	if(err) goto ret;
 
@@ -226,6 +493,9 @@ static int cmd_fifo(int argc, char** argv)
 	int err = 0;
 	unsigned long n,i,o;
 
+	err = stream_check(NULL);
+	if(err) goto ret;
+
 	err = s2ul(argv[0],&n);
 	if(err) goto ret;
 
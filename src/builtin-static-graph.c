@@ -99,6 +99,26 @@ static const char* strassen_help[] = {
 	NULL
 };
 
+/* --dry-run: print the size of the graph instead of generating it. The
+ * memory is the one of the igraph structure (4 vectors of edges, 2 of
+ * vertices) plus the edge list it is created from, attributes excluded.
+ */
+static int dry_run_print(int status, unsigned long vertices, unsigned long edges)
+{
+	double mem;
+	if(status)
+	{
+		error("ggen error: %s\n",ggen_error_strerror());
+		return 1;
+	}
+	mem = sizeof(igraph_real_t) * (6.0*edges + 2.0*vertices + 2.0);
+	fprintf(outfile,"vertices: %lu\nedges: %lu\nmemory: %.0f bytes\n",
+			vertices,edges,mem);
+	// nothing to print
+	g_p = NULL;
+	return 0;
+}
+
 struct second_lvl_cmd cmds_static[] = {
 	{ "fibonacci", 2, fibonacci_help, cmd_fibonacci },
 	{ "forkjoin" , 2, forkjoin_help , cmd_forkjoin  },
@@ -109,7 +129,7 @@ struct second_lvl_cmd cmds_static[] = {
 static int cmd_fibonacci(int argc, char** argv)
 {
 	int err = 0;
-	unsigned long n,cutoff;
+	unsigned long n,cutoff,v,e;
 
 	err = s2ul(argv[0],&n);
 	if(err) goto ret;
@@ -117,6 +137,12 @@ static int cmd_fibonacci(int argc, char** argv)
 	err = s2ul(argv[1],&cutoff);
 	if(err) goto ret;
 
+	if(dry_run)
+	{
+		err = ggen_count_fibonacci(n,cutoff,&v,&e);
+		return dry_run_print(err,v,e);
+	}
+
 	g_p = ggen_generate_fibonacci(n, cutoff);
 	if(g_p == NULL)
 	{
@@ -130,7 +156,7 @@ ret:
 static int cmd_forkjoin(int argc, char** argv)
 {
 	int err = 0;
-	unsigned long phases,diameter;
+	unsigned long phases,diameter,v,e;
 
 	err = s2ul(argv[0],&phases);
 	if(err) goto ret;
@@ -138,6 +164,12 @@ static int cmd_forkjoin(int argc, char** argv)
 	err = s2ul(argv[1],&diameter);
 	if(err) goto ret;
 
+	if(dry_run)
+	{
+		err = ggen_count_forkjoin(phases,diameter,&v,&e);
+		return dry_run_print(err,v,e);
+	}
+
 	g_p = ggen_generate_forkjoin(phases, diameter);
 	if(g_p == NULL)
 	{
@@ -151,7 +183,7 @@ ret:
 static int cmd_strassen(int argc, char** argv)
 {
 	int err = 0;
-	unsigned long size, depth, cutoff;
+	unsigned long size, depth, cutoff, v, e;
 
 	err = s2ul(argv[0],&size);
 	if(err) goto ret;
@@ -162,6 +194,12 @@ static int cmd_strassen(int argc, char** argv)
 	err = s2ul(argv[2],&cutoff);
 	if(err) goto ret;
 
+	if(dry_run)
+	{
+		err = ggen_count_strassen(size,depth,cutoff,&v,&e);
+		return dry_run_print(err,v,e);
+	}
+
 	g_p = ggen_generate_strassen(size, depth, cutoff);
 	if(g_p == NULL)
 	{
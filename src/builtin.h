@@ -54,6 +54,15 @@ extern gsl_rng *rng;
 extern FILE *infile;
 extern FILE *outfile;
 extern char *name;
+extern char *method;
+extern char *stream_format;
+extern unsigned long batch;
+extern int dry_run;
+extern char *vertex_weight;
+extern char *edge_weight;
+extern int annotate;
+extern char *metrics;
+extern char *summary_format;
 
 #define EDGE_PROPERTY 0
 #define VERTEX_PROPERTY 1
@@ -76,6 +85,14 @@ struct second_lvl_cmd {
 #define NEED_RNG	8	// a rng must be initialized
 #define NEED_TYPE	16	// a type must be set
 #define NEED_NAME	32	// a name must be set
+#define NEED_METHOD	64	// an alternative method can be selected
+#define NEED_THREADS	128	// the command can use several threads
+#define NEED_STREAM	256	// the graph can be streamed to the output
+#define NEED_BATCH	512	// several graphs can be generated at once
+#define NEED_DRY_RUN	1024	// the size of the graph can be computed alone
+#define NEED_COSTS	2048	// the tasks of the graph can be given costs
+#define NEED_WEIGHTS	4096	// the analysis can use weights, annotate the graph
+#define NEED_METRICS	8192	// the metrics and format of a summary can be selected
 
 struct first_lvl_cmd {
 	const char *name;
@@ -94,6 +111,7 @@ extern const char *help_generate[];
 extern const char *help_static[];
 extern const char *help_dataflow[];
 extern const char *help_analyse[];
+extern const char *help_analyse_family[];
 extern const char *help_transform[];
 extern const char *help_add_prop[];
 extern const char *help_analyse_prop[];
@@ -102,6 +120,7 @@ extern struct second_lvl_cmd cmds_generate[];
 extern struct second_lvl_cmd cmds_static[];
 extern struct second_lvl_cmd cmds_dataflow[];
 extern struct second_lvl_cmd cmds_analyse[];
+extern struct second_lvl_cmd cmds_analyse_family[];
 extern struct second_lvl_cmd cmds_transform[];
 extern struct second_lvl_cmd cmds_add_prop[];
 extern struct second_lvl_cmd cmds_analyse_prop[];
@@ -0,0 +1,198 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+/* Compressed sparse row snapshots of graphs, for the analyses: walking the
+ * neighbours of a vertex is a scan of a contiguous array, without the
+ * allocation of a vertex selector and iterator per vertex.
+ */
+
+#include <stdlib.h>
+#include "csr.h"
+#include "error.h"
+
+/* scatter the edges of the lists of (offsets,nbrs,eids) into the buckets of
+ * their neighbour, the vertex owning each list becoming the neighbour in the
+ * bucket. Buckets are filled in the order of the lists: this is one pass of a
+ * radix sort.
+ */
+static void csr_scatter(int32_t vcount, const int64_t *offsets,
+			const int32_t *nbrs, const int32_t *eids,
+			const int64_t *boffsets, int32_t *bnbrs,
+			int32_t *beids, int64_t *cursor)
+{
+	int32_t v;
+	int64_t i,pos;
+
+	for(v = 0; v < vcount; v++)
+		cursor[v] = boffsets[v];
+	for(v = 0; v < vcount; v++)
+		for(i = offsets[v]; i < offsets[v+1]; i++)
+		{
+			pos = cursor[nbrs[i]]++;
+			bnbrs[pos] = v;
+			beids[pos] = eids[i];
+		}
+}
+
+int csr_init(csr_t *c, const igraph_t *g)
+{
+	igraph_vector_t edges;
+	int64_t *cursor;
+	int64_t e,pos;
+	int32_t v,from;
+
+	ggen_error_start_stack();
+	if(c == NULL || g == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	c->vcount = igraph_vcount(g);
+	c->ecount = igraph_ecount(g);
+	c->out_offsets = calloc(c->vcount+1,sizeof(int64_t));
+	GGEN_CHECK_ALLOC(c->out_offsets);
+	GGEN_FINALLY3(free,c->out_offsets,1);
+	c->in_offsets = calloc(c->vcount+1,sizeof(int64_t));
+	GGEN_CHECK_ALLOC(c->in_offsets);
+	GGEN_FINALLY3(free,c->in_offsets,1);
+	/* never ask malloc for 0 bytes, NULL would look like a failure */
+	c->out_targets = malloc((c->ecount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(c->out_targets);
+	GGEN_FINALLY3(free,c->out_targets,1);
+	c->out_eids = malloc((c->ecount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(c->out_eids);
+	GGEN_FINALLY3(free,c->out_eids,1);
+	c->in_sources = malloc((c->ecount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(c->in_sources);
+	GGEN_FINALLY3(free,c->in_sources,1);
+	c->in_eids = malloc((c->ecount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(c->in_eids);
+	GGEN_FINALLY3(free,c->in_eids,1);
+
+	cursor = malloc((c->vcount+1)*sizeof(int64_t));
+	GGEN_CHECK_ALLOC(cursor);
+	GGEN_FINALLY(free,cursor);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_IGRAPH(igraph_get_edgelist(g,&edges,0));
+
+	/* degrees, then offsets */
+	for(e = 0; e < c->ecount; e++)
+	{
+		c->out_offsets[(int32_t)VECTOR(edges)[2*e]+1]++;
+		c->in_offsets[(int32_t)VECTOR(edges)[2*e+1]+1]++;
+	}
+	for(v = 0; v < c->vcount; v++)
+	{
+		c->out_offsets[v+1] += c->out_offsets[v];
+		c->in_offsets[v+1] += c->in_offsets[v];
+	}
+
+	/* edges by source, in id order. The in lists are scattered from
+	 * them, so sorted by source, and the final out lists from the in
+	 * lists, so sorted by target. Ties are kept in id order all along.
+	 */
+	for(v = 0; v < c->vcount; v++)
+		cursor[v] = c->out_offsets[v];
+	for(e = 0; e < c->ecount; e++)
+	{
+		from = VECTOR(edges)[2*e];
+		pos = cursor[from]++;
+		c->out_targets[pos] = VECTOR(edges)[2*e+1];
+		c->out_eids[pos] = e;
+	}
+	csr_scatter(c->vcount,c->out_offsets,c->out_targets,c->out_eids,
+		    c->in_offsets,c->in_sources,c->in_eids,cursor);
+	csr_scatter(c->vcount,c->in_offsets,c->in_sources,c->in_eids,
+		    c->out_offsets,c->out_targets,c->out_eids,cursor);
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+void csr_free(csr_t *c)
+{
+	free(c->out_offsets);
+	free(c->out_targets);
+	free(c->out_eids);
+	free(c->in_offsets);
+	free(c->in_sources);
+	free(c->in_eids);
+}
+
+int csr_topological_order(const csr_t *c, int32_t *order)
+{
+	int64_t *deg,j;
+	int32_t v,head,tail;
+
+	ggen_error_start_stack();
+	if(c == NULL || order == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	deg = malloc((c->vcount+1)*sizeof(int64_t));
+	GGEN_CHECK_ALLOC(deg);
+	GGEN_FINALLY(free,deg);
+
+	/* Kahn's algorithm, using order as the queue */
+	for(v = 0, tail = 0; v < c->vcount; v++)
+	{
+		deg[v] = CSR_IN_DEGREE(c,v);
+		if(deg[v] == 0)
+			order[tail++] = v;
+	}
+	for(head = 0; head < tail; head++)
+	{
+		v = order[head];
+		for(j = c->out_offsets[v]; j < c->out_offsets[v+1]; j++)
+			if(--deg[c->out_targets[j]] == 0)
+				order[tail++] = c->out_targets[j];
+	}
+	if(tail != c->vcount)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
@@ -0,0 +1,85 @@
+/* Copyright Swann Perarnau 2013
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+
+#ifndef CSR_H
+#define CSR_H 1
+
+#include <stdint.h>
+#include "ggen.h"
+
+/* An immutable snapshot of the adjacency of a graph, in compressed sparse row
+ * form: the out-neighbours of v are out_targets[out_offsets[v]] to
+ * out_targets[out_offsets[v+1]-1], sorted by id, and out_eids gives the id of
+ * the corresponding edges in the graph. The in-neighbours are stored the same
+ * way. Neighbours are in the order igraph lists them, so analyses give the same
+ * results with or without the snapshot.
+ *
+ * Vertex and edge ids fit in 32 bits (they are igraph_integer_t), offsets are
+ * 64 bits.
+ */
+typedef struct {
+	int32_t vcount;
+	int64_t ecount;
+	int64_t *out_offsets;
+	int32_t *out_targets;
+	int32_t *out_eids;
+	int64_t *in_offsets;
+	int32_t *in_sources;
+	int32_t *in_eids;
+} csr_t;
+
+/* build the snapshot of g, in O(V+E) */
+int csr_init(csr_t *c, const igraph_t *g);
+
+void csr_free(csr_t *c);
+
+/* store a topological order of the snapshot in order, an array of vcount
+ * vertices, in O(V+E). Fails with GGEN_EINVAL if the graph has a cycle.
+ */
+int csr_topological_order(const csr_t *c, int32_t *order);
+
+#define CSR_OUT_DEGREE(c,v) ((c)->out_offsets[(v)+1] - (c)->out_offsets[v])
+#define CSR_IN_DEGREE(c,v) ((c)->in_offsets[(v)+1] - (c)->in_offsets[v])
+
+#endif
@@ -0,0 +1,386 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+/* Dataflow tracer: derives the dependencies between tasks from the regions
+ * they access. A region holds the last task that wrote into it and the list
+ * of tasks that read it since. Reader lists are chained through two vectors,
+ * cells of a list are recycled once the region is written again, so the
+ * memory used by the tracer itself only depends on the number of regions and
+ * of pending readers.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include "dataflow-trace.h"
+#include "error.h"
+
+static const char *coords_names[DATAFLOW_MAX_DIMS] = { "x", "y", "z" };
+
+int dataflow_trace_init(struct dataflow_trace *t,
+			const struct dataflow_kernel *kernels, int nkernels,
+			int hazards)
+{
+	int i;
+	ggen_error_start_stack();
+	t->kernels = kernels;
+	t->nkernels = nkernels;
+	t->hazards = hazards;
+	t->dims = 0;
+	t->ndata = 0;
+	t->regions = 0;
+	t->lastwrite = NULL;
+	t->readers = NULL;
+	t->rfree = -1;
+	t->ntasks = 0;
+	t->sink = NULL;
+	t->sink_err = 0;
+	t->err = IGRAPH_SUCCESS;
+
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&t->rtask,0));
+	GGEN_FINALLY3(igraph_vector_long_destroy,&t->rtask,1);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&t->rnext,0));
+	GGEN_FINALLY3(igraph_vector_long_destroy,&t->rnext,1);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&t->kernel,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&t->kernel,1);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&t->edges,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&t->edges,1);
+	for(i = 0; i < DATAFLOW_MAX_DIMS; i++)
+	{
+		GGEN_CHECK_IGRAPH(igraph_vector_init(&t->coords[i],0));
+		GGEN_FINALLY3(igraph_vector_destroy,&t->coords[i],1);
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+void dataflow_trace_destroy(struct dataflow_trace *t)
+{
+	int i;
+	for(i = 0; i < DATAFLOW_MAX_DIMS; i++)
+		igraph_vector_destroy(&t->coords[i]);
+	igraph_vector_destroy(&t->edges);
+	igraph_vector_destroy(&t->kernel);
+	igraph_vector_long_destroy(&t->rnext);
+	igraph_vector_long_destroy(&t->rtask);
+	free(t->readers);
+	free(t->lastwrite);
+}
+
+void dataflow_trace_stream(struct dataflow_trace *t, struct ggen_edge_sink *s)
+{
+	t->sink = s;
+}
+
+int dataflow_trace_data(struct dataflow_trace *t, int dims,
+			const unsigned long *shape)
+{
+	struct dataflow_data *d;
+	unsigned long size = 1;
+	int i;
+
+	ggen_error_start_stack();
+	if(dims < 1 || dims > DATAFLOW_MAX_DIMS || shape == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	if(t->ndata == DATAFLOW_MAX_DATA || t->lastwrite != NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	for(i = 0; i < dims; i++)
+	{
+		if(shape[i] != 0 && size > (unsigned long)LONG_MAX/shape[i])
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		size *= shape[i];
+	}
+	if(size > (unsigned long)LONG_MAX - t->regions)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	d = &t->data[t->ndata++];
+	d->dims = dims;
+	for(i = 0; i < dims; i++)
+		d->shape[i] = shape[i];
+	d->base = t->regions;
+	t->regions += size;
+	if(dims > t->dims)
+		t->dims = dims;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* allocates the region tables, once all data are declared */
+static int trace_regions(struct dataflow_trace *t)
+{
+	unsigned long i, n = t->regions ? t->regions : 1;
+	t->lastwrite = malloc(n * sizeof(long));
+	t->readers = malloc(n * sizeof(long));
+	if(t->lastwrite == NULL || t->readers == NULL)
+		return IGRAPH_ENOMEM;
+	for(i = 0; i < t->regions; i++)
+	{
+		t->lastwrite[i] = -1;
+		t->readers[i] = -1;
+	}
+	return IGRAPH_SUCCESS;
+}
+
+static inline int region_index(const struct dataflow_data *d,
+			       const unsigned long *c, unsigned long *r)
+{
+	unsigned long idx = 0;
+	int i;
+	for(i = 0; i < d->dims; i++)
+	{
+		if(c[i] >= d->shape[i])
+			return IGRAPH_EINVAL;
+		idx = idx * d->shape[i] + c[i];
+	}
+	*r = d->base + idx;
+	return IGRAPH_SUCCESS;
+}
+
+/* adds the edge from -> to, unless it is a self-loop or an edge already
+ * created for this task (all the edges from first on).
+ */
+static inline void trace_edge(struct dataflow_trace *t, long from,
+			      unsigned long to, long first,
+			      const unsigned long *c, int dims)
+{
+	long e, ecount = igraph_vector_size(&t->edges)/2;
+	int i;
+
+	if(from == -1 || (unsigned long)from == to || t->err)
+		return;
+	for(e = first; e < ecount; e++)
+		if(VECTOR(t->edges)[2*e] == from)
+			return;
+
+	t->err = igraph_vector_push_back(&t->edges, from);
+	if(!t->err)
+		t->err = igraph_vector_push_back(&t->edges, to);
+	for(i = 0; i < t->dims && !t->err; i++)
+		t->err = igraph_vector_push_back(&t->coords[i],
+						  i < dims ? c[i] : 0);
+}
+
+static inline void trace_read(struct dataflow_trace *t, unsigned long r,
+			      unsigned long task)
+{
+	long cell, head = t->readers[r];
+
+	if(head != -1 && (unsigned long)VECTOR(t->rtask)[head] == task)
+		return;
+	if(t->rfree != -1)
+	{
+		cell = t->rfree;
+		t->rfree = VECTOR(t->rnext)[cell];
+		VECTOR(t->rtask)[cell] = task;
+		VECTOR(t->rnext)[cell] = head;
+	}
+	else
+	{
+		cell = igraph_vector_long_size(&t->rtask);
+		t->err = igraph_vector_long_push_back(&t->rtask, task);
+		if(!t->err)
+			t->err = igraph_vector_long_push_back(&t->rnext, head);
+		if(t->err)
+			return;
+	}
+	t->readers[r] = cell;
+}
+
+static inline void trace_write(struct dataflow_trace *t, unsigned long r,
+			       unsigned long task)
+{
+	long cell = t->readers[r];
+
+	/* give the whole reader list back */
+	if(cell != -1)
+	{
+		while(VECTOR(t->rnext)[cell] != -1)
+			cell = VECTOR(t->rnext)[cell];
+		VECTOR(t->rnext)[cell] = t->rfree;
+		t->rfree = t->readers[r];
+		t->readers[r] = -1;
+	}
+	t->lastwrite[r] = task;
+}
+
+/* gives a task and its edges to the sink, they are forgotten afterwards */
+static void trace_emit(struct dataflow_trace *t, unsigned long task,
+		       const char *kernel)
+{
+	struct ggen_edge_sink *s = t->sink;
+	unsigned long c[DATAFLOW_MAX_DIMS], from;
+	long e, ecount = igraph_vector_size(&t->edges)/2;
+	int i, err = GGEN_SUCCESS;
+
+	if(s->task != NULL)
+		err = s->task(s->data, task, kernel);
+	else if(s->vertex != NULL)
+		err = s->vertex(s->data, task);
+	for(e = 0; e < ecount && !err; e++)
+	{
+		from = VECTOR(t->edges)[2*e];
+		for(i = 0; i < t->dims; i++)
+			c[i] = VECTOR(t->coords[i])[e];
+		if(s->dependency != NULL)
+			err = s->dependency(s->data, from, task, t->dims, c);
+		else
+			err = s->edge(s->data, from, task);
+	}
+	if(err)
+	{
+		/* like the other streaming generators, a sink failing without
+		 * setting an error is a generic failure */
+		if(ggen_errno.ggen_error == GGEN_SUCCESS)
+			ggen_errno.ggen_error = GGEN_FAILURE;
+		t->sink_err = 1;
+		t->err = IGRAPH_FAILURE;
+	}
+	igraph_vector_clear(&t->edges);
+	for(i = 0; i < t->dims; i++)
+		igraph_vector_clear(&t->coords[i]);
+}
+
+unsigned long dataflow_trace_task(struct dataflow_trace *t, int kernel,
+				  const unsigned long *coords)
+{
+	const struct dataflow_kernel *k;
+	const struct dataflow_data *d;
+	const unsigned long *c;
+	unsigned long r[DATAFLOW_MAX_ARGS];
+	unsigned long task = t->ntasks;
+	long i, first = igraph_vector_size(&t->edges)/2;
+	int a, mode;
+
+	if(t->err)
+		return task;
+	if(kernel < 0 || kernel >= t->nkernels)
+	{
+		t->err = IGRAPH_EINVAL;
+		return task;
+	}
+	if(t->lastwrite == NULL && (t->err = trace_regions(t)))
+		return task;
+	if(t->sink == NULL &&
+	   (t->err = igraph_vector_push_back(&t->kernel, kernel)))
+		return task;
+	t->ntasks++;
+
+	k = &t->kernels[kernel];
+	/* dependencies of all the arguments first, so that a task never depends
+	 * on itself.
+	 */
+	c = coords;
+	for(a = 0; a < k->nargs; a++)
+	{
+		d = &t->data[k->args[a].data];
+		mode = k->args[a].mode;
+		if((t->err = region_index(d, c, &r[a])))
+			return task;
+		if((mode & DATAFLOW_IN) && (t->hazards & DATAFLOW_RAW))
+			trace_edge(t, t->lastwrite[r[a]], task, first, c, d->dims);
+		if((mode & DATAFLOW_OUT) && (t->hazards & DATAFLOW_WAR))
+			for(i = t->readers[r[a]]; i != -1; i = VECTOR(t->rnext)[i])
+				trace_edge(t, VECTOR(t->rtask)[i], task, first,
+					   c, d->dims);
+		if((mode & DATAFLOW_OUT) && (t->hazards & DATAFLOW_WAW))
+			trace_edge(t, t->lastwrite[r[a]], task, first, c, d->dims);
+		c += d->dims;
+	}
+	for(a = 0; a < k->nargs && !t->err; a++)
+	{
+		mode = k->args[a].mode;
+		if(mode & DATAFLOW_OUT)
+			trace_write(t, r[a], task);
+		else if(t->hazards & DATAFLOW_WAR)
+			trace_read(t, r[a], task);
+	}
+	if(t->sink != NULL && !t->err)
+		trace_emit(t, task, k->name);
+	return task;
+}
+
+int dataflow_trace_check(struct dataflow_trace *t)
+{
+	ggen_error_start_stack();
+	/* the sink already reported its error */
+	GGEN_CHECK_INTERNAL_ERRNO(t->sink_err ? GGEN_FAILURE : GGEN_SUCCESS);
+	GGEN_CHECK_IGRAPH(t->err);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int dataflow_trace_graph(struct dataflow_trace *t, igraph_t *g)
+{
+	igraph_strvector_t names;
+	int i;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_check(t));
+
+	/* the dictionary has all the kernels of the table */
+	GGEN_CHECK_IGRAPH(igraph_strvector_init(&names, t->nkernels));
+	GGEN_FINALLY(igraph_strvector_destroy, &names);
+	for(i = 0; i < t->nkernels; i++)
+		GGEN_CHECK_IGRAPH(igraph_strvector_set(&names, i,
+						       t->kernels[i].name));
+
+	GGEN_CHECK_IGRAPH(igraph_create(g, &t->edges, t->ntasks, 1));
+	GGEN_FINALLY3(igraph_destroy, g, 1);
+	if(t->ntasks > 0)
+		GGEN_CHECK_INTERNAL_ERRNO(ggen_set_kernels(g, &names,
+							   &t->kernel));
+	if(igraph_vector_size(&t->edges) > 0)
+		for(i = 0; i < t->dims; i++)
+			GGEN_CHECK_IGRAPH(SETEANV(g, coords_names[i],
+						  &t->coords[i]));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
@@ -0,0 +1,166 @@
+/* Copyright Swann Perarnau 2013
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+
+#ifndef DATAFLOW_TRACE_H
+#define DATAFLOW_TRACE_H 1
+
+#include "ggen.h"
+
+/* A tracer for dataflow algorithms: the algorithm runs through its motions,
+ * declaring each task along with the regions (blocks) of data it accesses,
+ * and the tracer derives the dependencies between tasks.
+ *
+ * Data are declared first, as arrays of blocks of up to DATAFLOW_MAX_DIMS
+ * dimensions. Kernels are described by a table giving, for each kernel, its
+ * name and the data and access mode of each of its arguments. A task is then
+ * a kernel id and the coordinates of each argument.
+ *
+ * For each region, the tracer keeps the last task that wrote into it and the
+ * tasks that read it since, in flat arrays: dependencies of a new task are
+ * found in constant time per access.
+ */
+
+#define DATAFLOW_MAX_DIMS 3
+#define DATAFLOW_MAX_DATA 8
+#define DATAFLOW_MAX_ARGS 8
+
+/* access modes */
+#define DATAFLOW_IN 1
+#define DATAFLOW_OUT 2
+#define DATAFLOW_INOUT (DATAFLOW_IN|DATAFLOW_OUT)
+
+/* dependencies to track: read after write, write after read, write after
+ * write.
+ */
+#define DATAFLOW_RAW 1
+#define DATAFLOW_WAR 2
+#define DATAFLOW_WAW 4
+#define DATAFLOW_ALL (DATAFLOW_RAW|DATAFLOW_WAR|DATAFLOW_WAW)
+
+struct dataflow_kernel {
+	const char *name;
+	int nargs;
+	struct {
+		int data;
+		int mode;
+	} args[DATAFLOW_MAX_ARGS];
+};
+
+#define DATAFLOW_NKERNELS(table) ((int)(sizeof(table)/sizeof((table)[0])))
+
+struct dataflow_data {
+	int dims;
+	unsigned long shape[DATAFLOW_MAX_DIMS];
+	unsigned long base;
+};
+
+struct dataflow_trace {
+	const struct dataflow_kernel *kernels;
+	int nkernels;
+	int hazards;
+	int dims;
+	int ndata;
+	struct dataflow_data data[DATAFLOW_MAX_DATA];
+	unsigned long regions;
+	/* per region: last writer and first reader since, -1 if none */
+	long *lastwrite;
+	long *readers;
+	/* linked lists of readers, unused cells are chained from rfree */
+	igraph_vector_long_t rtask;
+	igraph_vector_long_t rnext;
+	long rfree;
+	/* the graph: kernel of each task, edges and the coordinates of the
+	 * region behind each edge. When streaming, only the edges of the
+	 * current task are kept.
+	 */
+	unsigned long ntasks;
+	struct ggen_edge_sink *sink;
+	int sink_err;
+	igraph_vector_t kernel;
+	igraph_vector_t edges;
+	igraph_vector_t coords[DATAFLOW_MAX_DIMS];
+	/* first igraph error, once set the tracer does nothing */
+	int err;
+};
+
+/* kernels is a table of nkernels entries, hazards a mask of the dependencies
+ * to track.
+ */
+int dataflow_trace_init(struct dataflow_trace *t,
+			const struct dataflow_kernel *kernels, int nkernels,
+			int hazards);
+
+void dataflow_trace_destroy(struct dataflow_trace *t);
+
+/* streams the trace to s instead of recording it: each task is given to the
+ * sink as soon as it is traced, followed by its edges. Must be called before
+ * the first task. Begin and end hooks are left to the caller.
+ */
+void dataflow_trace_stream(struct dataflow_trace *t, struct ggen_edge_sink *s);
+
+/* declares an array of blocks, the i-th declared data has id i. All data must
+ * be declared before the first task.
+ */
+int dataflow_trace_data(struct dataflow_trace *t, int dims,
+			const unsigned long *shape);
+
+/* adds a task running kernel, coords gives the coordinates of each argument
+ * in turn. Returns the id of the task, tasks are numbered from 0 in creation
+ * order. Edges of a task are created in the order of its arguments, without
+ * duplicates.
+ */
+unsigned long dataflow_trace_task(struct dataflow_trace *t, int kernel,
+				  const unsigned long *coords);
+
+/* reports the first error met while tracing */
+int dataflow_trace_check(struct dataflow_trace *t);
+
+/* creates the graph traced so far: kernel types on vertices (see
+ * ggen_set_kernels, the dictionary is the kernel table) and, if
+ * the graph has edges, "x" ("y" and "z" depending on the data dimensions)
+ * attributes on edges.
+ */
+int dataflow_trace_graph(struct dataflow_trace *t, igraph_t *g);
+
+#endif /* DATAFLOW_TRACE_H */
@@ -0,0 +1,318 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+/* Edge sinks: generators able to stream their output give each vertex and
+ * edge to a set of callbacks instead of building an igraph. The sinks below
+ * write the graph as it comes, or build the igraph only once at the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ggen.h"
+#include "error.h"
+
+void ggen_edge_sink_free(struct ggen_edge_sink *s)
+{
+	if(s == NULL)
+		return;
+	if(s->free != NULL)
+		s->free(s->data);
+	free(s);
+}
+
+static struct ggen_edge_sink *edge_sink_new(void *data)
+{
+	struct ggen_edge_sink *s;
+	s = calloc(1,sizeof(struct ggen_edge_sink));
+	if(s != NULL)
+		s->data = data;
+	return s;
+}
+
+/* DOT sink: vertices are written first, so that a DOT reader gives them back
+ * their ids, then one line per edge. Task graphs interleave vertices and
+ * edges, each task coming before the edges reaching it.
+ */
+struct dot_sink {
+	FILE *out;
+	char *name;
+};
+
+/* turns the result of a stdio call into a ggen status */
+static int io_check(FILE *out, int ret)
+{
+	ggen_error_start_stack();
+	if(ret < 0 || ferror(out))
+		GGEN_SET_ERRNO(GGEN_EIO);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+static int dot_begin(void *data, unsigned long n, unsigned long m)
+{
+	struct dot_sink *d = data;
+	return io_check(d->out,fprintf(d->out,"digraph \"%s\" {\n",d->name));
+}
+
+static int dot_vertex(void *data, unsigned long v)
+{
+	struct dot_sink *d = data;
+	return io_check(d->out,fprintf(d->out,"\t%lu;\n",v));
+}
+
+static int dot_edge(void *data, unsigned long from, unsigned long to)
+{
+	struct dot_sink *d = data;
+	return io_check(d->out,fprintf(d->out,"\t%lu -> %lu;\n",from,to));
+}
+
+static int dot_task(void *data, unsigned long v, const char *kernel)
+{
+	struct dot_sink *d = data;
+	return io_check(d->out,fprintf(d->out,"\t%lu [kernel=\"%s\"];\n",v,
+				       kernel));
+}
+
+static int dot_dependency(void *data, unsigned long from, unsigned long to,
+			  int dims, const unsigned long *coords)
+{
+	static const char *names[] = { "x", "y", "z" };
+	struct dot_sink *d = data;
+	int i;
+
+	if(io_check(d->out,fprintf(d->out,"\t%lu -> %lu",from,to)))
+		return GGEN_FAILURE;
+	for(i = 0; i < dims && i < 3; i++)
+		if(io_check(d->out,fprintf(d->out,"%s%s=%lu",i ? ", " : " [",
+					   names[i],coords[i])))
+			return GGEN_FAILURE;
+	return io_check(d->out,fprintf(d->out,"%s;\n",dims > 0 ? "]" : ""));
+}
+
+static int dot_end(void *data)
+{
+	struct dot_sink *d = data;
+	if(io_check(d->out,fprintf(d->out,"}\n")))
+		return GGEN_FAILURE;
+	return io_check(d->out,fflush(d->out));
+}
+
+static void dot_free(struct dot_sink *d)
+{
+	free(d->name);
+	free(d);
+}
+
+struct ggen_edge_sink *ggen_edge_sink_dot(FILE *output, const char *name)
+{
+	struct ggen_edge_sink *s = NULL;
+	struct dot_sink *d;
+
+	ggen_error_start_stack();
+	if(output == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	d = calloc(1,sizeof(struct dot_sink));
+	GGEN_CHECK_ALLOC(d);
+	GGEN_FINALLY3(dot_free,d,1);
+
+	d->out = output;
+	d->name = strdup(name != NULL ? name : GGEN_DEFAULT_GRAPH_NAME);
+	GGEN_CHECK_ALLOC(d->name);
+
+	s = edge_sink_new(d);
+	GGEN_CHECK_ALLOC(s);
+	s->begin = dot_begin;
+	s->vertex = dot_vertex;
+	s->edge = dot_edge;
+	s->end = dot_end;
+	s->task = dot_task;
+	s->dependency = dot_dependency;
+	s->free = (void (*)(void *))dot_free;
+
+	ggen_error_clean(1);
+	return s;
+ggen_error_label:
+	return NULL;
+}
+
+/* edge list sink: one "from to" line per edge, as igraph reads them.
+ * Vertices without edges are lost.
+ */
+static int edgelist_edge(void *data, unsigned long from, unsigned long to)
+{
+	FILE *out = data;
+	return io_check(out,fprintf(out,"%lu %lu\n",from,to));
+}
+
+static int edgelist_end(void *data)
+{
+	FILE *out = data;
+	return io_check(out,fflush(out));
+}
+
+struct ggen_edge_sink *ggen_edge_sink_edgelist(FILE *output)
+{
+	struct ggen_edge_sink *s = NULL;
+
+	ggen_error_start_stack();
+	if(output == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	s = edge_sink_new(output);
+	GGEN_CHECK_ALLOC(s);
+	s->edge = edgelist_edge;
+	s->end = edgelist_end;
+
+	ggen_error_clean(1);
+	return s;
+ggen_error_label:
+	return NULL;
+}
+
+/* igraph sink: edges are buffered and the graph created in one go at the
+ * end. The graph is only initialized once the end hook succeeded. If the
+ * number of vertices is not given to begin, vertices are counted.
+ */
+struct igraph_sink {
+	igraph_t *g;
+	igraph_vector_t edges;
+	unsigned long n;
+	int init;
+};
+
+static int igraph_sink_begin(void *data, unsigned long n, unsigned long m)
+{
+	struct igraph_sink *d = data;
+	int err;
+
+	ggen_error_start_stack();
+	if(d->init)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&d->edges,0));
+	d->init = 1;
+	d->n = n;
+	GGEN_CHECK_IGRAPH(igraph_vector_reserve(&d->edges,2*m));
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+static int igraph_sink_edge(void *data, unsigned long from, unsigned long to)
+{
+	struct igraph_sink *d = data;
+	int err;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_IGRAPH(igraph_vector_push_back(&d->edges,from));
+	GGEN_CHECK_IGRAPH(igraph_vector_push_back(&d->edges,to));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+static int igraph_sink_vertex(void *data, unsigned long v)
+{
+	struct igraph_sink *d = data;
+	if(v >= d->n)
+		d->n = v + 1;
+	return GGEN_SUCCESS;
+}
+
+static int igraph_sink_end(void *data)
+{
+	struct igraph_sink *d = data;
+	int err;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_IGRAPH(igraph_create(d->g,&d->edges,d->n,1));
+	igraph_vector_destroy(&d->edges);
+	d->init = 0;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+static void igraph_sink_free(struct igraph_sink *d)
+{
+	if(d->init)
+		igraph_vector_destroy(&d->edges);
+	free(d);
+}
+
+struct ggen_edge_sink *ggen_edge_sink_igraph(igraph_t *g)
+{
+	struct ggen_edge_sink *s = NULL;
+	struct igraph_sink *d;
+
+	ggen_error_start_stack();
+	if(g == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	d = calloc(1,sizeof(struct igraph_sink));
+	GGEN_CHECK_ALLOC(d);
+	GGEN_FINALLY3(igraph_sink_free,d,1);
+	d->g = g;
+
+	s = edge_sink_new(d);
+	GGEN_CHECK_ALLOC(s);
+	s->begin = igraph_sink_begin;
+	s->vertex = igraph_sink_vertex;
+	s->edge = igraph_sink_edge;
+	s->end = igraph_sink_end;
+	s->free = (void (*)(void *))igraph_sink_free;
+
+	ggen_error_clean(1);
+	return s;
+ggen_error_label:
+	return NULL;
+}
@@ -64,6 +64,7 @@ const char *ggen_error_msgs[] = {
 	"no more memory",
 	"internal cgraph error",
 	"graph is not a dag",
+	"input/output error",
 };
 
 const char* ggen_error_strerror(void)
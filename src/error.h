@@ -66,6 +66,7 @@ typedef enum {
 	GGEN_ENOMEM = 5,
 	GGEN_CGRAPH_ERROR = 6,
 	GGEN_ENODAG = 7,
+	GGEN_EIO = 8,
 } ggen_error_type_t;
 
 typedef struct ggen_errno_st {
@@ -49,6 +49,10 @@
 #include <fcntl.h>
 #include <string.h>
 #include <getopt.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 
 #include "builtin.h"
 #include "ggen.h"
@@ -72,6 +76,25 @@ static const char * general_help[] = {
 	"--vertex                : manipulate a vertex property\n",
 	"--graph                 : manipulate a graph property\n",
 	"--name       <string>   : use string as name\n",
+	"--method     <string>   : use an alternative algorithm for the command\n",
+	"--threads,-t    <int>   : number of threads to use, if the command can\n",
+	"                          the result does not depend on it\n",
+	"--stream     <format>   : write the graph while it is generated, if the\n",
+	"                          command can, format is dot or edgelist\n",
+	"--batch      <int>      : generate that many graphs, each one written to\n",
+	"                          the output file with %i replaced by its index\n",
+	"                          with --threads, graphs are generated in parallel\n",
+	"--dry-run               : print the size of the graph, do not generate it\n",
+	"--block-size    <int>   : annotate tasks with their cost and edges with\n",
+	"                          their communication volume, for blocks of that size\n",
+	"--cost-table   <file>   : read kernel costs from file, each line being\n",
+	"                          name,comp,comp_exp,comm,comm_exp\n",
+	"--vertex-weight <name>  : use that vertex property as weight\n",
+	"--edge-weight   <name>  : use that edge property as weight\n",
+	"--annotate              : write the graph with the analysis results as\n",
+	"                          vertex properties, instead of printing them\n",
+	"--metrics    <list>     : comma-separated metrics to summarize, default all\n",
+	"--format     <format>   : write the summary as json or csv, default json\n",
 	"NOTE: most of these options are only available on some commands\n",
 	"\nEnvironment Variables:\n",
 	"GSL_RNG_SEED             : use this environment variable to change the RNG seed\n",
@@ -82,6 +105,8 @@ static const char * general_help[] = {
 	"static-graph            : generate static graphs\n",
 	"dataflow-graph          : generate dataflow graphs\n",
 	"analyse-graph           : use the graph analysis tools\n",
+	"analyse-family          : properties of a static or dataflow graph,\n",
+	"                          without generating it\n",
 	"transform-graph         : use the graph transformation tools\n",
 	"add-property            : use the property adding tools\n",
 	"analyse-property        : extract a property from the graph\n",
@@ -89,10 +114,11 @@ static const char * general_help[] = {
 };
 
 static struct first_lvl_cmd cmd_table[] = {
-	{ "generate-graph" , cmds_generate, NEED_OUTPUT | IS_GRAPH_P | NEED_RNG, help_generate },
-	{ "static-graph" , cmds_static, NEED_OUTPUT | IS_GRAPH_P,  help_static },
-	{ "dataflow-graph" , cmds_dataflow, NEED_OUTPUT | IS_GRAPH_P,  help_dataflow },
-	{ "analyse-graph", cmds_analyse, NEED_INPUT, help_analyse },
+	{ "generate-graph" , cmds_generate, NEED_OUTPUT | IS_GRAPH_P | NEED_RNG | NEED_METHOD | NEED_THREADS | NEED_STREAM | NEED_BATCH, help_generate },
+	{ "static-graph" , cmds_static, NEED_OUTPUT | IS_GRAPH_P | NEED_THREADS | NEED_DRY_RUN | NEED_COSTS,  help_static },
+	{ "dataflow-graph" , cmds_dataflow, NEED_OUTPUT | IS_GRAPH_P | NEED_STREAM | NEED_COSTS,  help_dataflow },
+	{ "analyse-graph", cmds_analyse, NEED_INPUT | NEED_METHOD | NEED_WEIGHTS | NEED_METRICS, help_analyse },
+	{ "analyse-family", cmds_analyse_family, 0, help_analyse_family },
 	{ "transform-graph", cmds_transform, NEED_INPUT | NEED_OUTPUT, help_transform },
 	{ "add-property", cmds_add_prop, NEED_INPUT | NEED_OUTPUT | NEED_RNG | NEED_NAME | NEED_TYPE, help_add_prop },
 	{ "analyse-property", cmds_analyse_prop, NEED_INPUT | NEED_NAME | NEED_TYPE, help_analyse_prop },
@@ -106,6 +132,10 @@ static int ask_version = 0;
 static char* rngfname = NULL;
 static char* infname = NULL;
 static char* outfname = NULL;
+static char* threadsval = NULL;
+static char* batchval = NULL;
+static char* blocksizeval = NULL;
+static char* costtablefname = NULL;
 
 /* logging variables */
 static char* logfname = NULL;
@@ -140,6 +170,15 @@ gsl_rng *rng = NULL;
 FILE *infile = NULL;
 FILE *outfile = NULL;
 char *name = NULL;
+char *method = NULL;
+char *stream_format = NULL;
+unsigned long batch = 0;
+int dry_run = 0;
+char *vertex_weight = NULL;
+char *edge_weight = NULL;
+int annotate = 0;
+char *metrics = NULL;
+char *summary_format = NULL;
 int ptype = -1;
 
 /* all command line arguments */
@@ -159,10 +198,28 @@ static struct option long_options[] = {
 	{ "edge", no_argument, &ptype, EDGE_PROPERTY },
 	{ "vertex", no_argument, &ptype, VERTEX_PROPERTY },
 	{ "graph", no_argument, &ptype, GRAPH_PROPERTY },
+	/* algorithm selection */
+	{ "method", required_argument, NULL, 'm' },
+	/* parallelism */
+	{ "threads", required_argument, NULL, 't' },
+	/* output */
+	{ "stream", required_argument, NULL, 's' },
+	{ "batch", required_argument, NULL, 'b' },
+	{ "dry-run", no_argument, &dry_run, 1 },
+	/* cost model */
+	{ "block-size", required_argument, NULL, 'B' },
+	{ "cost-table", required_argument, NULL, 'C' },
+	/* weighted analyses */
+	{ "vertex-weight", required_argument, NULL, 'W' },
+	{ "edge-weight", required_argument, NULL, 'E' },
+	{ "annotate", no_argument, &annotate, 1 },
+	/* summary */
+	{ "metrics", required_argument, NULL, 'M' },
+	{ "format", required_argument, NULL, 'F' },
 	{ 0, 0, 0, 0},
 };
 
-static const char* short_opts = ":hVi:o:r:n:f:l:";
+static const char* short_opts = ":hVi:o:r:n:f:l:m:t:";
 
 void print_help(const char **message) {
 	for(int i=0; message[i] != NULL; i++)
@@ -184,6 +241,22 @@ void print_first_lvl_help(struct first_lvl_cmd *fl)
 		fprintf(stdout,", edge, vertex, graph");
 	if(fl->flags & NEED_NAME)
 		fprintf(stdout,", name");
+	if(fl->flags & NEED_METHOD)
+		fprintf(stdout,", method");
+	if(fl->flags & NEED_THREADS)
+		fprintf(stdout,", threads");
+	if(fl->flags & NEED_STREAM)
+		fprintf(stdout,", stream");
+	if(fl->flags & NEED_BATCH)
+		fprintf(stdout,", batch");
+	if(fl->flags & NEED_DRY_RUN)
+		fprintf(stdout,", dry-run");
+	if(fl->flags & NEED_COSTS)
+		fprintf(stdout,", block-size, cost-table");
+	if(fl->flags & NEED_WEIGHTS)
+		fprintf(stdout,", vertex-weight, edge-weight, annotate");
+	if(fl->flags & NEED_METRICS)
+		fprintf(stdout,", metrics, format");
 	fprintf(stdout,"\n");
 	print_help(fl->help);
 	for(int i = 0; fl->cmds[i].name != NULL; i++)
@@ -273,6 +346,237 @@ int handle_need_rng(void)
 	return 0;
 }
 
+int handle_need_threads(void)
+{
+	unsigned long t;
+	normal("Configuring threads\n");
+	if(s2ul(threadsval,&t) || t == 0 || t > UINT_MAX || ggen_set_threads(t))
+	{
+		error("Invalid number of threads: %s\n",threadsval);
+		return 1;
+	}
+	info("Using %lu threads\n",t);
+	if(t > 1 && batchval == NULL && rng != NULL && rng->type != ggen_rng_philox)
+		warning("Threads are only used with the philox RNG (GSL_RNG_TYPE=philox)\n");
+	return 0;
+}
+
+int handle_need_costs(void)
+{
+	unsigned long b,n = 0;
+	struct ggen_kernel_cost *table = NULL;
+	int status;
+
+	normal("Annotating graph with kernel costs\n");
+	if(s2ul(blocksizeval,&b) || b == 0)
+	{
+		error("Invalid block size: %s\n",blocksizeval);
+		return 1;
+	}
+	if(costtablefname != NULL && read_cost_table(costtablefname,&table,&n))
+		return 1;
+	status = ggen_set_costs(g_p,b,table,n);
+	if(status)
+		error("Cost annotation failed: %s\n",ggen_error_strerror());
+	else
+		info("Using %lu as block size\n",b);
+	free_cost_table(table,n);
+	return status;
+}
+
+/*========= BATCH MODE ===========
+ * --batch N runs the command N times, graph i being written to the output
+ * file name with %i replaced by i. The RNG of graph i is seeded with a hash
+ * of i and of a base seed drawn from the configured RNG: the graphs only
+ * depend on the seed, not on the number of workers.
+ *
+ * philox uses the whole 64 bit seed as its key, the other GSL types only the
+ * low 32 bits of it, and most of them replace 0 by a default seed. The seeds
+ * of a batch are made distinct in those bits, so no two graphs of a batch
+ * share a stream, up to 2^32 - 1 graphs.
+ *
+ * The library is not thread safe (error stack, igraph), so workers are
+ * processes. The parent is one of them, the others are forked. A counter
+ * shared by all of them gives the next graph to generate.
+ */
+
+/* murmur3 32 bit finalizer: a bijection that only maps 0 to 0 */
+static uint32_t batch_mix32(uint32_t x)
+{
+	x = (x ^ (x >> 16)) * UINT32_C(0x85EBCA6B);
+	x = (x ^ (x >> 13)) * UINT32_C(0xC2B2AE35);
+	return x ^ (x >> 16);
+}
+
+/* splitmix64 finalizer (S. Vigna), good enough to derive independent seeds
+ * from consecutive integers. It is a bijection, so philox keys are distinct.
+ * The low 32 bits are replaced by the mix of a counter that never wraps to 0
+ * inside a batch: distinct and non zero.
+ */
+static unsigned long batch_seed(const gsl_rng_type *t, uint64_t base,
+		unsigned long i)
+{
+	uint64_t z = base + (i + 1) * UINT64_C(0x9E3779B97F4A7C15);
+	uint32_t low;
+	z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+	z = z ^ (z >> 31);
+	if(t == ggen_rng_philox)
+		return z;
+	low = (uint32_t)((base % UINT32_MAX + i) % UINT32_MAX);
+	low = batch_mix32(low + 1);
+	return (z & ~UINT64_C(0xFFFFFFFF)) | low;
+}
+
+static int batch_worker(int argc, char **argv, struct second_lvl_cmd *sl,
+		uint64_t base, unsigned long *next)
+{
+	int status = 0;
+	unsigned long i;
+	char index[32];
+	char *fname;
+	gsl_rng *batch_rng = rng;
+
+	// the graphs are generated in parallel, not their rows
+	ggen_set_threads(1);
+
+	rng = gsl_rng_alloc(batch_rng->type);
+	if(rng == NULL)
+	{
+		error("Failed to initialize RNG\n");
+		rng = batch_rng;
+		return 1;
+	}
+
+	while(!status && (i = __sync_fetch_and_add(next,1)) < batch)
+	{
+		gsl_rng_set(rng,batch_seed(rng->type,base,i));
+		snprintf(index,sizeof(index),"%lu",i);
+		fname = template_fill(outfname,"%i",index);
+		if(fname == NULL)
+		{
+			status = 1;
+			break;
+		}
+		info("Generating graph %lu in %s\n",i,fname);
+		outfile = fopen(fname,"w");
+		if(!outfile)
+		{
+			error("Failed to open file %s for output\n",fname);
+			free(fname);
+			status = 1;
+			break;
+		}
+
+		g_p = NULL;
+		status = sl->fn(argc,argv);
+		if(status)
+			error("Command Failed\n");
+		else if(g_p != NULL)
+		{
+			status = ggen_write_graph(g_p,outfile);
+			if(status)
+				error("Writing graph failed\n");
+		}
+		if(g_p != NULL)
+		{
+			igraph_destroy(g_p);
+			free(g_p);
+			g_p = NULL;
+		}
+		if(fclose(outfile))
+			status = 1;
+		outfile = NULL;
+		// do not leave partial graphs behind
+		if(status)
+			remove(fname);
+		free(fname);
+	}
+
+	gsl_rng_free(rng);
+	rng = batch_rng;
+	return status;
+}
+
+int handle_batch(int argc, char **argv, struct second_lvl_cmd *sl)
+{
+	int status = 0,wstatus;
+	unsigned long w,workers = 1;
+	unsigned long *next;
+	uint64_t base;
+	pid_t *pids;
+
+	normal("Configuring batch\n");
+	if(s2ul(batchval,&batch) || batch == 0)
+	{
+		error("Invalid number of graphs: %s\n",batchval);
+		return 1;
+	}
+	if(rng->type != ggen_rng_philox && batch > UINT32_MAX)
+	{
+		error("Only philox can seed more than %lu graphs\n",
+				(unsigned long)UINT32_MAX);
+		return 1;
+	}
+	if(outfname == NULL || strstr(outfname,"%i") == NULL)
+	{
+		error("Batch mode needs an output file containing %%i\n");
+		return 1;
+	}
+	if(threadsval != NULL)
+		workers = ggen_get_threads();
+	if(workers > batch)
+		workers = batch;
+	info("Generating %lu graphs with %lu workers\n",batch,workers);
+
+	// base seed of the batch, the RNG state saved is the one after it
+	base = gsl_rng_get(rng);
+	base = (base << 32) ^ gsl_rng_get(rng);
+
+	next = mmap(NULL,sizeof(unsigned long),PROT_READ|PROT_WRITE,
+			MAP_SHARED|MAP_ANONYMOUS,-1,0);
+	if(next == MAP_FAILED)
+	{
+		error("Failed to allocate the batch counter\n");
+		return 1;
+	}
+	*next = 0;
+
+	pids = calloc(workers,sizeof(pid_t));
+	if(pids == NULL)
+	{
+		munmap(next,sizeof(unsigned long));
+		return 1;
+	}
+
+	// a worker we cannot fork is not a problem: the others take its graphs
+	for(w = 1; w < workers; w++)
+	{
+		pids[w] = fork();
+		if(pids[w] == 0)
+			_exit(batch_worker(argc,argv,sl,base,next));
+		else if(pids[w] < 0)
+			warning("Failed to start worker %lu\n",w);
+	}
+	status = batch_worker(argc,argv,sl,base,next);
+	for(w = 1; w < workers; w++)
+		if(pids[w] > 0)
+		{
+			if(waitpid(pids[w],&wstatus,0) < 0 || !WIFEXITED(wstatus)
+					|| WEXITSTATUS(wstatus) != 0)
+			{
+				error("Worker %lu failed\n",w);
+				status = 1;
+			}
+		}
+
+	free(pids);
+	munmap(next,sizeof(unsigned long));
+	if(!status)
+		normal("Batch of %lu graphs generated\n",batch);
+	return status;
+}
+
 int handle_second_lvl(int argc,char **argv,struct first_lvl_cmd *fl, struct second_lvl_cmd *sl)
 {
 	int status = 0;
@@ -305,6 +609,13 @@ int handle_second_lvl(int argc,char **argv,struct first_lvl_cmd *fl, struct seco
 		if(status)
 			goto free_ing;
 	}
+	// set threads
+	if((fl->flags & NEED_THREADS) && threadsval != NULL)
+	{
+		status = handle_need_threads();
+		if(status)
+			goto err;
+	}
 	// set name
 	if((fl->flags & NEED_NAME) && name == NULL)
 	{
@@ -318,6 +629,15 @@ int handle_second_lvl(int argc,char **argv,struct first_lvl_cmd *fl, struct seco
 		info("Property type needed, using VERTEX as default\n");
 	}
 
+	// batch mode opens its own outputs
+	if(batchval != NULL)
+	{
+		status = handle_batch(argc,argv,sl);
+		if(status)
+			goto err;
+		goto save_rng;
+	}
+
 	// output is a bit different from input:
 	// a command can have its output redirected even
 	// if it does not generate a graph
@@ -347,7 +667,16 @@ int handle_second_lvl(int argc,char **argv,struct first_lvl_cmd *fl, struct seco
 		goto err;
 	}
 
-	if(fl->flags & NEED_OUTPUT)
+	// annotate the graph with the cost model
+	if(blocksizeval != NULL && g_p != NULL)
+	{
+		status = handle_need_costs();
+		if(status)
+			goto free_outg;
+	}
+
+	// a command can write its graphs itself and leave g_p empty
+	if((fl->flags & NEED_OUTPUT) && !((fl->flags & IS_GRAPH_P) && g_p == NULL))
 	{
 		normal("Printing graph\n");
 		if(fl->flags & IS_GRAPH_P)
@@ -363,6 +692,7 @@ int handle_second_lvl(int argc,char **argv,struct first_lvl_cmd *fl, struct seco
 		else
 			normal("Graph printed\n");
 	}
+save_rng:
 	if((fl->flags & NEED_RNG) && rngfname)
 	{
 		normal("Saving RNG state\n");
@@ -375,10 +705,10 @@ int handle_second_lvl(int argc,char **argv,struct first_lvl_cmd *fl, struct seco
 			normal("RNG Saved\n");
 	}
 free_outg:
-	if(outfname)
+	if(outfname && outfile != NULL)
 		fclose(outfile);
 
-	if(fl->flags & IS_GRAPH_P)
+	if((fl->flags & IS_GRAPH_P) && g_p != NULL)
 	{
 		igraph_destroy(g_p);
 		free(g_p);
@@ -423,6 +753,58 @@ int handle_first_lvl(int argc, char **argv, struct first_lvl_cmd *c)
 		error("RNG state file not needed\n");
 		return 1;
 	}
+	if(method != NULL && !(c->flags & NEED_METHOD))
+	{
+		error("Method selection not available\n");
+		return 1;
+	}
+	if(threadsval != NULL && !(c->flags & NEED_THREADS))
+	{
+		error("Threads not available\n");
+		return 1;
+	}
+	if(stream_format != NULL && !(c->flags & NEED_STREAM))
+	{
+		error("Streaming not available\n");
+		return 1;
+	}
+	if(batchval != NULL && !(c->flags & NEED_BATCH))
+	{
+		error("Batch mode not available\n");
+		return 1;
+	}
+	if(dry_run && !(c->flags & NEED_DRY_RUN))
+	{
+		error("Dry run not available\n");
+		return 1;
+	}
+	if(blocksizeval != NULL && !(c->flags & NEED_COSTS))
+	{
+		error("Cost annotation not available\n");
+		return 1;
+	}
+	if(blocksizeval != NULL && (stream_format != NULL || dry_run))
+	{
+		error("Cost annotation needs the whole graph\n");
+		return 1;
+	}
+	if(costtablefname != NULL && blocksizeval == NULL)
+	{
+		error("Cost table given without a block size\n");
+		return 1;
+	}
+	if((vertex_weight != NULL || edge_weight != NULL || annotate) &&
+	   !(c->flags & NEED_WEIGHTS))
+	{
+		error("Weights not available\n");
+		return 1;
+	}
+	if((metrics != NULL || summary_format != NULL) &&
+	   !(c->flags & NEED_METRICS))
+	{
+		error("Metrics not available\n");
+		return 1;
+	}
 	// find second lvl command
 	info("Searching subcommand %s\n",argv[0]);
 	for(int j = 0; c->cmds[j].name != NULL; j++)
@@ -472,6 +854,36 @@ int main(int argc,char** argv)
 			case 'n':
 				name = optarg;
 				break;
+			case 'm':
+				method = optarg;
+				break;
+			case 't':
+				threadsval = optarg;
+				break;
+			case 's':
+				stream_format = optarg;
+				break;
+			case 'b':
+				batchval = optarg;
+				break;
+			case 'B':
+				blocksizeval = optarg;
+				break;
+			case 'C':
+				costtablefname = optarg;
+				break;
+			case 'W':
+				vertex_weight = optarg;
+				break;
+			case 'E':
+				edge_weight = optarg;
+				break;
+			case 'M':
+				metrics = optarg;
+				break;
+			case 'F':
+				summary_format = optarg;
+				break;
 			case 'h':
 				ask_help = 1;
 				break;
@@ -56,6 +56,29 @@
 
 const char* ggen_error_strerror(void);
 
+/**********************************************************
+ * Random number generation
+ *********************************************************/
+
+/* counter based generator, usable with any GSL function. The seed is the key,
+ * the numbers of a (stream, counter) position only depend on the key.
+ * Each counter value gives 4 numbers.
+ */
+extern const gsl_rng_type *ggen_rng_philox;
+
+int ggen_rng_philox_seek(gsl_rng *r, unsigned long stream, unsigned long counter);
+
+int ggen_rng_philox_tell(const gsl_rng *r, unsigned long *stream, unsigned long *counter);
+
+/* number of threads used by the generators working row by row, and by the
+ * recursive static graphs (fibonacci, strassen). Random generators only use
+ * threads with a counter based generator. The graph generated does not
+ * depend on their number. Defaults to 1.
+ */
+int ggen_set_threads(unsigned int threads);
+
+unsigned int ggen_get_threads(void);
+
 /**********************************************************
  * Analysis methods
  *********************************************************/
@@ -64,18 +87,107 @@ igraph_vector_t * ggen_analyze_longest_path(igraph_t *g);
 
 igraph_vector_t * ggen_analyze_longest_antichain(igraph_t *g);
 
+/* minimum chain decomposition: stores in chains the chain id of each vertex,
+ * from 0 to width-1, the vertices of a chain being pairwise comparable. The
+ * same computation gives a longest antichain, of width vertices. Each of
+ * chains, antichain and width can be NULL.
+ */
+int ggen_analyze_chain_decomposition(igraph_t *g, igraph_vector_t *chains,
+				     igraph_vector_t *antichain,
+				     unsigned long *width);
+
 igraph_vector_t * ggen_analyze_lowest_single_ancestor(igraph_t *g);
 
 igraph_vector_t * ggen_analyze_edge_disjoint_paths(igraph_t *g);
 
+/* edge-disjoint paths covering all the edges: stores in paths the index of the
+ * path of each edge and in count, if not NULL, the number of paths. The
+ * shortest method is the one of ggen_analyze_edge_disjoint_paths, the minimum
+ * method gives as few paths as possible, in O(V+E).
+ */
+enum ggen_paths_t { GGEN_PATHS_SHORTEST, GGEN_PATHS_MINIMUM };
+
+int ggen_analyze_path_decomposition(igraph_t *g, enum ggen_paths_t method,
+				    igraph_vector_t *paths,
+				    unsigned long *count);
+
+/* metrics of ggen_analyze_summary, or-ed together */
+#define GGEN_SUMMARY_COUNTS		1
+#define GGEN_SUMMARY_DEGREES		2
+#define GGEN_SUMMARY_ENDS		4
+#define GGEN_SUMMARY_DEPTH		8
+#define GGEN_SUMMARY_CRITICAL_PATH	16
+#define GGEN_SUMMARY_WIDTH		32
+#define GGEN_SUMMARY_LEVELS		64
+#define GGEN_SUMMARY_TRANSITIVE		128
+#define GGEN_SUMMARY_ALL		255
+
+/* structural properties of a graph, computed together by ggen_analyze_summary.
+ * The fields of the metrics not asked for are zero, or empty vectors.
+ */
+struct ggen_summary {
+	/* GGEN_SUMMARY_COUNTS */
+	unsigned long vertices;
+	unsigned long edges;
+	/* GGEN_SUMMARY_DEGREES: number of vertices of each degree */
+	igraph_vector_t in_degrees;
+	igraph_vector_t out_degrees;
+	/* GGEN_SUMMARY_ENDS */
+	unsigned long sources;
+	unsigned long sinks;
+	/* GGEN_SUMMARY_DEPTH: number of vertices on a longest path */
+	unsigned long depth;
+	/* GGEN_SUMMARY_CRITICAL_PATH: length of the weighted critical path */
+	double critical_path;
+	/* GGEN_SUMMARY_WIDTH: size of a longest antichain */
+	unsigned long width;
+	/* GGEN_SUMMARY_LEVELS: number of vertices at each level, the number of
+	 * edges of the longest path reaching them */
+	igraph_vector_t levels;
+	/* GGEN_SUMMARY_TRANSITIVE: share of the edges (u,v) such that another
+	 * path goes from u to v */
+	double transitive;
+};
+
+/* computes the metrics of s in shared sweeps over a single snapshot and
+ * topological order of g. vweight and eweight are used by the critical path,
+ * as in ggen_analyze_critical_path. s must be destroyed with
+ * ggen_summary_destroy when the call succeeds.
+ */
+int ggen_analyze_summary(igraph_t *g, unsigned int metrics,
+			 const char *vweight, const char *eweight,
+			 struct ggen_summary *s);
+
+void ggen_summary_destroy(struct ggen_summary *s);
+
+/* weighted critical path: vweight and eweight name numeric or string vertex
+ * and edge attributes, NULL giving a weight of 1 to each vertex and 0 to each
+ * edge. The top level of a vertex is the length of the longest path reaching
+ * it, without its own weight, its bottom level the length of the longest path
+ * leaving it, with its weight. Each of path, top, bottom, slack and length
+ * can be NULL.
+ */
+int ggen_analyze_critical_path(igraph_t *g, const char *vweight,
+			       const char *eweight, igraph_vector_t *path,
+			       igraph_vector_t *top, igraph_vector_t *bottom,
+			       igraph_vector_t *slack, double *length);
+
 /**********************************************************
  * Generation methods
  *********************************************************/
 
 igraph_t *ggen_generate_erdos_gnm(gsl_rng *r, unsigned long n, unsigned long m);
 
+igraph_t *ggen_generate_erdos_gnm_sparse(gsl_rng *r, unsigned long n, unsigned long m);
+
 igraph_t *ggen_generate_erdos_gnp(gsl_rng *r, unsigned long n, double p);
 
+igraph_t *ggen_generate_erdos_gnp_sparse(gsl_rng *r, unsigned long n, double p);
+
+igraph_vector_ptr_t *ggen_generate_erdos_gnp_sweep(gsl_rng *r, unsigned long n, const igraph_vector_t *ps);
+
+igraph_vector_ptr_t *ggen_generate_erdos_gnm_sweep(gsl_rng *r, unsigned long n, const igraph_vector_t *ms);
+
 igraph_t *ggen_generate_erdos_lbl(gsl_rng *r, unsigned long n, double p, unsigned long nbl);
 
 igraph_t *ggen_generate_fifo(gsl_rng *r, unsigned long n, unsigned long od, unsigned long id);
@@ -100,6 +212,41 @@ igraph_t *ggen_generate_strassen(unsigned long size, unsigned long depth, unsign
 
 igraph_t *ggen_generate_poisson2d(unsigned long n, unsigned long iter);
 
+/* exact number of vertices and edges of the static graphs, without
+ * generating them. Fail on invalid parameters, or if the counts overflow.
+ */
+int ggen_count_fibonacci(unsigned long n, unsigned long cutoff,
+			 unsigned long *vertices, unsigned long *edges);
+
+int ggen_count_forkjoin(unsigned long phases, unsigned long diameter,
+			unsigned long *vertices, unsigned long *edges);
+
+int ggen_count_strassen(unsigned long size, unsigned long depth,
+			unsigned long cutoff, unsigned long *vertices,
+			unsigned long *edges);
+
+/* properties of the graph a parametrised generator would build, computed from
+ * its parameters alone.
+ */
+struct ggen_family_metrics {
+	unsigned long vertices;
+	unsigned long edges;
+	/* number of vertices on a longest path */
+	unsigned long critical_path;
+	/* size of a longest antichain */
+	unsigned long width;
+};
+
+/* family is one of cholesky (size), denselu (size), fibonacci (n, cutoff),
+ * forkjoin (phases, diameter) and strassen (size, depth, cutoff), params
+ * holding the parameters of its generator. If kernels and counts are not
+ * NULL, they receive the kernel types of the family and the number of tasks
+ * of each type. Fails on unknown families, invalid parameters or overflows.
+ */
+int ggen_analyze_family(const char *family, const unsigned long *params,
+			unsigned long nparams, struct ggen_family_metrics *m,
+			igraph_strvector_t *kernels, igraph_vector_t *counts);
+
 /**********************************************************
  * Transformation methods
  *********************************************************/
@@ -132,4 +279,104 @@ int ggen_write_graph(igraph_t *g,FILE *output);
  */
 char * ggen_vname(igraph_t *g, char *buf, unsigned long id);
 
+/* kernel types of task graphs:
+ * the kernel of each task is a numeric vertex attribute, indexing a
+ * dictionary of names saved in a graph attribute. Names are only expanded
+ * when writing the graph, and interned again when reading it.
+ */
+#define GGEN_KERNEL_ATTR "kernel"
+#define GGEN_KERNEL_NAMES_ATTR "__ggen_kernels"
+
+/* get the kernel names and the type of each vertex (an index in names).
+ * A string kernel attribute is interned on the fly. Vertices without a kernel,
+ * like all the vertices of a graph without kernels, the ones added after
+ * the kernels were set or the ones read with an empty kernel, get type -1.
+ */
+int ggen_get_kernels(igraph_t *g, igraph_strvector_t *names,
+		     igraph_vector_t *types);
+
+/* set the kernel types of all vertices, -1 for no kernel. Names cannot
+ * contain commas and must be shorter than GGEN_DEFAULT_NAME_SIZE.
+ */
+int ggen_set_kernels(igraph_t *g, const igraph_strvector_t *names,
+		     const igraph_vector_t *types);
+
+/* cost model of task graphs: working on blocks of b*b elements, a task
+ * performs comp * b^comp_exp operations and sends comm * b^comm_exp elements
+ * along each of its outgoing edges.
+ */
+#define GGEN_COST_ATTR "cost"
+#define GGEN_COMM_ATTR "comm"
+
+struct ggen_kernel_cost {
+	const char *name;
+	double comp;
+	unsigned int comp_exp;
+	double comm;
+	unsigned int comm_exp;
+};
+
+/* the costs of the kernels of the static and dataflow graphs */
+extern const struct ggen_kernel_cost ggen_kernel_costs[];
+extern const unsigned long ggen_kernel_costs_size;
+
+/* set the cost attribute of each task and the comm attribute of each edge,
+ * for blocks of size b. Kernels are searched in table (n entries, NULL if
+ * n is 0) first, then in ggen_kernel_costs. Tasks without a kernel cost
+ * nothing. Fails if g has no kernels or one of them has no cost.
+ */
+int ggen_set_costs(igraph_t *g, unsigned long b,
+		   const struct ggen_kernel_cost *table, unsigned long n);
+
+/**********************************************************
+ * Streaming generation
+ *********************************************************/
+
+/* an edge sink receives a graph piece by piece: begin with the number of
+ * vertices n (0 if unknown) and a hint m on the number of edges, vertex for
+ * each vertex in order, edge for each edge, then end. Hooks return
+ * GGEN_SUCCESS or GGEN_FAILURE, any of them except edge can be NULL.
+ * Task graphs call task instead of vertex, with the kernel name of the task,
+ * and dependency instead of edge, with the coordinates (x, y, z) of the block
+ * behind it, when these hooks exist. Vertices then come in order, each
+ * followed by its incoming edges.
+ * The sinks below are allocated by ggen and released by ggen_edge_sink_free,
+ * which calls free on data.
+ */
+struct ggen_edge_sink {
+	int (*begin)(void *data, unsigned long n, unsigned long m);
+	int (*vertex)(void *data, unsigned long v);
+	int (*edge)(void *data, unsigned long from, unsigned long to);
+	int (*end)(void *data);
+	void (*free)(void *data);
+	void *data;
+	int (*task)(void *data, unsigned long v, const char *kernel);
+	int (*dependency)(void *data, unsigned long from, unsigned long to,
+			  int dims, const unsigned long *coords);
+};
+
+/* writes the graph in the DOT format, name can be NULL */
+struct ggen_edge_sink *ggen_edge_sink_dot(FILE *output, const char *name);
+
+/* writes one "from to" line per edge */
+struct ggen_edge_sink *ggen_edge_sink_edgelist(FILE *output);
+
+/* builds the graph into g, initialized by the end hook */
+struct ggen_edge_sink *ggen_edge_sink_igraph(igraph_t *g);
+
+void ggen_edge_sink_free(struct ggen_edge_sink *s);
+
+int ggen_stream_erdos_gnp(gsl_rng *r, unsigned long n, double p, struct ggen_edge_sink *s);
+
+int ggen_stream_erdos_gnm(gsl_rng *r, unsigned long n, unsigned long m, struct ggen_edge_sink *s);
+
+/* dataflow graphs, only keeping the state of each block in memory */
+int ggen_stream_cholesky(unsigned long n, struct ggen_edge_sink *s);
+
+int ggen_stream_denselu(unsigned long size, struct ggen_edge_sink *s);
+
+int ggen_stream_sparselu(unsigned long size, struct ggen_edge_sink *s);
+
+int ggen_stream_poisson2d(unsigned long n, unsigned long iter, struct ggen_edge_sink *s);
+
 #endif // GGEN_H
@@ -44,9 +44,10 @@
 
 #include "ggen.h"
 #include <stdlib.h>
-#include "vector_utils.h"
-#include "bipartite-matching.h"
+#include <string.h>
+#include "reachability.h"
 #include "tree-lowest-common-ancestor.h"
+#include "csr.h"
 #include "error.h"
 
 igraph_vector_t * ggen_analyze_longest_path(igraph_t *g)
@@ -54,10 +55,10 @@ igraph_vector_t * ggen_analyze_longest_path(igraph_t *g)
 	igraph_vector_t topology;
 	igraph_vector_t lengths;
 	igraph_vector_t preds;
-	igraph_vs_t vs;
-	igraph_vit_t vit;
 	igraph_vector_t *res = NULL;
+	csr_t c;
 	unsigned long v,i,f,t;
+	int64_t j;
 	long maxv;
 
 	ggen_error_start_stack();
@@ -79,11 +80,14 @@ igraph_vector_t * ggen_analyze_longest_path(igraph_t *g)
 	GGEN_FINALLY3(free,res,1);
 
 	GGEN_CHECK_IGRAPH(igraph_vector_init(res,v));
-	GGEN_FINALLY3(igraph_destroy,res,1);
+	GGEN_FINALLY3(igraph_vector_destroy,res,1);
 
 	// sort topologically the vertices
 	GGEN_CHECK_IGRAPH(igraph_topological_sorting(g,&topology,IGRAPH_OUT));
 
+	GGEN_CHECK_INTERNAL_ERRNO(csr_init(&c,g));
+	GGEN_FINALLY(csr_free,&c);
+
 	// find the best path incomming from every node
 	igraph_vector_null(&lengths);
 	igraph_vector_fill(&preds,-1);
@@ -91,15 +95,9 @@ igraph_vector_t * ggen_analyze_longest_path(igraph_t *g)
 	for(i = 0; i < v; i++)
 	{
 		f = VECTOR(topology)[i];
-		GGEN_CHECK_IGRAPH(igraph_vs_adj(&vs,f,IGRAPH_OUT));
-		GGEN_FINALLY(igraph_vs_destroy,&vs);
-
-		GGEN_CHECK_IGRAPH(igraph_vit_create(g,vs,&vit));
-		GGEN_FINALLY(igraph_vit_destroy,&vit);
-
-		for(; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit))
+		for(j = c.out_offsets[f]; j < c.out_offsets[f+1]; j++)
 		{
-			t = IGRAPH_VIT_GET(vit);
+			t = c.out_targets[j];
 			if(VECTOR(lengths)[t] < VECTOR(lengths)[f] + 1)
 			{
 				VECTOR(lengths)[t] = VECTOR(lengths)[f] +1;
@@ -108,9 +106,6 @@ igraph_vector_t * ggen_analyze_longest_path(igraph_t *g)
 			if(maxv == -1 || VECTOR(lengths)[t] > VECTOR(lengths)[maxv])
 				maxv = t;
 		}
-		// if everything went ok, we need to pop the destructor for vs
-		// and vit
-		ggen_error_pop(2);
 	}
 	// build the path, using preds and maxv
 	f = 0;
@@ -130,6 +125,198 @@ ggen_error_label:
 	return NULL;
 }
 
+/* values of a vertex or edge attribute, string ones (read from a file) being
+ * converted. Fails if the attribute does not exist or a value is not a number.
+ */
+static int attribute_values(igraph_t *g, igraph_attribute_elemtype_t elem,
+			    const char *attr, unsigned long count,
+			    igraph_vector_t *res)
+{
+	igraph_strvector_t names;
+	igraph_vector_t types;
+	const char *str;
+	char *end;
+	unsigned long i;
+	int type = -1;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_IGRAPH(igraph_strvector_init(&names,0));
+	GGEN_FINALLY(igraph_strvector_destroy,&names);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&types,0));
+	GGEN_FINALLY(igraph_vector_destroy,&types);
+	if(elem == IGRAPH_ATTRIBUTE_VERTEX)
+		GGEN_CHECK_IGRAPH(igraph_cattribute_list(g,NULL,NULL,&names,
+							 &types,NULL,NULL));
+	else
+		GGEN_CHECK_IGRAPH(igraph_cattribute_list(g,NULL,NULL,NULL,NULL,
+							 &names,&types));
+	for(i = 0; i < igraph_strvector_size(&names); i++)
+		if(!strcmp(STR(names,i),attr))
+			type = VECTOR(types)[i];
+
+	GGEN_CHECK_IGRAPH(igraph_vector_resize(res,count));
+	if(type == IGRAPH_ATTRIBUTE_NUMERIC)
+	{
+		if(elem == IGRAPH_ATTRIBUTE_VERTEX)
+			GGEN_CHECK_IGRAPH(VANV(g,attr,res));
+		else
+			GGEN_CHECK_IGRAPH(EANV(g,attr,res));
+	}
+	else if(type == IGRAPH_ATTRIBUTE_STRING)
+	{
+		for(i = 0; i < count; i++)
+		{
+			if(elem == IGRAPH_ATTRIBUTE_VERTEX)
+				str = VAS(g,attr,i);
+			else
+				str = EAS(g,attr,i);
+			VECTOR(*res)[i] = strtod(str,&end);
+			if(end == str || *end != '\0')
+				GGEN_SET_ERRNO(GGEN_EINVAL);
+		}
+	}
+	else
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* Critical path: vertices are sorted topologically on the adjacency
+ * snapshot, top levels are then computed in this order and bottom levels in
+ * the reverse one, each in a single scan of the edges. The best successor of
+ * each vertex is kept along the bottom levels, the path follows them from the
+ * vertex of largest bottom level.
+ */
+static int critical_path(igraph_t *g, const csr_t *csr, const int32_t *order,
+			 const char *vweight, const char *eweight,
+			 igraph_vector_t *path, igraph_vector_t *top,
+			 igraph_vector_t *bottom, igraph_vector_t *slack,
+			 double *length)
+{
+	igraph_vector_t w,c,tl,bl;
+	int32_t *next = NULL;
+	int64_t j;
+	long v,u,i,n,first;
+	double len,val;
+
+	ggen_error_start_stack();
+	n = csr->vcount;
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&w,n));
+	GGEN_FINALLY(igraph_vector_destroy,&w);
+	if(vweight != NULL)
+		GGEN_CHECK_INTERNAL_ERRNO(attribute_values(g,
+				IGRAPH_ATTRIBUTE_VERTEX,vweight,n,&w));
+	else
+		igraph_vector_fill(&w,1);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&c,csr->ecount));
+	GGEN_FINALLY(igraph_vector_destroy,&c);
+	if(eweight != NULL)
+		GGEN_CHECK_INTERNAL_ERRNO(attribute_values(g,
+				IGRAPH_ATTRIBUTE_EDGE,eweight,csr->ecount,&c));
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&tl,n));
+	GGEN_FINALLY(igraph_vector_destroy,&tl);
+	for(i = 0; i < n; i++)
+	{
+		v = order[i];
+		for(j = csr->in_offsets[v]; j < csr->in_offsets[v+1]; j++)
+		{
+			u = csr->in_sources[j];
+			val = VECTOR(tl)[u] + VECTOR(w)[u] + VECTOR(c)[csr->in_eids[j]];
+			if(val > VECTOR(tl)[v])
+				VECTOR(tl)[v] = val;
+		}
+	}
+
+	next = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(next);
+	GGEN_FINALLY(free,next);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&bl,n));
+	GGEN_FINALLY(igraph_vector_destroy,&bl);
+	len = 0;
+	first = -1;
+	for(i = n-1; i >= 0; i--)
+	{
+		v = order[i];
+		next[v] = -1;
+		for(j = csr->out_offsets[v]; j < csr->out_offsets[v+1]; j++)
+		{
+			u = csr->out_targets[j];
+			val = VECTOR(c)[csr->out_eids[j]] + VECTOR(bl)[u];
+			if(next[v] == -1 || val > VECTOR(bl)[v])
+			{
+				VECTOR(bl)[v] = val;
+				next[v] = u;
+			}
+		}
+		VECTOR(bl)[v] += VECTOR(w)[v];
+		if(first == -1 || VECTOR(bl)[v] >= len)
+		{
+			len = VECTOR(bl)[v];
+			first = v;
+		}
+	}
+
+	if(path != NULL)
+	{
+		igraph_vector_clear(path);
+		for(v = first; v != -1; v = next[v])
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(path,v));
+	}
+	if(slack != NULL)
+	{
+		GGEN_CHECK_IGRAPH(igraph_vector_resize(slack,n));
+		for(v = 0; v < n; v++)
+		{
+			val = len - VECTOR(tl)[v] - VECTOR(bl)[v];
+			VECTOR(*slack)[v] = val > 0 ? val : 0;
+		}
+	}
+	if(top != NULL)
+		GGEN_CHECK_IGRAPH(igraph_vector_update(top,&tl));
+	if(bottom != NULL)
+		GGEN_CHECK_IGRAPH(igraph_vector_update(bottom,&bl));
+	if(length != NULL)
+		*length = len;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int ggen_analyze_critical_path(igraph_t *g, const char *vweight,
+			       const char *eweight, igraph_vector_t *path,
+			       igraph_vector_t *top, igraph_vector_t *bottom,
+			       igraph_vector_t *slack, double *length)
+{
+	csr_t csr;
+	int32_t *order;
+
+	ggen_error_start_stack();
+	if(g == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_INTERNAL_ERRNO(csr_init(&csr,g));
+	GGEN_FINALLY(csr_free,&csr);
+
+	/* topological order, failing on cycles */
+	order = malloc((csr.vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(order);
+	GGEN_FINALLY(free,order);
+	GGEN_CHECK_INTERNAL_ERRNO(csr_topological_order(&csr,order));
+
+	GGEN_CHECK_INTERNAL_ERRNO(critical_path(g,&csr,order,vweight,eweight,
+						path,top,bottom,slack,length));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
 /* An antichain is defined as a set of vertices so that
  * no path exist between any couple of them.
  * For example, in the graph :
@@ -144,7 +331,13 @@ ggen_error_label:
  * This implementation finds the antichain of maximal size
  * by solving an equivalent problem : vertex cover on a bipartite
  * graph. This is solved by computing a maximum matching and
- * converting it to a vertex cover.
+ * converting it to a vertex cover. The bipartite graph is never
+ * built: its edges are the reachability of the DAG, as bit rows
+ * taking V^2/8 bytes.
+ *
+ * The same matching gives a minimum chain decomposition (Dilworth's
+ * theorem): the edges (u,v) of the matching chain u before v, and
+ * there are as many chains as vertices in the longest antichain.
  *
  * See the following links to understand what's going on :
  * https://en.wikipedia.org/wiki/Dilworth%27s_theorem
@@ -153,37 +346,80 @@ ggen_error_label:
  *
  */
 
-igraph_vector_t * ggen_analyze_longest_antichain(igraph_t *g)
+/* the matching of Dilworth's theorem on the reachability r of the snapshot c,
+ * giving the chains, the antichain and the width, each one being optional.
+ */
+static int dilworth(const csr_t *c, const reach_t *r, igraph_vector_t *chains,
+		    igraph_vector_t *antichain, unsigned long *width)
+{
+	int32_t *match_left,*match_right,u,v;
+	unsigned long count;
+
+	ggen_error_start_stack();
+	match_left = malloc((c->vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(match_left);
+	GGEN_FINALLY(free,match_left);
+	match_right = malloc((c->vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(match_right);
+	GGEN_FINALLY(free,match_right);
+	GGEN_CHECK_INTERNAL(reach_maximum_matching(r,match_left,match_right));
+
+	/* a chain starts at each vertex whose right copy is unmatched, and
+	 * goes on along the matching: there are |S| - |M| of them.
+	 */
+	if(chains != NULL)
+		GGEN_CHECK_IGRAPH(igraph_vector_resize(chains,c->vcount));
+	for(v = 0, count = 0; v < c->vcount; v++)
+		if(match_right[v] == -1)
+		{
+			if(chains != NULL)
+				for(u = v; u != -1; u = match_left[u])
+					VECTOR(*chains)[u] = count;
+			count++;
+		}
+	if(width != NULL)
+		*width = count;
+
+	/* our antichain is U - C, C being the vertex cover */
+	if(antichain != NULL)
+		GGEN_CHECK_INTERNAL(reach_antichain(r,match_left,match_right,
+						    antichain));
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int ggen_analyze_chain_decomposition(igraph_t *g, igraph_vector_t *chains,
+				     igraph_vector_t *antichain,
+				     unsigned long *width)
 {
 	/* The following steps are implemented :
-	 *  - Convert our DAG to a specific bipartite graph B
-	 *  - solve maximum matching on B
+	 *  - compute the reachability of each vertex of our DAG, as bit rows,
+	 *    defining a specific bipartite graph B
+	 *  - solve maximum matching on B, reading its edges from the rows
+	 *  - follow the matched edges to get the chains
 	 *  - convert maximum matching to min vectex cover
 	 *  - convert min vertex cover to antichain on G
 	 */
-	unsigned long i,vg,added;
-	igraph_t b,gstar;
-	igraph_vector_t edges,*res = NULL;
-	igraph_vector_t c,s,t,todo,n,next,l,r;
-	igraph_eit_t eit;
-	igraph_es_t es;
-	igraph_integer_t from,to;
-	long int pos;
+	int32_t *order;
+	csr_t csr;
+	reach_t reach;
 
 	ggen_error_start_stack();
 	if(g == NULL)
 		GGEN_SET_ERRNO(GGEN_EINVAL);
 
-	/* before creating the bipartite graph, we need all relations
-	 * between any two vertices : the transitive closure of g */
-	GGEN_CHECK_IGRAPH(igraph_copy(&gstar,g));
-	GGEN_FINALLY(igraph_destroy,&gstar);
-
-	GGEN_CHECK_IGRAPH(ggen_transform_transitive_closure(&gstar));
-
+	GGEN_CHECK_INTERNAL_ERRNO(csr_init(&csr,g));
+	GGEN_FINALLY(csr_free,&csr);
+	order = malloc((csr.vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(order);
+	GGEN_FINALLY(free,order);
+	GGEN_CHECK_INTERNAL_ERRNO(csr_topological_order(&csr,order));
 
 	/* Bipartite convertion : let G = (S,C),
-	 * we build B = (U,V,E) with
+	 * we consider B = (U,V,E) with
 	 *	- U = V = S (each vertex is present twice)
 	 *	- (u,v) \in E iff :
 	 *		- u \in U
@@ -191,173 +427,35 @@ igraph_vector_t * ggen_analyze_longest_antichain(igraph_t *g)
 	 *		- u < v in C (warning, this means that we take
 	 *		transitive closure into account, not just the
 	 *		original edges)
-	 * We will also need two additional nodes further in the code.
+	 * The edges of u are the row of u in the reachability of G.
 	 */
-	vg = igraph_vcount(g);
-	GGEN_CHECK_IGRAPH(igraph_empty(&b,vg*2,1));
-	GGEN_FINALLY(igraph_destroy,&b);
+	GGEN_CHECK_INTERNAL_ERRNO(reach_init(&reach,&csr,order));
+	GGEN_FINALLY(reach_free,&reach);
 
-	/* id and id+vg will be a vertex in U and its copy in V,
-	 * iterate over gstar edges to create edges in b
-	 */
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,igraph_ecount(&gstar)));
-	GGEN_FINALLY(igraph_vector_destroy,&edges);
-	igraph_vector_clear(&edges);
-
-	GGEN_CHECK_IGRAPH(igraph_eit_create(&gstar,igraph_ess_all(IGRAPH_EDGEORDER_ID),&eit));
-	GGEN_FINALLY(igraph_eit_destroy,&eit);
+	GGEN_CHECK_INTERNAL_ERRNO(dilworth(&csr,&reach,chains,antichain,width));
 
-	for(IGRAPH_EIT_RESET(eit); !IGRAPH_EIT_END(eit); IGRAPH_EIT_NEXT(eit))
-	{
-		igraph_edge(&gstar,IGRAPH_EIT_GET(eit),&from,&to);
-		to += vg;
-		igraph_vector_push_back(&edges,(igraph_real_t)from);
-		igraph_vector_push_back(&edges,(igraph_real_t)to);
-	}
-	// destroy eit
-	ggen_error_pop(1);
-	GGEN_CHECK_IGRAPH(igraph_add_edges(&b,&edges,NULL));
-
-	/* maximum matching on b */
-	igraph_vector_clear(&edges);
-	GGEN_CHECK_INTERNAL(bipartite_maximum_matching(&b,&edges));
-
-	/* Let M be the max matching, and N be E - M
-	 * Define T as all unmatched vectices from U as well as all vertices
-	 * reachable from those by going left-to-right along N and right-to-left along
-	 * M.
-	 * Define L = U - T, R = V \inter T
-	 * C:= L + R
-	 * C is a minimum vertex cover
-	 */
-	GGEN_CHECK_IGRAPH(igraph_vector_init_seq(&n,0,igraph_ecount(&b)-1));
-	GGEN_FINALLY(igraph_vector_destroy,&n);
-
-	GGEN_CHECK_INTERNAL(vector_diff(&n,&edges));
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&c,vg));
-	GGEN_FINALLY(igraph_vector_destroy,&c);
-	igraph_vector_clear(&c);
-
-	/* matched vertices : S */
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&s,vg));
-	GGEN_FINALLY(igraph_vector_destroy,&s);
-	igraph_vector_clear(&s);
-
-	for(i = 0; i < igraph_vector_size(&edges); i++)
-	{
-		igraph_edge(&b,VECTOR(edges)[i],&from,&to);
-		igraph_vector_push_back(&s,(igraph_real_t)from);
-	}
-	/* we may have inserted the same vertex multiple times */
-	GGEN_CHECK_INTERNAL(vector_uniq(&s));
-
-	/* unmatched */
-	GGEN_CHECK_IGRAPH(igraph_vector_init_seq(&t,0,vg-1));
-	GGEN_FINALLY(igraph_vector_destroy,&t);
-
-	GGEN_CHECK_INTERNAL(vector_diff(&t,&s));
-
-	/* alternating paths
-	 */
-	GGEN_CHECK_IGRAPH(igraph_vector_copy(&todo,&t));
-	GGEN_FINALLY(igraph_vector_destroy,&todo);
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&next,vg));
-	GGEN_FINALLY(igraph_vector_destroy,&next);
-	igraph_vector_clear(&next);
-
-	do {
-		vector_uniq(&todo);
-		added = 0;
-		for(i = 0; i < igraph_vector_size(&todo); i++)
-		{
-			if(VECTOR(todo)[i] < vg)
-			{
-				/* scan edges */
-				GGEN_CHECK_IGRAPH(igraph_es_incident(&es,VECTOR(todo)[i],IGRAPH_OUT));
-				GGEN_FINALLY(igraph_es_destroy,&es);
-
-				GGEN_CHECK_IGRAPH(igraph_eit_create(&b,es,&eit));
-				GGEN_FINALLY(igraph_eit_destroy,&eit);
-
-				for(IGRAPH_EIT_RESET(eit); !IGRAPH_EIT_END(eit); IGRAPH_EIT_NEXT(eit))
-				{
-					if(igraph_vector_binsearch(&n,IGRAPH_EIT_GET(eit),NULL))
-					{
-						igraph_edge(&b,IGRAPH_EIT_GET(eit),&from,&to);
-						if(!igraph_vector_binsearch(&t,to,&pos))
-						{
-							igraph_vector_push_back(&next, to);
-							igraph_vector_insert(&t, pos, to);
-							added = 1;
-						}
-					}
-				}
-			}
-			else
-			{
-				/* scan edges */
-				GGEN_CHECK_IGRAPH(igraph_es_incident(&es,VECTOR(todo)[i],IGRAPH_IN));
-				GGEN_FINALLY(igraph_es_destroy,&es);
-
-				GGEN_CHECK_IGRAPH(igraph_eit_create(&b,es,&eit));
-				GGEN_FINALLY(igraph_eit_destroy,&eit);
-
-				for(IGRAPH_EIT_RESET(eit); !IGRAPH_EIT_END(eit); IGRAPH_EIT_NEXT(eit))
-				{
-					if(igraph_vector_binsearch(&edges,IGRAPH_EIT_GET(eit),NULL))
-					{
-						igraph_edge(&b,IGRAPH_EIT_GET(eit),&from,&to);
-						if(!igraph_vector_binsearch(&t,from,&pos))
-						{
-							igraph_vector_push_back(&next,from);
-							igraph_vector_insert(&t, pos, from);
-							added = 1;
-						}
-					}
-				}
-			}
-			// destroy es and eit
-			ggen_error_pop(2);
-		}
-		igraph_vector_clear(&todo);
-		igraph_vector_append(&todo,&next);
-		igraph_vector_clear(&next);
-	} while(added);
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init_seq(&l,0,(igraph_real_t)(vg-1)));
-	GGEN_FINALLY(igraph_vector_destroy,&l);
-
-	GGEN_CHECK_INTERNAL(vector_diff(&l,&t));
-
-	GGEN_CHECK_IGRAPH(igraph_vector_update(&c,&l));
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&r,vg));
-	GGEN_FINALLY(igraph_vector_destroy,&r);
-	igraph_vector_clear(&r);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
 
-	/* compute V \inter T */
-	for(i = 0; i < igraph_vector_size(&t); i++)
-	{
-		if(VECTOR(t)[i] >= vg)
-			igraph_vector_push_back(&r,VECTOR(t)[i]);
-	}
+igraph_vector_t * ggen_analyze_longest_antichain(igraph_t *g)
+{
+	igraph_vector_t a,*res = NULL;
 
-	for(i = 0; i < igraph_vector_size(&r); i++)
-		VECTOR(r)[i] = VECTOR(r)[i] - vg;
+	ggen_error_start_stack();
+	if(g == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
 
-	GGEN_CHECK_INTERNAL(vector_union(&c,&r));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&a,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&a,1);
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_analyze_chain_decomposition(g,NULL,&a,
+								   NULL));
 
-	/* our antichain is U - C */
 	res = malloc(sizeof(igraph_vector_t));
 	GGEN_CHECK_ALLOC(res);
-	GGEN_FINALLY3(free,res,1);
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init_seq(res,0,vg-1));
-	GGEN_FINALLY3(igraph_vector_destroy,res,1);
-
-	GGEN_CHECK_INTERNAL(vector_diff(res,&c));
+	*res = a;
 
 	ggen_error_clean(1);
 	return res;
@@ -373,214 +471,455 @@ ggen_error_label:
  * (lowest common ancestor of two nodes) queries on it.
  * See "New Common Ancestor Problems in Trees and Directed Acyclic Graphs" by
  * Johannes Fischer and Daniel H. Huson (2008).
- * While this paper recommends the use of a LCA algorithm that supports online
- * updates to the tree, it is quite difficult to implement correctly. The LCA
- * algorithm we use is with O(n) prepocessing time and O(1) queries, making the
- * LSA algorithm O(n^2).
+ * As this paper recommends, the LCA algorithm supports online updates to the
+ * tree: vertices are added in topological order, as a child of the LCA of
+ * their parents. Adding a vertex is O(1) and each query O(log n), making the
+ * LSA algorithm O((V+E) log V).
  */
 
 igraph_vector_t *ggen_analyze_lowest_single_ancestor(igraph_t *g)
 {
-	unsigned long i,v,l,m,vid,r;
-	int err = 0;
-	igraph_vector_t toposort,itopo;
 	igraph_vector_t *lsa;
-	igraph_t tree;
-	igraph_vs_t vs;
-	igraph_vit_t vit;
-	lca_metadata md;
+	int32_t *order,v,l;
+	int64_t i,j;
+	csr_t c;
+	lca_tree tree;
 
 	ggen_error_start_stack();
 	if(g == NULL)
 		GGEN_SET_ERRNO(GGEN_EINVAL);
 
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&toposort,igraph_vcount(g)));
-	GGEN_FINALLY(igraph_vector_destroy,&toposort);
+	GGEN_CHECK_INTERNAL_ERRNO(csr_init(&c,g));
+	GGEN_FINALLY(csr_free,&c);
 
-	GGEN_CHECK_IGRAPH(igraph_topological_sorting(g,&toposort,IGRAPH_OUT));
+	order = malloc((c.vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(order);
+	GGEN_FINALLY(free,order);
+	GGEN_CHECK_INTERNAL_ERRNO(csr_topological_order(&c,order));
 
-	/* build a reverse index of the toposort */
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&itopo,igraph_vcount(g)));
-	GGEN_FINALLY(igraph_vector_destroy,&itopo);
-
-	for(i = 0; i < igraph_vcount(g); i++)
-	{
-		v = VECTOR(toposort)[i];
-		VECTOR(itopo)[v] = i;
-	}
+	/* only the first vertex can be a source */
+	for(i = 1; i < c.vcount; i++)
+		if(CSR_IN_DEGREE(&c,order[i]) == 0)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
 
-	GGEN_CHECK_IGRAPH(igraph_empty(&tree,1,IGRAPH_DIRECTED));
-	GGEN_FINALLY(igraph_destroy,&tree);
+	GGEN_CHECK_INTERNAL_ERRNO(tree_lca_init(&tree,c.vcount));
+	GGEN_FINALLY(tree_lca_free,&tree);
 
-	lsa = calloc(1,sizeof(igraph_vector_t*));
+	lsa = calloc(1,sizeof(igraph_vector_t));
 	GGEN_CHECK_ALLOC(lsa);
 	GGEN_FINALLY3(free,lsa,1);
 
-	GGEN_CHECK_IGRAPH(igraph_vector_init(lsa,igraph_vcount(g)));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(lsa,c.vcount));
 	GGEN_FINALLY3(igraph_vector_destroy,lsa,1);
 
 	/* lsa of single source is single source */
-	v = VECTOR(toposort)[0];
-	VECTOR(*lsa)[v] = v;
-	for(v = 1; v < igraph_vcount(g); v++)
+	if(c.vcount > 0)
 	{
-		vid = VECTOR(toposort)[v];
-
-		GGEN_CHECK_INTERNAL_ERRNO(tree_lca_metadata_init(&tree,&md));
-		GGEN_FINALLY(tree_lca_metadata_free,&md);
-		GGEN_CHECK_INTERNAL_ERRNO(tree_lca_preprocessing(&tree,0,&md));
+		tree_lca_add_root(&tree,order[0]);
+		VECTOR(*lsa)[order[0]] = order[0];
+	}
+	for(i = 1; i < c.vcount; i++)
+	{
+		v = order[i];
 
 		/* iterate over parents of v in g
 		 * The lsa of a node is the LCA of all its parents in our
 		 * special tree.
 		 */
-		GGEN_CHECK_IGRAPH(igraph_vs_adj(&vs, vid, IGRAPH_IN));
-		GGEN_FINALLY(igraph_vs_destroy,&vs);
-		GGEN_CHECK_IGRAPH(igraph_vit_create(g,vs,&vit));
-		GGEN_FINALLY(igraph_vit_destroy,&vit);
+		j = c.in_offsets[v];
+		l = c.in_sources[j];
+		for(j++; j < c.in_offsets[v+1]; j++)
+			l = tree_lca_query(&tree,l,c.in_sources[j]);
 
-		l = VECTOR(itopo)[IGRAPH_VIT_GET(vit)];
-		IGRAPH_VIT_NEXT(vit);
+		tree_lca_add_leaf(&tree,v,l);
+		VECTOR(*lsa)[v] = l;
+	}
+	ggen_error_clean(1);
+	return lsa;
+ggen_error_label:
+	return NULL;
+}
 
-		for(vit;!IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit))
+/* Edge-disjoint paths covering all the edges of a DAG.
+ * Returns a vector, listing for each edge id the index of its path.
+ *
+ * Both methods work on a snapshot of the graph, the edges already in a path
+ * being the residual graph: the input graph is never modified.
+ *
+ * The shortest method is the historical approximation: while edges are left,
+ * take the residual source of lowest id and peel the shortest path from it to
+ * the reachable residual sink of lowest id. Each path costs a bfs, O(V+E).
+ *
+ * The minimum method peels paths in topological order, each vertex following
+ * a cursor on its out edges: a path goes on as long as the last vertex has an
+ * unused edge. As all the edges reaching a vertex are used before its turn,
+ * the paths starting there are the ones its in edges cannot continue: there
+ * are sum(max(0, out(v) - in(v))) of them, the minimum, which is also what a
+ * maximum matching between the in and out edges of each vertex would give.
+ * The whole decomposition is O(V+E).
+ */
+static int paths_shortest(const csr_t *c, igraph_vector_t *paths,
+			  unsigned long *count)
+{
+	int64_t *in,*out,j,remaining;
+	int32_t *queue,*parent,*pedge,v,u,s,t,head,tail;
+	char *used;
+	unsigned long nbpaths = 0;
+
+	ggen_error_start_stack();
+	in = malloc((c->vcount+1)*sizeof(int64_t));
+	GGEN_CHECK_ALLOC(in);
+	GGEN_FINALLY(free,in);
+	out = malloc((c->vcount+1)*sizeof(int64_t));
+	GGEN_CHECK_ALLOC(out);
+	GGEN_FINALLY(free,out);
+	queue = malloc((c->vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(queue);
+	GGEN_FINALLY(free,queue);
+	parent = malloc((c->vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(parent);
+	GGEN_FINALLY(free,parent);
+	pedge = malloc((c->vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(pedge);
+	GGEN_FINALLY(free,pedge);
+	used = calloc(c->ecount+1,sizeof(char));
+	GGEN_CHECK_ALLOC(used);
+	GGEN_FINALLY(free,used);
+
+	/* residual degrees */
+	for(v = 0; v < c->vcount; v++)
+	{
+		in[v] = CSR_IN_DEGREE(c,v);
+		out[v] = CSR_OUT_DEGREE(c,v);
+	}
+
+	remaining = c->ecount;
+	while(remaining)
+	{
+		/* find a source in the graph */
+		for(s = 0; s < c->vcount; s++)
+			if(in[s] == 0 && out[s] != 0)
+				break;
+		if(s == c->vcount)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+
+		/* build the shortest paths to all vertices, along the
+		 * residual edges, in the order igraph would */
+		for(v = 0; v < c->vcount; v++)
+			parent[v] = -1;
+		parent[s] = s;
+		queue[0] = s;
+		for(head = 0, tail = 1; head < tail; head++)
 		{
-			m = VECTOR(itopo)[IGRAPH_VIT_GET(vit)];
-			GGEN_CHECK_INTERNAL_ERRNO(tree_lca_query(&tree,l,m,&r,&md));
-			l = r;
+			v = queue[head];
+			for(j = c->out_offsets[v]; j < c->out_offsets[v+1]; j++)
+			{
+				u = c->out_targets[j];
+				if(!used[c->out_eids[j]] && parent[u] == -1)
+				{
+					parent[u] = v;
+					pedge[u] = c->out_eids[j];
+					queue[tail++] = u;
+				}
+			}
 		}
 
-		// destroy metadata, vs and vit
-		ggen_error_pop(3);
+		/* find a sink that has a path from source */
+		for(t = 0; t < c->vcount; t++)
+			if(out[t] == 0 && in[t] != 0 && parent[t] != -1)
+				break;
+		if(t == c->vcount)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
 
-		// update tree
-		GGEN_CHECK_IGRAPH(igraph_add_vertices(&tree,1,NULL));
+		/* remove the edges of the path from the residual graph */
+		for(v = t; v != s; v = parent[v])
+		{
+			used[pedge[v]] = 1;
+			VECTOR(*paths)[pedge[v]] = nbpaths;
+			out[parent[v]]--;
+			in[v]--;
+			remaining--;
+		}
+		nbpaths++;
+	}
+	*count = nbpaths;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
 
-		// v is the id of vid in tree
-		GGEN_CHECK_IGRAPH(igraph_add_edge(&tree,l,v));
+static int paths_minimum(const csr_t *c, igraph_vector_t *paths,
+			 unsigned long *count)
+{
+	int64_t *cursor,j;
+	int32_t *order,i,v,u;
+	unsigned long nbpaths = 0;
 
-		VECTOR(*lsa)[vid] = VECTOR(toposort)[l];
+	ggen_error_start_stack();
+	order = malloc((c->vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(order);
+	GGEN_FINALLY(free,order);
+	GGEN_CHECK_INTERNAL_ERRNO(csr_topological_order(c,order));
+
+	/* the next unused out edge of each vertex */
+	cursor = malloc((c->vcount+1)*sizeof(int64_t));
+	GGEN_CHECK_ALLOC(cursor);
+	GGEN_FINALLY(free,cursor);
+	for(v = 0; v < c->vcount; v++)
+		cursor[v] = c->out_offsets[v];
+
+	for(i = 0; i < c->vcount; i++)
+	{
+		v = order[i];
+		while(cursor[v] < c->out_offsets[v+1])
+		{
+			for(u = v; cursor[u] < c->out_offsets[u+1];
+			    u = c->out_targets[j])
+			{
+				j = cursor[u]++;
+				VECTOR(*paths)[c->out_eids[j]] = nbpaths;
+			}
+			nbpaths++;
+		}
 	}
+	*count = nbpaths;
 	ggen_error_clean(1);
-	return lsa;
+	return GGEN_SUCCESS;
 ggen_error_label:
-	return NULL;
+	return GGEN_FAILURE;
+}
+
+int ggen_analyze_path_decomposition(igraph_t *g, enum ggen_paths_t method,
+				    igraph_vector_t *paths,
+				    unsigned long *count)
+{
+	unsigned long nbpaths;
+	csr_t c;
+
+	ggen_error_start_stack();
+	if(g == NULL || paths == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	if(method != GGEN_PATHS_SHORTEST && method != GGEN_PATHS_MINIMUM)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_INTERNAL_ERRNO(csr_init(&c,g));
+	GGEN_FINALLY(csr_free,&c);
+	GGEN_CHECK_IGRAPH(igraph_vector_resize(paths,c.ecount));
+
+	if(method == GGEN_PATHS_SHORTEST)
+		GGEN_CHECK_INTERNAL_ERRNO(paths_shortest(&c,paths,&nbpaths));
+	else
+		GGEN_CHECK_INTERNAL_ERRNO(paths_minimum(&c,paths,&nbpaths));
+	if(count != NULL)
+		*count = nbpaths;
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
 }
 
 /* An approximation algorithm to list edge-disjoint paths in the graph.
  * Note that:
  * - this is a NP-Complete problem, so this algorithm is an approximation
  * - we make no guaranties on the quality of this algorithm.
- * Returns a vector, listing for each edge id the index of its path.
- *
- * The algorithm simply find a path in the graph, and removes it until no edges
- * are left. We operate on a deep copy, the input graph is not destroyed by the
- * analysis.
+ * This is the shortest method of the decomposition above.
  */
 igraph_vector_t * ggen_analyze_edge_disjoint_paths(igraph_t *g)
 {
-	igraph_vector_t *paths = NULL, *p;
-	igraph_vector_t indegrees, outdegrees;
-	igraph_es_t es;
-	igraph_t copy;
-	igraph_integer_t eid, from, to;
-	igraph_vector_ptr_t edges;
-	igraph_warning_handler_t *handler;
-	unsigned long vcount, ecount, source, sink, nbpaths, i;
-	int err = 0;
+	igraph_vector_t p,*paths = NULL;
 
 	ggen_error_start_stack();
 	if(g == NULL)
 		GGEN_SET_ERRNO(GGEN_EINVAL);
 
-	GGEN_CHECK_IGRAPH(igraph_copy(&copy,g));
-	GGEN_FINALLY(igraph_destroy,&copy);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&p,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&p,1);
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_analyze_path_decomposition(g,
+					GGEN_PATHS_SHORTEST,&p,NULL));
 
-	paths = calloc(1,sizeof(igraph_vector_t));
+	paths = malloc(sizeof(igraph_vector_t));
 	GGEN_CHECK_ALLOC(paths);
-	GGEN_FINALLY3(free,paths,1);
+	*paths = p;
 
-	vcount = igraph_vcount(&copy);
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&indegrees,vcount));
-	GGEN_FINALLY(igraph_vector_destroy,&indegrees);
+	ggen_error_clean(1);
+	return paths;
+ggen_error_label:
+	return NULL;
+}
 
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&outdegrees,vcount));
-	GGEN_FINALLY(igraph_vector_destroy,&outdegrees);
 
-	ecount = igraph_ecount(&copy);
+/* Summary: one snapshot and one topological order for all the metrics.
+ * Counts, degrees and ends are read from the offsets of the snapshot, depth
+ * and levels come from one sweep in topological order, and the width and the
+ * transitive edges share the reachability rows.
+ */
 
-	GGEN_CHECK_IGRAPH(igraph_vector_init(paths,ecount));
-	GGEN_FINALLY3(igraph_vector_destroy,paths,1);
+/* an edge (u,v) is transitive if v is reached from another successor of u:
+ * the union of the rows of the successors of u has the bit of v set, as v
+ * cannot reach itself.
+ */
+static int transitive_edges(const csr_t *c, const reach_t *r,
+			    unsigned long *count)
+{
+	uint64_t *acc,*row;
+	int32_t u,v;
+	int64_t j;
+	size_t k;
 
-	GGEN_CHECK_IGRAPH(igraph_vector_ptr_init(&edges, vcount));
-	IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&edges, igraph_vector_destroy);
-	GGEN_FINALLY(igraph_vector_ptr_destroy_all,&edges);
+	ggen_error_start_stack();
+	acc = malloc((r->words+1)*sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(acc);
+	GGEN_FINALLY(free,acc);
 
-	for(i = 0; i < vcount; i++)
+	*count = 0;
+	for(u = 0; u < c->vcount; u++)
 	{
-		VECTOR(edges)[i] = calloc(1,sizeof(igraph_vector_t));
-		GGEN_CHECK_ALLOC(VECTOR(edges)[i]);
-		GGEN_CHECK_IGRAPH_VECTPTR(igraph_vector_init(VECTOR(edges)[i],0),edges,i);
+		if(CSR_OUT_DEGREE(c,u) < 2)
+			continue;
+		for(k = 0; k < r->words; k++)
+			acc[k] = 0;
+		for(j = c->out_offsets[u]; j < c->out_offsets[u+1]; j++)
+		{
+			row = REACH_ROW(r,c->out_targets[j]);
+			for(k = 0; k < r->words; k++)
+				acc[k] |= row[k];
+		}
+		for(j = c->out_offsets[u]; j < c->out_offsets[u+1]; j++)
+		{
+			v = c->out_targets[j];
+			if((acc[v/64] >> (v%64)) & 1)
+				(*count)++;
+		}
 	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
 
-	nbpaths = 0;
-	while(ecount)
+/* add one to the bucket i of the histogram h */
+static int histogram_add(igraph_vector_t *h, unsigned long i)
+{
+	long size = igraph_vector_size(h);
+
+	if(i >= (unsigned long)size)
 	{
-		/* list vertex degrees */
-		igraph_degree(&copy, &indegrees, igraph_vss_all(), IGRAPH_IN,0);
-		igraph_degree(&copy, &outdegrees, igraph_vss_all(), IGRAPH_OUT,0);
+		if(igraph_vector_resize(h,i+1))
+			return GGEN_FAILURE;
+		for(; size <= (long)i; size++)
+			VECTOR(*h)[size] = 0;
+	}
+	VECTOR(*h)[i]++;
+	return GGEN_SUCCESS;
+}
 
-		/* find a source in the graph */
-		for(i = 0; i < vcount; i++)
+int ggen_analyze_summary(igraph_t *g, unsigned int metrics,
+			 const char *vweight, const char *eweight,
+			 struct ggen_summary *s)
+{
+	int32_t *order,*level,v;
+	int64_t i,j,in,out;
+	unsigned long count;
+	csr_t csr;
+	reach_t reach;
+
+	ggen_error_start_stack();
+	if(g == NULL || s == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	if(metrics & ~GGEN_SUMMARY_ALL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	memset(s,0,sizeof(struct ggen_summary));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&s->in_degrees,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&s->in_degrees,1);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&s->out_degrees,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&s->out_degrees,1);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&s->levels,0));
+	GGEN_FINALLY3(igraph_vector_destroy,&s->levels,1);
+
+	GGEN_CHECK_INTERNAL_ERRNO(csr_init(&csr,g));
+	GGEN_FINALLY(csr_free,&csr);
+	order = malloc((csr.vcount+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(order);
+	GGEN_FINALLY(free,order);
+	GGEN_CHECK_INTERNAL_ERRNO(csr_topological_order(&csr,order));
+
+	/* counts, degrees and ends */
+	if(metrics & GGEN_SUMMARY_COUNTS)
+	{
+		s->vertices = csr.vcount;
+		s->edges = csr.ecount;
+	}
+	for(v = 0; v < csr.vcount; v++)
+	{
+		in = CSR_IN_DEGREE(&csr,v);
+		out = CSR_OUT_DEGREE(&csr,v);
+		if(metrics & GGEN_SUMMARY_DEGREES)
 		{
-			if(VECTOR(indegrees)[i] == 0 && VECTOR(outdegrees)[i] != 0)
-				break;
+			GGEN_CHECK_INTERNAL(histogram_add(&s->in_degrees,in));
+			GGEN_CHECK_INTERNAL(histogram_add(&s->out_degrees,out));
 		}
-		if(i == vcount)
-			GGEN_SET_ERRNO(GGEN_EINVAL); /* error ! */
-		source = i;
-
-		/* build the shortest paths to all vertices */
-		/* igrore warnings, we know some of the vertices don't have
-		 * paths from source
-		 */
-		handler = igraph_set_warning_handler(igraph_warning_handler_ignore);
-		igraph_get_shortest_paths(&copy, NULL, &edges, source,
-					igraph_vss_all(), IGRAPH_OUT, NULL, NULL);
-		igraph_set_warning_handler(handler);
+		if(metrics & GGEN_SUMMARY_ENDS)
+		{
+			s->sources += in == 0;
+			s->sinks += out == 0;
+		}
+	}
 
-		/* find a sink that has a path from source */
-		for(i = 0; i < vcount; i++)
+	/* levels, in topological order */
+	if(metrics & (GGEN_SUMMARY_DEPTH | GGEN_SUMMARY_LEVELS))
+	{
+		level = calloc(csr.vcount+1,sizeof(int32_t));
+		GGEN_CHECK_ALLOC(level);
+		GGEN_FINALLY(free,level);
+		for(i = 0; i < csr.vcount; i++)
 		{
-			if(VECTOR(outdegrees)[i] == 0 && VECTOR(indegrees)[i] != 0)
-			{
-				/* check that this sink is connected to source
-				 */
-				if(igraph_vector_size(VECTOR(edges)[i]) != 0)
-					break;
-			}
+			v = order[i];
+			for(j = csr.in_offsets[v]; j < csr.in_offsets[v+1]; j++)
+				if(level[csr.in_sources[j]] + 1 > level[v])
+					level[v] = level[csr.in_sources[j]] + 1;
+			if(metrics & GGEN_SUMMARY_DEPTH &&
+			   (unsigned long)level[v] + 1 > s->depth)
+				s->depth = level[v] + 1;
+			if(metrics & GGEN_SUMMARY_LEVELS)
+				GGEN_CHECK_INTERNAL(histogram_add(&s->levels,
+								  level[v]));
 		}
-		if(i == vcount)
-			GGEN_SET_ERRNO(GGEN_EINVAL); /* error */
-		sink = i;
+	}
 
-		/* remove the edges we just found from the graph, but before,
-		 * save the path in the result vector
-		 */
-		p = VECTOR(edges)[sink];
-		for(i = 0; i < igraph_vector_size(p); i++)
+	if(metrics & GGEN_SUMMARY_CRITICAL_PATH)
+		GGEN_CHECK_INTERNAL_ERRNO(critical_path(g,&csr,order,vweight,
+					eweight,NULL,NULL,NULL,NULL,
+					&s->critical_path));
+
+	/* width and transitive edges, on the same reachability */
+	if(metrics & (GGEN_SUMMARY_WIDTH | GGEN_SUMMARY_TRANSITIVE))
+	{
+		GGEN_CHECK_INTERNAL_ERRNO(reach_init(&reach,&csr,order));
+		GGEN_FINALLY(reach_free,&reach);
+		if(metrics & GGEN_SUMMARY_WIDTH)
+			GGEN_CHECK_INTERNAL_ERRNO(dilworth(&csr,&reach,NULL,
+							   NULL,&s->width));
+		if(metrics & GGEN_SUMMARY_TRANSITIVE)
 		{
-			igraph_edge(&copy,VECTOR(*p)[i],&from,&to);
-			GGEN_CHECK_IGRAPH(igraph_get_eid(g, &eid, from, to, 1, 0));
-			VECTOR(*paths)[eid] = nbpaths;
+			GGEN_CHECK_INTERNAL(transitive_edges(&csr,&reach,
+							     &count));
+			if(csr.ecount > 0)
+				s->transitive = (double)count/csr.ecount;
 		}
-		GGEN_CHECK_IGRAPH(igraph_es_vector(&es,p));
-		GGEN_CHECK_IGRAPH(igraph_delete_edges(&copy, es));
-		ecount = igraph_ecount(&copy);
-		nbpaths++;
 	}
+
 	ggen_error_clean(1);
-	return paths;
+	return GGEN_SUCCESS;
 ggen_error_label:
-	return NULL;
+	return GGEN_FAILURE;
 }
 
+void ggen_summary_destroy(struct ggen_summary *s)
+{
+	igraph_vector_destroy(&s->in_degrees);
+	igraph_vector_destroy(&s->out_degrees);
+	igraph_vector_destroy(&s->levels);
+}
@@ -43,133 +43,142 @@
 
 #include "ggen.h"
 #include "error.h"
+#include "dataflow-trace.h"
+#include "graph-family.h"
 
 /**********************************************************
  * Utils
  *********************************************************/
 
-/* A lot of our algorithms rely on adding a single task and figuring out
- * the dependencies it has because it's reading data that might have been wrote
- * before.
- * To manage that, we use a long vector remembering the last task that wrote into
- * a region of memory. If that vector contains a valid task id, then we add an
- * edge from that last task to the new one.
- * TODO: error checks
+/* All our algorithms are traced: each task is declared along with the blocks
+ * it reads and writes, and the tracer figures out the dependencies it has
+ * because it's reading or writing data that might have been accessed before.
+ * See dataflow-trace.h.
+ *
+ * Each algorithm either builds an igraph (g) or streams its tasks to a sink
+ * (s), the other one being NULL. When streaming, memory only depends on the
+ * number of blocks.
  */
-
-static inline unsigned long addtask(igraph_t *g)
-{
-	unsigned long curtask = igraph_vcount(g);
-	igraph_add_vertices(g, 1, NULL);
-	return curtask;
-}
-
-static inline void raw_edge_1d(igraph_vector_long_t *lastwrite,
-			       unsigned long i, igraph_t *g,
-			       unsigned long task)
+static int trace_begin(struct dataflow_trace *t, struct ggen_edge_sink *s)
 {
-	long todo = VECTOR(*lastwrite)[i];
-	unsigned long from;
-	igraph_integer_t eid;
-	if(todo != -1)
-	{
-		from = VECTOR(*lastwrite)[i];
-		igraph_add_edge(g, from, task);
-		igraph_get_eid(g, &eid, from, task, 1,0);
-		SETEAN(g, "x", eid, i);
-	}
-
+	int err = GGEN_SUCCESS;
+	if(s == NULL)
+		return GGEN_SUCCESS;
+	dataflow_trace_stream(t, s);
+	/* the number of tasks is not known in advance */
+	if(s->begin != NULL)
+		err = s->begin(s->data, 0, 0);
+	if(err != GGEN_SUCCESS && ggen_errno.ggen_error == GGEN_SUCCESS)
+		ggen_errno.ggen_error = GGEN_FAILURE;
+	return err;
 }
 
-static inline void raw_edge_2d(igraph_matrix_long_t *lastwrite,
-			       unsigned long i, unsigned long j,
-			       igraph_t *g, unsigned long task)
+static int trace_end(struct dataflow_trace *t, igraph_t *g,
+		     struct ggen_edge_sink *s)
 {
-	long todo = MATRIX(*lastwrite,i,j);
-	unsigned long from;
-	igraph_integer_t eid;
-	if(todo != -1)
-	{
-		from = MATRIX(*lastwrite,i,j);
-		igraph_add_edge(g, from, task);
-		igraph_get_eid(g, &eid, from, task, 1,0);
-		SETEAN(g, "x", eid, i);
-		SETEAN(g, "y", eid, j);
-	}
+	int err = GGEN_SUCCESS;
+	if(s == NULL)
+		return dataflow_trace_graph(t, g);
+	if(dataflow_trace_check(t))
+		return GGEN_FAILURE;
+	if(s->end != NULL)
+		err = s->end(s->data);
+	if(err != GGEN_SUCCESS && ggen_errno.ggen_error == GGEN_SUCCESS)
+		ggen_errno.ggen_error = GGEN_FAILURE;
+	return err;
 }
 
 /**********************************************************
  * Methods
  *********************************************************/
 
+/* The factorizations never write a block after reading it, there's no write
+ * after read to track: it also means the tracer does not need to remember
+ * readers.
+ */
+#define FACTORIZATION_HAZARDS (DATAFLOW_RAW|DATAFLOW_WAW)
+
+enum { POTRF, TRSM, SYRK, GEMM };
+static const struct dataflow_kernel cholesky_kernels[] = {
+	{ "potrf", 1, {{0, DATAFLOW_INOUT}} },
+	{ "trsm", 2, {{0, DATAFLOW_IN}, {0, DATAFLOW_INOUT}} },
+	{ "syrk", 2, {{0, DATAFLOW_IN}, {0, DATAFLOW_INOUT}} },
+	{ "gemm", 3, {{0, DATAFLOW_IN}, {0, DATAFLOW_IN}, {0, DATAFLOW_INOUT}} },
+};
+
 /* Block Cholesky factorization, lifted for KaStORS/Plasma code.
  * Matrix is of size n*n blocks.
  */
-igraph_t *ggen_generate_cholesky(unsigned long size)
+static int cholesky(igraph_t *g, struct ggen_edge_sink *s, unsigned long size)
 {
-	igraph_t *g = NULL;
-	igraph_matrix_long_t lastwrite;
-	unsigned long k, m, n, task;
+	struct dataflow_trace t;
+	unsigned long k, m, n;
+	unsigned long shape[2] = { size, size };
 
 	ggen_error_start_stack();
 
-	g = malloc(sizeof(igraph_t));
-	GGEN_CHECK_ALLOC(g);
-	GGEN_FINALLY3(free,g,1);
-
-	GGEN_CHECK_IGRAPH(igraph_empty(g,0,1));
-	GGEN_FINALLY3(igraph_destroy,g,1);
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_init(&t, cholesky_kernels,
+			DATAFLOW_NKERNELS(cholesky_kernels),
+			FACTORIZATION_HAZARDS));
+	GGEN_FINALLY(dataflow_trace_destroy, &t);
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_data(&t, 2, shape));
+	GGEN_CHECK_INTERNAL_ERRNO(trace_begin(&t, s));
 
-	GGEN_CHECK_IGRAPH(igraph_matrix_long_init(&lastwrite, size, size));
-	GGEN_FINALLY(igraph_matrix_destroy, &lastwrite);
-	igraph_matrix_long_fill(&lastwrite, -1);
-
-	/* There's a single matrix using inout, use lastwrite to create the right
-	 * edges.
-	 */
+	/* There's a single matrix, every kernel updating one of its blocks. */
 	for(k = 0; k < size; k++)
 	{
 		/* potrf inout [k,k]*/
-		task = addtask(g);
-		SETVAS(g, "kernel", task, "potrf");
-		raw_edge_2d(&lastwrite, k, k, g, task);
-		MATRIX(lastwrite, k, k) = task;
+		dataflow_trace_task(&t, POTRF, (unsigned long[]){k,k});
 
 		for(m = k+1; m < size; m++)
-		{
 			/* trsm: in [k,k] inout [k,m] */
-			task = addtask(g);
-			SETVAS(g, "kernel", task, "trsm");
-			raw_edge_2d(&lastwrite, k, k, g, task);
-			raw_edge_2d(&lastwrite, k, m, g, task);
-			MATRIX(lastwrite, k, m) = task;
-		}
+			dataflow_trace_task(&t, TRSM,
+					    (unsigned long[]){k,k, k,m});
 		for(m = k+1; m < size; m++)
 		{
 			/* syrk: in [k,m] inout [m,m] */
-			task = addtask(g);
-			SETVAS(g, "kernel", task, "syrk");
-			raw_edge_2d(&lastwrite, k, m, g, task);
-			raw_edge_2d(&lastwrite, m, m, g, task);
-			MATRIX(lastwrite, m, m) = task;
+			dataflow_trace_task(&t, SYRK,
+					    (unsigned long[]){k,m, m,m});
 
 			for(n = k+1; n < m; n++)
-			{
 				/* gemm: in [k,n] in [k,m] inout [n,m] */
-				task = addtask(g);
-				SETVAS(g, "kernel", task, "gemm");
-				raw_edge_2d(&lastwrite, k, n, g, task);
-				raw_edge_2d(&lastwrite, k, m, g, task);
-				raw_edge_2d(&lastwrite, n, m, g, task);
-				MATRIX(lastwrite, n, m) = task;
-			}
+				dataflow_trace_task(&t, GEMM,
+					(unsigned long[]){k,n, k,m, n,m});
 		}
 	}
+	GGEN_CHECK_INTERNAL_ERRNO(trace_end(&t, g, s));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+igraph_t *ggen_generate_cholesky(unsigned long size)
+{
+	igraph_t *g = NULL;
+
+	ggen_error_start_stack();
+	g = malloc(sizeof(igraph_t));
+	GGEN_CHECK_ALLOC(g);
+	GGEN_FINALLY3(free,g,1);
+
+	GGEN_CHECK_INTERNAL_ERRNO(cholesky(g, NULL, size));
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
 	return NULL;
+}
 
+int ggen_stream_cholesky(unsigned long size, struct ggen_edge_sink *s)
+{
+	ggen_error_start_stack();
+	if(s == NULL || s->edge == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	GGEN_CHECK_INTERNAL_ERRNO(cholesky(NULL, s, size));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
 }
 
 /* lifted from the KaStORS/BCS OpenMP task suite */
@@ -196,54 +205,62 @@ static int sparselu_genmat(igraph_matrix_bool_t *matrix, unsigned long size)
 	return 0;
 }
 
+enum { LU, FWD, BDIV, BMOD };
+static const struct dataflow_kernel lu_kernels[] = {
+	{ "lu", 1, {{0, DATAFLOW_INOUT}} },
+	{ "fwd", 2, {{0, DATAFLOW_IN}, {0, DATAFLOW_INOUT}} },
+	{ "bdiv", 2, {{0, DATAFLOW_IN}, {0, DATAFLOW_INOUT}} },
+	{ "bmod", 3, {{0, DATAFLOW_IN}, {0, DATAFLOW_IN}, {0, DATAFLOW_INOUT}} },
+};
+
 /* LU: generate the graph from a LU decomposition of a possibly sparse matrix of
  * size size*size BLOCKS.
  */
-static int generate_lu(igraph_t *g, unsigned long size, igraph_matrix_bool_t nonempty)
+static int lu(igraph_t *g, struct ggen_edge_sink *s, unsigned long size,
+	      int sparse)
 {
-	igraph_matrix_long_t lastwrite;
-	unsigned long ii, jj, kk, to, from, task, lastlu;
+	igraph_matrix_bool_t nonempty;
+	struct dataflow_trace t;
+	unsigned long ii, jj, kk;
+	unsigned long shape[2] = { size, size };
 
 	ggen_error_start_stack();
 
-	GGEN_CHECK_IGRAPH(igraph_empty(g,0,1));
-	GGEN_FINALLY3(igraph_destroy,g,1);
-	GGEN_CHECK_IGRAPH(igraph_matrix_long_init(&lastwrite, size, size));
-	GGEN_FINALLY(igraph_matrix_destroy, &lastwrite);
-	igraph_matrix_long_fill(&lastwrite, -1);
+	GGEN_CHECK_IGRAPH(igraph_matrix_bool_init(&nonempty, size, size));
+	GGEN_FINALLY(igraph_matrix_bool_destroy, &nonempty);
+
+	/* start by figuring out which part of the matrix contains elements
+	 */
+	if(sparse)
+		sparselu_genmat(&nonempty, size);
+	else
+		igraph_matrix_bool_fill(&nonempty, 1);
+
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_init(&t, lu_kernels,
+			DATAFLOW_NKERNELS(lu_kernels), FACTORIZATION_HAZARDS));
+	GGEN_FINALLY(dataflow_trace_destroy, &t);
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_data(&t, 2, shape));
+	GGEN_CHECK_INTERNAL_ERRNO(trace_begin(&t, s));
 
 	/* run through the motions of the algorithm, creating tasks
-	 * and checking last writers.
+	 * and letting the tracer find their dependencies.
 	 */
 	for(kk = 0; kk < size; kk++)
 	{
 		/* lu task: inout [kk*size +kk]*/
-		lastlu = addtask(g);
-		SETVAS(g, "kernel", lastlu, "lu");
-		raw_edge_2d(&lastwrite, kk, kk, g, lastlu);
-		MATRIX(lastwrite, kk, kk) = lastlu;
+		dataflow_trace_task(&t, LU, (unsigned long[]){kk,kk});
 
 		for(jj = kk+1; jj < size; jj++)
 			if(MATRIX(nonempty, kk, jj))
-			{
 				/* fwd: in [kk*size + kk] inout [kk*size+jj] */
-				task = addtask(g);
-				SETVAS(g, "kernel", task, "fwd");
-				raw_edge_2d(&lastwrite, kk, kk, g, task);
-				raw_edge_2d(&lastwrite, kk, jj, g, task);
-				MATRIX(lastwrite, kk, jj) = task;
-			}
+				dataflow_trace_task(&t, FWD,
+					(unsigned long[]){kk,kk, kk,jj});
 		for(ii = kk+1; ii < size; ii++)
 			if(MATRIX(nonempty, ii, kk))
-			{
 				/* bdiv: in [kk*size +kk] inout: [ii*size +kk]
 				 */
-				task = addtask(g);
-				SETVAS(g, "kernel", task, "bdiv");
-				raw_edge_2d(&lastwrite, kk, kk, g, task);
-				raw_edge_2d(&lastwrite, ii, kk, g, task);
-				MATRIX(lastwrite, ii, kk) = task;
-			}
+				dataflow_trace_task(&t, BDIV,
+					(unsigned long[]){kk,kk, ii,kk});
 		for(ii = kk+1; ii < size; ii++)
 			if(MATRIX(nonempty, ii, kk))
 				for(jj = kk+1; jj < size; jj++)
@@ -254,137 +271,287 @@ static int generate_lu(igraph_t *g, unsigned long size, igraph_matrix_bool_t non
 						 *       inout [ii*size +jj]
 						 */
 						MATRIX(nonempty, ii, jj) = 1;
-						task = addtask(g);
-						SETVAS(g, "kernel", task, "bmod");
-
-						/* this is the last fwd */
-						raw_edge_2d(&lastwrite, ii, kk, g, task);
-
-						/* this is the last bdiv */
-						raw_edge_2d(&lastwrite, kk, jj, g, task);
-
-						raw_edge_2d(&lastwrite, ii, jj, g, task);
-						MATRIX(lastwrite, ii, jj) = task;
+						dataflow_trace_task(&t, BMOD,
+							(unsigned long[]){ii,kk,
+							kk,jj, ii,jj});
 					}
 	}
+	GGEN_CHECK_INTERNAL_ERRNO(trace_end(&t, g, s));
 	ggen_error_clean(1);
 	return GGEN_SUCCESS;
 ggen_error_label:
 	return GGEN_FAILURE;
-
 }
 
-/* SparseLU: generate the graph from a LU decomposition of a sparse matrix of
- * size size*size BLOCKS.
- */
-igraph_t *ggen_generate_sparselu(unsigned long size)
+static igraph_t *generate_lu(unsigned long size, int sparse)
 {
-	igraph_matrix_bool_t nonempty;
-	igraph_t *g;
+	igraph_t *g = NULL;
 
 	ggen_error_start_stack();
 	g = malloc(sizeof(igraph_t));
 	GGEN_CHECK_ALLOC(g);
 	GGEN_FINALLY3(free,g,1);
 
-	GGEN_CHECK_IGRAPH(igraph_matrix_bool_init(&nonempty, size, size));
-	GGEN_FINALLY(igraph_matrix_destroy, &nonempty);
-
-	/* start by figuring out which part of the matrix contains elements
-	 */
-	sparselu_genmat(&nonempty, size);
-
-	GGEN_CHECK_INTERNAL(generate_lu(g, size, nonempty));
+	GGEN_CHECK_INTERNAL_ERRNO(lu(g, NULL, size, sparse));
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
 	return NULL;
 }
 
-/* DenseLU: generate the graph from a LU decomposition of a dense matrix of
+static int stream_lu(unsigned long size, int sparse, struct ggen_edge_sink *s)
+{
+	ggen_error_start_stack();
+	if(s == NULL || s->edge == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	GGEN_CHECK_INTERNAL_ERRNO(lu(NULL, s, size, sparse));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* SparseLU: generate the graph from a LU decomposition of a sparse matrix of
  * size size*size BLOCKS.
  */
-igraph_t *ggen_generate_denselu(unsigned long size)
+igraph_t *ggen_generate_sparselu(unsigned long size)
 {
-	igraph_matrix_bool_t nonempty;
-	igraph_t *g;
-
-	ggen_error_start_stack();
-	g = malloc(sizeof(igraph_t));
-	GGEN_CHECK_ALLOC(g);
-	GGEN_FINALLY3(free,g,1);
+	return generate_lu(size, 1);
+}
 
-	GGEN_CHECK_IGRAPH(igraph_matrix_bool_init(&nonempty, size, size));
-	GGEN_FINALLY(igraph_matrix_destroy, &nonempty);
+int ggen_stream_sparselu(unsigned long size, struct ggen_edge_sink *s)
+{
+	return stream_lu(size, 1, s);
+}
 
-	igraph_matrix_bool_fill(&nonempty, 1);
+/* DenseLU: generate the graph from a LU decomposition of a dense matrix of
+ * size size*size BLOCKS.
+ */
+igraph_t *ggen_generate_denselu(unsigned long size)
+{
+	return generate_lu(size, 0);
+}
 
-	GGEN_CHECK_INTERNAL(generate_lu(g, size, nonempty));
-	ggen_error_clean(1);
-	return g;
-ggen_error_label:
-	return NULL;
+int ggen_stream_denselu(unsigned long size, struct ggen_edge_sink *s)
+{
+	return stream_lu(size, 0, s);
 }
 
+enum { OLD, NEW };
+enum { COPY, APPLY };
+static const struct dataflow_kernel poisson2d_kernels[] = {
+	{ "copy", 2, {{NEW, DATAFLOW_IN}, {OLD, DATAFLOW_OUT}} },
+	{ "apply", 4, {{OLD, DATAFLOW_IN}, {OLD, DATAFLOW_IN}, {OLD, DATAFLOW_IN},
+		{NEW, DATAFLOW_OUT}} },
+};
 
 /* Poisson2D: iterations of a "sweep" across the unit square cut into a grid
  * of n by n evenly-spaced points.
  */
-igraph_t *ggen_generate_poisson2d(unsigned long n, unsigned long iter)
+static int poisson2d(igraph_t *g, struct ggen_edge_sink *s, unsigned long n,
+		     unsigned long iter)
 {
-	igraph_t *g = NULL;
-	igraph_vector_long_t lw_old, lw_new;
-	unsigned long it, i, task, from;
+	struct dataflow_trace t;
+	unsigned long it, i;
 
 	ggen_error_start_stack();
 
-	g = malloc(sizeof(igraph_t));
-	GGEN_CHECK_ALLOC(g);
-	GGEN_FINALLY3(free,g,1);
-
-	GGEN_CHECK_IGRAPH(igraph_empty(g,0,1));
-	GGEN_FINALLY3(igraph_destroy,g,1);
-
 	/* We mimic a sweep across 2 arrays. Each iteration is doing:
 	 * - old[i] = new[i]
 	 * - new[i] = f(old[i-1], old[i], old[i+1])
-	 * To figure out dependencies between tasks, lw_old stores the last
-	 * task that wrote into old, and the same for lw_new/new.
+	 * The two arrays are there so that no task waits for the readers of
+	 * the data it overwrites: only true dependencies are tracked.
 	 * Border cells never change values, so we avoid creating tasks for
 	 * them.
 	 */
-	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&lw_old, n));
-	GGEN_FINALLY(igraph_vector_destroy, &lw_old);
-	igraph_vector_long_fill(&lw_old, -1);
-	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&lw_new, n));
-	GGEN_FINALLY(igraph_vector_destroy, &lw_new);
-	igraph_vector_long_fill(&lw_new, -1);
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_init(&t, poisson2d_kernels,
+			DATAFLOW_NKERNELS(poisson2d_kernels), DATAFLOW_RAW));
+	GGEN_FINALLY(dataflow_trace_destroy, &t);
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_data(&t, 1, &n));
+	GGEN_CHECK_INTERNAL_ERRNO(dataflow_trace_data(&t, 1, &n));
+	GGEN_CHECK_INTERNAL_ERRNO(trace_begin(&t, s));
 
 	for(it = 0; it < iter; it++)
 	{
-		for(i = 1; i < n-1; i++)
-		{
+		for(i = 1; i + 1 < n; i++)
 			/* old[i] = new[i] */
-			task = addtask(g);
-			SETVAS(g, "kernel", task, "copy");
-			raw_edge_1d(&lw_new, i, g, task);
-			VECTOR(lw_old)[i] = task;
-		}
-		for(i = 1; i < n-1; i++)
-		{
+			dataflow_trace_task(&t, COPY, (unsigned long[]){i, i});
+		for(i = 1; i + 1 < n; i++)
 			/* new[i] = f(old[i-1], old[i], old[i+1])
 			 * Note that on the edges, the dependencies are simpler
 			 */
-			task = addtask(g);
-			SETVAS(g, "kernel", task, "apply");
-			raw_edge_1d(&lw_old, i-1, g, task);
-			raw_edge_1d(&lw_old, i  , g, task);
-			raw_edge_1d(&lw_old, i+1, g, task);
-			VECTOR(lw_new)[i] = task;
-		}
+			dataflow_trace_task(&t, APPLY,
+					    (unsigned long[]){i-1, i, i+1, i});
 	}
+	GGEN_CHECK_INTERNAL_ERRNO(trace_end(&t, g, s));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+igraph_t *ggen_generate_poisson2d(unsigned long n, unsigned long iter)
+{
+	igraph_t *g = NULL;
+
+	ggen_error_start_stack();
+	g = malloc(sizeof(igraph_t));
+	GGEN_CHECK_ALLOC(g);
+	GGEN_FINALLY3(free,g,1);
+
+	GGEN_CHECK_INTERNAL_ERRNO(poisson2d(g, NULL, n, iter));
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
 	return NULL;
 }
+
+int ggen_stream_poisson2d(unsigned long n, unsigned long iter,
+			  struct ggen_edge_sink *s)
+{
+	ggen_error_start_stack();
+	if(s == NULL || s->edge == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	GGEN_CHECK_INTERNAL_ERRNO(poisson2d(NULL, s, n, iter));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/**********************************************************
+ * Families
+ *********************************************************/
+
+/* A factorization of size*size blocks: with T = size(size-1)/2, step k works
+ * on r = size-k-1 blocks of a row and of a column, which makes T tasks of each
+ * kind of panel task. updates receives the number of trailing updates, the
+ * sum of r*r (dense) or r(r-1)/2 (cholesky). Fails on overflow.
+ */
+static int factorization_sizes(unsigned long size, int dense,
+			       unsigned long *t, unsigned long *updates)
+{
+	if(size == 0)
+	{
+		*t = *updates = 0;
+		return GGEN_SUCCESS;
+	}
+	if(count_madd(0,size,size-1,t))
+		return GGEN_FAILURE;
+	*t /= 2;
+	/* T(2size-1)/3 and T(size-2)/3 are exact */
+	if((dense && size > ULONG_MAX/2)
+	   || count_madd(0,*t,dense ? 2*size-1 : size-2,updates))
+		return GGEN_FAILURE;
+	*updates /= 3;
+	return GGEN_SUCCESS;
+}
+
+/* Task and edge counts of both factorizations follow the same rules: a panel
+ * task reads one block produced by the same step, an update two, and outside
+ * of the first step a task also depends on the last writer of its inout block.
+ * A longest path goes through 3 tasks per step (diagonal, panel, update of the
+ * next diagonal block), the updates of the first step are a longest antichain.
+ */
+static int factorization_family(unsigned long size, int dense,
+				 struct ggen_family_metrics *m,
+				 unsigned long *t, unsigned long *updates)
+{
+	ggen_error_start_stack();
+	if(factorization_sizes(size,dense,t,updates))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	if(count_madd(size,2,*t,&m->vertices)
+	   || count_madd(m->vertices,1,*updates,&m->vertices))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	if(dense)
+	{
+		/* 2T panel edges, 2U + U for the updates, every task
+		 * outside of the first step being an update on another
+		 */
+		if(count_madd(0,2,*t,&m->edges)
+		   || count_madd(m->edges,3,*updates,&m->edges))
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		m->width = size <= 2 ? size : (size-1)*(size-1);
+	}
+	else
+	{
+		/* syrk are panel tasks on the diagonal blocks: 2T panel
+		 * edges, 2U update edges, T + U tasks outside of the first
+		 * step
+		 */
+		if(count_madd(0,3,*t,&m->edges)
+		   || count_madd(m->edges,3,*updates,&m->edges))
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		m->width = size == 0 ? 0 : (*t > 1 ? *t : 1);
+	}
+	m->critical_path = size == 0 ? 0 : 3*size - 2;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+static int factorization_kernels(const struct dataflow_kernel *table,
+				 unsigned long n, igraph_strvector_t *kernels,
+				 igraph_vector_t *counts)
+{
+	unsigned long i;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(family_kernels(kernels,counts,n));
+	for(i = 0; i < n; i++)
+		GGEN_CHECK_IGRAPH(igraph_strvector_set(kernels,i,table[i].name));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int family_cholesky(const unsigned long *params, struct ggen_family_metrics *m,
+		    igraph_strvector_t *kernels, igraph_vector_t *counts)
+{
+	unsigned long t,updates;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(factorization_family(params[0],0,m,&t,
+						       &updates));
+	if(kernels != NULL)
+	{
+		GGEN_CHECK_INTERNAL_ERRNO(factorization_kernels(cholesky_kernels,
+				DATAFLOW_NKERNELS(cholesky_kernels),
+				kernels,counts));
+		VECTOR(*counts)[POTRF] = params[0];
+		VECTOR(*counts)[TRSM] = t;
+		VECTOR(*counts)[SYRK] = t;
+		VECTOR(*counts)[GEMM] = updates;
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int family_denselu(const unsigned long *params, struct ggen_family_metrics *m,
+		   igraph_strvector_t *kernels, igraph_vector_t *counts)
+{
+	unsigned long t,updates;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(factorization_family(params[0],1,m,&t,
+						       &updates));
+	if(kernels != NULL)
+	{
+		GGEN_CHECK_INTERNAL_ERRNO(factorization_kernels(lu_kernels,
+				DATAFLOW_NKERNELS(lu_kernels),kernels,counts));
+		VECTOR(*counts)[LU] = params[0];
+		VECTOR(*counts)[FWD] = t;
+		VECTOR(*counts)[BDIV] = t;
+		VECTOR(*counts)[BMOD] = updates;
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
@@ -41,59 +41,57 @@
 * INRIA, Grenoble Universities.
 */
 
-#include "vector_utils.h"
+#include <string.h>
 
-int vector_uniq_sorted(igraph_vector_t *v)
-{
-	unsigned long i,pos;
-	/* basic idea : remember the last good number,
-	 * test each index against it.
-	 * It is that simple because the vector is sorted
-	 */
-	pos = 0;
-	for(i = 1; i < igraph_vector_size(v); i++)
-	{
-		if(VECTOR(*v)[i] != VECTOR(*v)[pos])
-		{
-			pos++;
-			VECTOR(*v)[pos] = VECTOR(*v)[i];
-		}
-	}
-	igraph_vector_resize(v,pos+1);
-	return 0;
-}
+#include "ggen.h"
+#include "error.h"
+#include "graph-family.h"
 
-int vector_uniq(igraph_vector_t *v)
-{
-	if(igraph_vector_size(v) == 0)
-		return 0;
-	igraph_vector_sort(v);
-	return vector_uniq_sorted(v);
-}
+/* families by name, with their number of parameters */
+static const struct family {
+	const char *name;
+	unsigned long nparams;
+	family_fn_t fn;
+} families[] = {
+	{ "cholesky", 1, family_cholesky },
+	{ "denselu", 1, family_denselu },
+	{ "fibonacci", 2, family_fibonacci },
+	{ "forkjoin", 2, family_forkjoin },
+	{ "strassen", 3, family_strassen },
+};
 
-int vector_diff(igraph_vector_t *to, igraph_vector_t *from)
+int family_kernels(igraph_strvector_t *kernels, igraph_vector_t *counts,
+		   unsigned long n)
 {
-	unsigned long i,j,ts,t,f;
-	ts = igraph_vector_size(to);
-	for(i = 0; i < igraph_vector_size(from);i++)
-	{
-		for(j = 0; j < ts; j++)
-		{
-			t = (unsigned long)VECTOR(*to)[j];
-			f = (unsigned long)VECTOR(*from)[i];
-			if(t == f)
-			{
-				ts--;
-				igraph_vector_remove(to,j);
-				j--;
-			}
-		}
-	}
-	return 0;
+	ggen_error_start_stack();
+	GGEN_CHECK_IGRAPH(igraph_strvector_resize(kernels,n));
+	GGEN_CHECK_IGRAPH(igraph_vector_resize(counts,n));
+	igraph_vector_null(counts);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
 }
 
-int vector_union(igraph_vector_t *to, igraph_vector_t *from)
+int ggen_analyze_family(const char *family, const unsigned long *params,
+			unsigned long nparams, struct ggen_family_metrics *m,
+			igraph_strvector_t *kernels, igraph_vector_t *counts)
 {
-	igraph_vector_append(to,from);
-	return vector_uniq(to);
+	unsigned long i,n;
+
+	ggen_error_start_stack();
+	if(family == NULL || m == NULL || (kernels == NULL) != (counts == NULL))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	n = sizeof(families)/sizeof(families[0]);
+	for(i = 0; i < n && strcmp(families[i].name,family); i++);
+	if(i == n || nparams != families[i].nparams
+	   || (nparams > 0 && params == NULL))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_INTERNAL_ERRNO(families[i].fn(params,m,kernels,counts));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
 }
@@ -0,0 +1,91 @@
+/* Copyright Swann Perarnau 2013
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+
+#ifndef GRAPH_FAMILY_H
+#define GRAPH_FAMILY_H 1
+
+#include <limits.h>
+#include "ggen.h"
+
+/* Analytic properties of the parametrised generators, see
+ * ggen_analyze_family. Each family is analysed next to its generator, with
+ * the same stop conditions and kernel types.
+ */
+
+/* a + b*c, fails on overflow */
+static inline int count_madd(unsigned long a, unsigned long b, unsigned long c,
+			     unsigned long *res)
+{
+	if(c != 0 && b > (ULONG_MAX - a)/c)
+		return GGEN_FAILURE;
+	*res = a + b*c;
+	return GGEN_SUCCESS;
+}
+
+/* params holds as many values as the family takes, kernels and counts are
+ * both NULL or both initialized.
+ */
+typedef int (*family_fn_t)(const unsigned long *params,
+			   struct ggen_family_metrics *m,
+			   igraph_strvector_t *kernels, igraph_vector_t *counts);
+
+/* resize kernels and counts to n kernel types, counts set to 0 */
+int family_kernels(igraph_strvector_t *kernels, igraph_vector_t *counts,
+		   unsigned long n);
+
+/* graph-static.c */
+int family_fibonacci(const unsigned long *params, struct ggen_family_metrics *m,
+		     igraph_strvector_t *kernels, igraph_vector_t *counts);
+int family_forkjoin(const unsigned long *params, struct ggen_family_metrics *m,
+		    igraph_strvector_t *kernels, igraph_vector_t *counts);
+int family_strassen(const unsigned long *params, struct ggen_family_metrics *m,
+		    igraph_strvector_t *kernels, igraph_vector_t *counts);
+
+/* graph-dataflow.c */
+int family_cholesky(const unsigned long *params, struct ggen_family_metrics *m,
+		    igraph_strvector_t *kernels, igraph_vector_t *counts);
+int family_denselu(const unsigned long *params, struct ggen_family_metrics *m,
+		   igraph_strvector_t *kernels, igraph_vector_t *counts);
+
+#endif /* GRAPH_FAMILY_H */
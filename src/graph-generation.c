@@ -44,8 +44,209 @@
 * INRIA, Grenoble Universities.
 */
 
+#include <math.h>
+#include <stdint.h>
+#include <pthread.h>
+
 #include "ggen.h"
 #include "error.h"
+#include "hash-set.h"
+#include "rng-philox.h"
+
+/* draws uniformly an integer in [0,n), even if n is larger than the range of
+ * the generator: the number is built from chunks of bits and rejected if too
+ * large. The mask being the smallest one covering n, at least half of the
+ * tries succeed.
+ */
+static uint64_t rng_uniform_u64(gsl_rng *r, uint64_t n)
+{
+	uint64_t x,mask,range;
+	unsigned int b,bits;
+
+	range = gsl_rng_max(r) - gsl_rng_min(r);
+	if(n <= range)
+		return gsl_rng_uniform_int(r,n);
+
+	// size of a chunk, uniform_int cannot go further than range
+	for(b = 1; b < 32 && (UINT64_C(1) << (b+1)) <= range; b++);
+
+	mask = n - 1;
+	mask |= mask >> 1;
+	mask |= mask >> 2;
+	mask |= mask >> 4;
+	mask |= mask >> 8;
+	mask |= mask >> 16;
+	mask |= mask >> 32;
+	do {
+		x = 0;
+		for(bits = 0; bits < 64 && (mask >> bits) != 0; bits += b)
+			x = (x << b) | gsl_rng_uniform_int(r,UINT64_C(1) << b);
+		x &= mask;
+	} while(x >= n);
+	return x;
+}
+
+/* the pairs (i,j), i < j, are numbered column by column:
+ * k = j*(j-1)/2 + i. This finds back the pair from its index.
+ */
+static inline void pair_unrank(uint64_t k, unsigned long *i, unsigned long *j)
+{
+	uint64_t c;
+	c = (uint64_t)((1.0 + sqrt(1.0 + 8.0*(double)k))/2.0);
+	// fix rounding errors of the square root on large indices
+	while(c*(c-1)/2 > k)
+		c--;
+	while(c*(c+1)/2 <= k)
+		c++;
+	*j = c;
+	*i = k - c*(c-1)/2;
+}
+
+/* Generators working row by row can use a counter based generator: row i then
+ * draws its numbers from stream s+1+i, s being the current stream of r, and r
+ * is moved to stream s+n+1 at the end. A row does not depend on the other
+ * ones, so rows are split into chunks of equal cost, each generated by its
+ * own thread into its own edge list. The lists are concatenated in row order:
+ * the graph does not depend on the number of threads.
+ *
+ * Row functions are called from several threads: they must not use the ggen
+ * error stack, only return an igraph error code.
+ */
+typedef int (*rows_fn_t)(void *arg, gsl_rng *r, unsigned long i, igraph_vector_t *edges);
+typedef double (*rows_cost_t)(void *arg, unsigned long i);
+
+static unsigned int ggen_threads = 1;
+
+int ggen_set_threads(unsigned int threads)
+{
+	ggen_error_start_stack();
+	if(threads == 0)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	ggen_threads = threads;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+unsigned int ggen_get_threads(void)
+{
+	return ggen_threads;
+}
+
+struct rows_chunk {
+	gsl_rng *r;
+	unsigned long base;
+	unsigned long first, last;
+	rows_fn_t fn;
+	void *arg;
+	igraph_vector_t edges;
+	int status;
+	int started;
+};
+
+static void *rows_chunk_run(void *data)
+{
+	struct rows_chunk *c = data;
+	unsigned long i;
+	for(i = c->first; i < c->last && c->status == IGRAPH_SUCCESS; i++)
+	{
+		philox_seek(c->r,c->base+i,0);
+		c->status = c->fn(c->arg,c->r,i,&c->edges);
+	}
+	return NULL;
+}
+
+static void rows_chunks_free(struct rows_chunk *chunks)
+{
+	unsigned long t;
+	for(t = 0; chunks[t].fn != NULL; t++)
+	{
+		gsl_rng_free(chunks[t].r);
+		igraph_vector_destroy(&chunks[t].edges);
+	}
+	free(chunks);
+}
+
+/* generate nrows rows with fn, r must be a philox generator. The edges of the
+ * rows are appended to edges (if any).
+ */
+static int rows_run(gsl_rng *r, unsigned long nrows, rows_cost_t cost,
+		rows_fn_t fn, void *arg, igraph_vector_t *edges)
+{
+	struct rows_chunk *chunks;
+	pthread_t *threads;
+	unsigned long i,t,nbt,base;
+	double total,acc;
+	int err;
+
+	ggen_error_start_stack();
+
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_rng_philox_tell(r,&base,NULL));
+	base++;
+
+	nbt = ggen_threads;
+	if(nbt > nrows)
+		nbt = nrows > 0 ? nrows : 1;
+
+	// one more chunk, zeroed, marks the end of the array
+	chunks = calloc(nbt+1,sizeof(struct rows_chunk));
+	GGEN_CHECK_ALLOC(chunks);
+	GGEN_FINALLY(rows_chunks_free,chunks);
+
+	threads = calloc(nbt,sizeof(pthread_t));
+	GGEN_CHECK_ALLOC(threads);
+	GGEN_FINALLY(free,threads);
+
+	for(t = 0; t < nbt; t++)
+	{
+		chunks[t].base = base;
+		chunks[t].fn = fn;
+		chunks[t].arg = arg;
+		chunks[t].status = IGRAPH_SUCCESS;
+		chunks[t].r = gsl_rng_clone(r);
+		GGEN_CHECK_ALLOC(chunks[t].r);
+		GGEN_CHECK_IGRAPH(igraph_vector_init(&chunks[t].edges,0));
+	}
+
+	// chunk t ends on the first row where the cost reaches (t+1)/nbt of
+	// the total
+	total = 0.0;
+	for(i = 0; i < nrows; i++)
+		total += cost(arg,i);
+	acc = 0.0;
+	for(i = 0, t = 0; t < nbt; t++)
+	{
+		chunks[t].first = i;
+		while(i < nrows && (t == nbt - 1 || acc < total*(t+1)/nbt))
+			acc += cost(arg,i++);
+		chunks[t].last = i;
+	}
+
+	// the calling thread does the first chunk, and the ones no thread could
+	// be created for
+	for(t = 1; t < nbt; t++)
+		chunks[t].started = !pthread_create(&threads[t],NULL,rows_chunk_run,&chunks[t]);
+	rows_chunk_run(&chunks[0]);
+	for(t = 1; t < nbt; t++)
+		if(chunks[t].started)
+			pthread_join(threads[t],NULL);
+		else
+			rows_chunk_run(&chunks[t]);
+
+	for(t = 0; t < nbt; t++)
+	{
+		GGEN_CHECK_IGRAPH(chunks[t].status);
+		if(edges != NULL)
+			GGEN_CHECK_IGRAPH(igraph_vector_append(edges,&chunks[t].edges));
+	}
+
+	philox_seek(r,base+nrows,0);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
 
 /* Erdos-Renyi : G(n,M)
 */
@@ -104,12 +305,143 @@ ggen_error_label:
 	return NULL;
 }
 
+/* Erdos-Renyi : G(n,M), sparse version
+ * Each edge is an index among the n(n-1)/2 possible pairs. M distinct indices
+ * are sampled using Floyd's algorithm (R. Floyd & J. Bentley, Programming
+ * Pearls: a sample of brilliance, 1987), with a hash set for the
+ * membership tests. If M is more than half the pairs, we sample the
+ * pairs that are not in the graph instead.
+ * Memory is O(M) and expected time O(M). The sampling itself is done by the
+ * streaming version, into an igraph sink.
+ */
+igraph_t *ggen_generate_erdos_gnm_sparse(gsl_rng *r, unsigned long n, unsigned long m)
+{
+	struct ggen_edge_sink *sink;
+	igraph_t *g = NULL;
+	int err;
+	uint64_t max;
+
+	ggen_error_start_stack();
+	if(r == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	max = (n <= 1) ? 0 : (uint64_t)n*(n-1)/2;
+	if(m > max)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	g = malloc(sizeof(igraph_t));
+	GGEN_CHECK_ALLOC(g);
+	GGEN_FINALLY3(free,g,1);
+
+	if(m == 0 || n <= 1)
+	{
+		GGEN_CHECK_IGRAPH(igraph_empty(g,n,1));
+		goto end;
+	}
+	if(m == max)
+	{
+		GGEN_CHECK_IGRAPH(igraph_full_citation(g,n,1));
+		goto end;
+	}
+
+	sink = ggen_edge_sink_igraph(g);
+	GGEN_CHECK_ALLOC(sink);
+	GGEN_FINALLY(ggen_edge_sink_free,sink);
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_stream_erdos_gnm(r,n,m,sink));
+end:
+	ggen_error_clean(1);
+	return g;
+ggen_error_label:
+	return NULL;
+}
+
+/* rows of the G(n,p) methods, row i holds the pairs (i,i+1) to (i,n-1) */
+struct gnp_rows {
+	unsigned long n;
+	double p,lp;
+	igraph_matrix_t *m;
+};
+
+static double gnp_row_cost(void *arg, unsigned long i)
+{
+	struct gnp_rows *a = arg;
+	return (double)(a->n - i) - 1.0;
+}
+
+static int gnp_matrix_row(void *arg, gsl_rng *r, unsigned long i, igraph_vector_t *edges)
+{
+	struct gnp_rows *a = arg;
+	unsigned long j;
+	for(j = i + 1; j < a->n; j++)
+		MATRIX(*a->m,i,j) = gsl_ran_bernoulli(r,a->p);
+	return IGRAPH_SUCCESS;
+}
+
+/* skip sampling inside row i of G(n,p), lp = log1p(-p): moves j, the last
+ * pair visited, to the next edge of the row. Returns 0 at the end of the row.
+ */
+static inline int gnp_skip_row_next(gsl_rng *r, unsigned long n, double lp,
+		unsigned long *j)
+{
+	double skip;
+	skip = floor(log(gsl_rng_uniform_pos(r))/lp);
+	// the rest of the row is empty
+	if(skip >= (double)(n - 1 - *j))
+		return 0;
+	*j = *j + 1 + (unsigned long)skip;
+	return 1;
+}
+
+/* skip sampling over all the rows of G(n,p), lp = log1p(-p): moves (i,j), the
+ * last pair visited, to the next edge. The first pair visited is (0,0).
+ * Returns 0 at the end of the matrix.
+ */
+static inline int gnp_skip_next(gsl_rng *r, unsigned long n, double lp,
+		unsigned long *i, unsigned long *j)
+{
+	double skip;
+	// number of failures before the next success
+	skip = floor(log(gsl_rng_uniform_pos(r))/lp);
+	// a skip bigger than the matrix is the end of the generation, this
+	// also protects the conversion below against overflows
+	if(skip >= (double)n * (double)n)
+	{
+		*i = n-1;
+		return 0;
+	}
+	*j = *j + 1 + (unsigned long)skip;
+	// wrap around rows, row i contains pairs (i,i+1) to (i,n-1)
+	while(*j >= n && *i < n-1)
+	{
+		(*i)++;
+		*j = *j - n + *i + 1;
+	}
+	return *i < n-1;
+}
+
+static int gnp_skip_row(void *arg, gsl_rng *r, unsigned long i, igraph_vector_t *edges)
+{
+	struct gnp_rows *a = arg;
+	unsigned long j = i;
+	int err;
+	// j is the last pair visited
+	while(gnp_skip_row_next(r,a->n,a->lp,&j))
+	{
+		if((err = igraph_vector_push_back(edges,i)) != IGRAPH_SUCCESS)
+			return err;
+		if((err = igraph_vector_push_back(edges,j)) != IGRAPH_SUCCESS)
+			return err;
+	}
+	return IGRAPH_SUCCESS;
+}
+
 /* Erdos-Renyi : G(n,p)
 */
 igraph_t *ggen_generate_erdos_gnp(gsl_rng *r, unsigned long n, double p)
 {
 	igraph_matrix_t m;
 	igraph_t *g = NULL;
+	struct gnp_rows a;
 	int err;
 	unsigned long i,j;
 
@@ -138,13 +470,21 @@ igraph_t *ggen_generate_erdos_gnp(gsl_rng *r, unsigned long n, double p)
 	GGEN_CHECK_IGRAPH(igraph_matrix_init(&m,n,n));
 	GGEN_FINALLY(igraph_matrix_destroy,&m);
 
-	for(i = 0; i < n; i++)
-		for(j = 0; j < n; j++)
-			if(i < j)
-				// coin flipping to determine if we add an edge or not
-				igraph_matrix_set(&m,i,j,gsl_ran_bernoulli(r,p));
-			else
-				igraph_matrix_set(&m,i,j,0);
+	if(r->type == ggen_rng_philox)
+	{
+		a.n = n;
+		a.p = p;
+		a.m = &m;
+		GGEN_CHECK_INTERNAL_ERRNO(rows_run(r,n,gnp_row_cost,gnp_matrix_row,&a,NULL));
+	}
+	else
+		for(i = 0; i < n; i++)
+			for(j = 0; j < n; j++)
+				if(i < j)
+					// coin flipping to determine if we add an edge or not
+					igraph_matrix_set(&m,i,j,gsl_ran_bernoulli(r,p));
+				else
+					igraph_matrix_set(&m,i,j,0);
 
 	GGEN_CHECK_IGRAPH(igraph_adjacency(g,&m,IGRAPH_ADJ_DIRECTED));
 end:
@@ -154,12 +494,490 @@ ggen_error_label:
 	return NULL;
 }
 
-igraph_t *ggen_generate_erdos_lbl(gsl_rng *r, unsigned long n, double p, unsigned long nbl)
+/* the skip sampling loop of the sparse G(n,p), shared with the sweeps:
+ * appends to edges the pairs (i,j), i < j, chosen with probability p > 0, in
+ * row major order.
+ */
+static int gnp_skip_edges(gsl_rng *r, unsigned long n, double p, igraph_vector_t *edges)
 {
+	struct gnp_rows a;
+	unsigned long i,j;
+	double lp,expected;
+	int err;
+
+	ggen_error_start_stack();
+	if(n <= 1)
+		goto end;
+
+	// reserve enough space for the expected number of edges, plus some
+	// slack. The vector still grows if we are unlucky.
+	expected = p * ((double)n * (double)(n-1) / 2.0);
+	expected = expected + 3.0*sqrt(expected) + 1.0;
+	GGEN_CHECK_IGRAPH(igraph_vector_reserve(edges,igraph_vector_size(edges)+2*(long)expected));
+
+	// log(1-p) loses p entirely below 1e-16, the skips becoming infinite
+	lp = log1p(-p);
+
+	if(r->type == ggen_rng_philox)
+	{
+		a.n = n;
+		a.lp = lp;
+		GGEN_CHECK_INTERNAL_ERRNO(rows_run(r,n,gnp_row_cost,gnp_skip_row,&a,edges));
+		goto end;
+	}
+
+	// j is the last pair visited in row i, the first row starts at (0,1)
+	i = 0;
+	j = 0;
+	while(gnp_skip_next(r,n,lp,&i,&j))
+	{
+		GGEN_CHECK_IGRAPH(igraph_vector_push_back(edges,i));
+		GGEN_CHECK_IGRAPH(igraph_vector_push_back(edges,j));
+	}
+
+end:
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* Erdos-Renyi : G(n,p), sparse version
+ * Instead of flipping a coin for each cell of the adjacency matrix, we jump
+ * directly from one edge to the next: the number of pairs skipped between two
+ * consecutive successes of Bernoulli trials follows a geometric law
+ * (Batagelj & Brandes, Efficient generation of large random networks, 2005).
+ * Pairs (i,j), i < j are visited row by row, the edge list is then given to
+ * igraph in one go. Time and memory are proportional to n+m.
+ */
+igraph_t *ggen_generate_erdos_gnp_sparse(gsl_rng *r, unsigned long n, double p)
+{
+	igraph_vector_t edges;
 	igraph_t *g = NULL;
-	igraph_matrix_t m;
-	igraph_vector_t layers;
+	int err;
+
+	ggen_error_start_stack();
+	if(r == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	if(p < 0.0 || p > 1.0)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	g = malloc(sizeof(igraph_t));
+	GGEN_CHECK_ALLOC(g);
+	GGEN_FINALLY3(free,g,1);
+
+	if(p == 0.0 || n <= 1)
+	{
+		GGEN_CHECK_IGRAPH(igraph_empty(g,n,1));
+		goto end;
+	}
+	if(p == 1.0)
+	{
+		GGEN_CHECK_IGRAPH(igraph_full_citation(g,n,1));
+		goto end;
+	}
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_INTERNAL_ERRNO(gnp_skip_edges(r,n,p,&edges));
+
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,n,1));
+end:
+	ggen_error_clean(1);
+	return g;
+ggen_error_label:
+	return NULL;
+}
+
+/* Streaming generation: the graph is given to an edge sink as it is
+ * generated, nothing is kept in memory by the generator itself.
+ */
+
+/* sink hooks report their own errors, but custom ones might not */
+static int sink_status(int ret)
+{
+	if(ret != GGEN_SUCCESS && ggen_errno.ggen_error == GGEN_SUCCESS)
+		ggen_errno.ggen_error = GGEN_FAILURE;
+	return ret;
+}
+
+/* begin a graph of n vertices and about m edges on the sink */
+static int sink_begin(struct ggen_edge_sink *s, unsigned long n, unsigned long m)
+{
+	unsigned long v;
+
+	ggen_error_start_stack();
+	if(s->begin != NULL)
+		GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->begin(s->data,n,m)));
+	if(s->vertex != NULL)
+		for(v = 0; v < n; v++)
+			GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->vertex(s->data,v)));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+static int sink_end(struct ggen_edge_sink *s)
+{
+	ggen_error_start_stack();
+	if(s->end != NULL)
+		GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->end(s->data)));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* Erdos-Renyi : G(n,p), streaming version
+ * The skip sampling of the sparse version, each edge going to the sink as
+ * soon as it is found. The random number generator is used in the same way:
+ * for 0 < p < 1, the same seed gives the same edges, in the same order.
+ * Memory is O(1).
+ */
+int ggen_stream_erdos_gnp(gsl_rng *r, unsigned long n, double p, struct ggen_edge_sink *s)
+{
+	unsigned long i,j,base;
+	double lp,expected;
+
+	ggen_error_start_stack();
+	if(r == NULL || s == NULL || s->edge == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	if(p < 0.0 || p > 1.0)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	expected = p * ((double)n * (double)(n > 0 ? n-1 : 0) / 2.0);
+	expected = expected + 3.0*sqrt(expected);
+	GGEN_CHECK_INTERNAL_ERRNO(sink_begin(s,n,(unsigned long)expected));
+
+	if(p == 1.0)
+	{
+		for(i = 0; i < n; i++)
+			for(j = i + 1; j < n; j++)
+				GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->edge(s->data,i,j)));
+	}
+	else if(p > 0.0 && n > 1)
+	{
+		lp = log1p(-p);
+		if(r->type == ggen_rng_philox)
+		{
+			// the streams of the rows are the ones of rows_run
+			GGEN_CHECK_INTERNAL_ERRNO(ggen_rng_philox_tell(r,&base,NULL));
+			base++;
+			for(i = 0; i < n; i++)
+			{
+				philox_seek(r,base+i,0);
+				j = i;
+				while(gnp_skip_row_next(r,n,lp,&j))
+					GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->edge(s->data,i,j)));
+			}
+			philox_seek(r,base+n,0);
+		}
+		else
+		{
+			i = 0;
+			j = 0;
+			while(gnp_skip_next(r,n,lp,&i,&j))
+				GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->edge(s->data,i,j)));
+		}
+	}
+
+	GGEN_CHECK_INTERNAL_ERRNO(sink_end(s));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* Erdos-Renyi : G(n,M), streaming version
+ * Floyd's algorithm of the sparse version, each sampled pair goes to the sink
+ * as soon as it is drawn. The hash set of the sampled pairs still needs
+ * O(min(M,n(n-1)/2-M)) memory.
+ */
+int ggen_stream_erdos_gnm(gsl_rng *r, unsigned long n, unsigned long m, struct ggen_edge_sink *s)
+{
+	hash_set_t set;
+	int complement;
 	unsigned long i,j;
+	uint64_t t,x,k,max;
+
+	ggen_error_start_stack();
+	if(r == NULL || s == NULL || s->edge == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	max = (n <= 1) ? 0 : (uint64_t)n*(n-1)/2;
+	if(m > max)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_INTERNAL_ERRNO(sink_begin(s,n,m));
+
+	if(m == max)
+	{
+		for(i = 0; i < n; i++)
+			for(j = i + 1; j < n; j++)
+				GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->edge(s->data,i,j)));
+	}
+	else if(m > 0)
+	{
+		complement = m > max/2;
+		k = complement ? max - m : m;
+
+		GGEN_CHECK_INTERNAL_ERRNO(hash_set_init(&set,k));
+		GGEN_FINALLY(hash_set_free,&set);
+
+		// Floyd: for each t, either pick a new index in [0,t] or t itself
+		for(t = max - k; t < max; t++)
+		{
+			x = rng_uniform_u64(r,t+1);
+			if(!hash_set_insert(&set,x))
+			{
+				hash_set_insert(&set,t);
+				x = t;
+			}
+			if(!complement)
+			{
+				pair_unrank(x,&i,&j);
+				GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->edge(s->data,i,j)));
+			}
+		}
+
+		// the graph is every pair not sampled
+		if(complement)
+		{
+			x = 0;
+			for(j = 1; j < n; j++)
+				for(i = 0; i < j; i++, x++)
+					if(!hash_set_contains(&set,x))
+						GGEN_CHECK_INTERNAL_ERRNO(sink_status(s->edge(s->data,i,j)));
+		}
+	}
+
+	GGEN_CHECK_INTERNAL_ERRNO(sink_end(s));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* Erdos-Renyi : coupled G(n,p) sweep
+ * Each edge of G(n,pmax) gets a uniform value u in [0,pmax), the graph for p
+ * keeps the edges with u < p. Each graph follows G(n,p) and the graphs are
+ * nested: G(n,p1) is a subgraph of G(n,p2) when p1 < p2. The whole sweep costs
+ * one sparse generation at pmax plus the size of the outputs.
+ * Graphs are returned in the order of ps.
+ */
+igraph_vector_ptr_t *ggen_generate_erdos_gnp_sweep(gsl_rng *r, unsigned long n,
+		const igraph_vector_t *ps)
+{
+	igraph_vector_ptr_t *res = NULL;
+	igraph_vector_t all,values,edges;
+	unsigned long i,k,m,size;
+	double p,pmax;
+	int err;
+
+	ggen_error_start_stack();
+	if(r == NULL || ps == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	size = igraph_vector_size(ps);
+	if(size == 0)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	for(k = 0; k < size; k++)
+		if(VECTOR(*ps)[k] < 0.0 || VECTOR(*ps)[k] > 1.0)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	res = malloc(sizeof(igraph_vector_ptr_t));
+	GGEN_CHECK_ALLOC(res);
+	GGEN_FINALLY3(free,res,1);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_ptr_init(res,size));
+	IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(res,igraph_destroy);
+	GGEN_FINALLY3(igraph_vector_ptr_destroy_all,res,1);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&all,0));
+	GGEN_FINALLY(igraph_vector_destroy,&all);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&values,0));
+	GGEN_FINALLY(igraph_vector_destroy,&values);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+
+	// the densest graph, each edge has its value
+	pmax = igraph_vector_max(ps);
+	if(pmax > 0.0)
+		GGEN_CHECK_INTERNAL_ERRNO(gnp_skip_edges(r,n,pmax,&all));
+
+	m = igraph_vector_size(&all)/2;
+	GGEN_CHECK_IGRAPH(igraph_vector_resize(&values,m));
+	for(i = 0; i < m; i++)
+		VECTOR(values)[i] = gsl_rng_uniform(r);
+
+	for(k = 0; k < size; k++)
+	{
+		// values are relative to pmax
+		p = (pmax > 0.0) ? VECTOR(*ps)[k]/pmax : 0.0;
+		igraph_vector_clear(&edges);
+		for(i = 0; i < m; i++)
+			if(VECTOR(values)[i] < p)
+			{
+				GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,VECTOR(all)[2*i]));
+				GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,VECTOR(all)[2*i+1]));
+			}
+
+		VECTOR(*res)[k] = malloc(sizeof(igraph_t));
+		GGEN_CHECK_ALLOC(VECTOR(*res)[k]);
+		GGEN_CHECK_IGRAPH_VECTPTR(igraph_create(VECTOR(*res)[k],&edges,n,1),*res,k);
+	}
+
+	ggen_error_clean(1);
+	return res;
+ggen_error_label:
+	return NULL;
+}
+
+/* Erdos-Renyi : coupled G(n,M) sweep
+ * Mmax distinct pairs are sampled with Floyd's algorithm then shuffled: the
+ * graph for M is made of the first M pairs. Each graph follows G(n,M) and the
+ * graphs are nested. Time and memory are O(Mmax) plus the size of the outputs.
+ * Graphs are returned in the order of ms.
+ */
+igraph_vector_ptr_t *ggen_generate_erdos_gnm_sweep(gsl_rng *r, unsigned long n,
+		const igraph_vector_t *ms)
+{
+	igraph_vector_ptr_t *res = NULL;
+	igraph_vector_long_t order;
+	igraph_vector_t edges;
+	hash_set_t set;
+	unsigned long i,j,k,m,size;
+	uint64_t t,x,max,mmax;
+	int err;
+
+	ggen_error_start_stack();
+	if(r == NULL || ms == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	size = igraph_vector_size(ms);
+	if(size == 0)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	max = (n <= 1) ? 0 : (uint64_t)n*(n-1)/2;
+	for(k = 0; k < size; k++)
+		if(VECTOR(*ms)[k] < 0.0 || VECTOR(*ms)[k] > (double)max)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+	mmax = (uint64_t)igraph_vector_max(ms);
+
+	res = malloc(sizeof(igraph_vector_ptr_t));
+	GGEN_CHECK_ALLOC(res);
+	GGEN_FINALLY3(free,res,1);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_ptr_init(res,size));
+	IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(res,igraph_destroy);
+	GGEN_FINALLY3(igraph_vector_ptr_destroy_all,res,1);
+
+	GGEN_CHECK_INTERNAL_ERRNO(hash_set_init(&set,mmax));
+	GGEN_FINALLY(hash_set_free,&set);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&order,0));
+	GGEN_FINALLY(igraph_vector_long_destroy,&order);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_reserve(&order,mmax));
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_IGRAPH(igraph_vector_reserve(&edges,2*mmax));
+
+	for(t = max - mmax; t < max; t++)
+	{
+		x = rng_uniform_u64(r,t+1);
+		if(!hash_set_insert(&set,x))
+		{
+			hash_set_insert(&set,t);
+			x = t;
+		}
+		GGEN_CHECK_IGRAPH(igraph_vector_long_push_back(&order,x));
+	}
+	// Floyd gives a uniform set, not a uniform order
+	if(mmax > 1)
+		GGEN_CHECK_GSL_DO(gsl_ran_shuffle(r,VECTOR(order),mmax,sizeof(VECTOR(order)[0])));
+
+	for(k = 0; k < size; k++)
+	{
+		m = (unsigned long)VECTOR(*ms)[k];
+		igraph_vector_clear(&edges);
+		for(t = 0; t < m; t++)
+		{
+			pair_unrank(VECTOR(order)[t],&i,&j);
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,i));
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,j));
+		}
+
+		VECTOR(*res)[k] = malloc(sizeof(igraph_t));
+		GGEN_CHECK_ALLOC(VECTOR(*res)[k]);
+		GGEN_CHECK_IGRAPH_VECTPTR(igraph_create(VECTOR(*res)[k],&edges,n,1),*res,k);
+	}
+
+	ggen_error_clean(1);
+	return res;
+ggen_error_label:
+	return NULL;
+}
+
+/* rows of the layer by layer method: row k is the vertex at position k in the
+ * layer order, its candidates are the positions [start[order[k]], n)
+ */
+struct lbl_rows {
+	unsigned long n;
+	double lp;
+	igraph_vector_long_t *order;
+	igraph_vector_long_t *start;
+};
+
+static double lbl_row_cost(void *arg, unsigned long k)
+{
+	struct lbl_rows *a = arg;
+	return (double)(a->n - VECTOR(*a->start)[VECTOR(*a->order)[k]]);
+}
+
+static int lbl_row(void *arg, gsl_rng *r, unsigned long k, igraph_vector_t *edges)
+{
+	struct lbl_rows *a = arg;
+	unsigned long i,j,first;
+	double skip;
+	int err;
+
+	i = VECTOR(*a->order)[k];
+	first = VECTOR(*a->start)[i];
+	// j is the next candidate
+	for(j = 0; ; j++)
+	{
+		skip = floor(log(gsl_rng_uniform_pos(r))/a->lp);
+		if(skip >= (double)(a->n - first - j))
+			break;
+		j = j + (unsigned long)skip;
+		if((err = igraph_vector_push_back(edges,i)) != IGRAPH_SUCCESS)
+			return err;
+		if((err = igraph_vector_push_back(edges,VECTOR(*a->order)[first + j])) != IGRAPH_SUCCESS)
+			return err;
+	}
+	return IGRAPH_SUCCESS;
+}
+
+/* Layer by Layer
+ * Vertices are dispatched into layers, then the G(n,p) skipping method is
+ * applied only on the pairs allowed by the layers: once vertices are sorted
+ * by layer, the candidates of a vertex are all the vertices after the end of
+ * its layer, a contiguous range. We skip over the concatenation of those
+ * ranges, so the cost follows the number of edges and not n^2.
+ */
+igraph_t *ggen_generate_erdos_lbl(gsl_rng *r, unsigned long n, double p, unsigned long nbl)
+{
+	igraph_t *g = NULL;
+	igraph_vector_long_t layers,order,next;
+	igraph_vector_t edges;
+	struct lbl_rows a;
+	unsigned long i,j,k,l;
+	double lp,skip,pairs,expected;
 	int err;
 
 	ggen_error_start_stack();
@@ -187,11 +1005,8 @@ igraph_t *ggen_generate_erdos_lbl(gsl_rng *r, unsigned long n, double p, unsigne
 		goto end;
 	}
 
-	GGEN_CHECK_IGRAPH(igraph_matrix_init(&m,n,n));
-	GGEN_FINALLY(igraph_matrix_destroy,&m);
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&layers,n));
-	GGEN_FINALLY(igraph_vector_destroy,&layers);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&layers,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&layers);
 
 	// asign to each vertex a layer
 	for(i = 0; i < n; i++)
@@ -200,17 +1015,77 @@ igraph_t *ggen_generate_erdos_lbl(gsl_rng *r, unsigned long n, double p, unsigne
 		VECTOR(layers)[i] = j;
 	}
 
-	// create edges
+	// counting sort of the vertices by layer
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&next,nbl+1));
+	GGEN_FINALLY(igraph_vector_long_destroy,&next);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&order,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&order);
+
 	for(i = 0; i < n; i++)
-		for(j = 0; j < n; j++)
-			// if the layer allocation allows the edge, we test for it
-			if(VECTOR(layers)[i]<VECTOR(layers)[j])
-				igraph_matrix_set(&m,i,j,gsl_ran_bernoulli(r,p));
-			else
-				igraph_matrix_set(&m,i,j,0);
+		VECTOR(next)[VECTOR(layers)[i]+1]++;
+	for(l = 1; l <= nbl; l++)
+		VECTOR(next)[l] += VECTOR(next)[l-1];
+	// next[l] is now the start of layer l, use it as an insertion cursor.
+	// Once done, it is the end of layer l: the first candidate of its
+	// vertices.
+	for(i = 0; i < n; i++)
+		VECTOR(order)[VECTOR(next)[VECTOR(layers)[i]]++] = i;
 
-	//translate the matrix to a graph
-	GGEN_CHECK_IGRAPH(igraph_adjacency(g,&m,IGRAPH_ADJ_DIRECTED));
+	// replace the layer of each vertex by the start of its candidates
+	// range, and count the number of allowed pairs
+	pairs = 0.0;
+	for(k = 0; k < n; k++)
+	{
+		l = VECTOR(layers)[VECTOR(order)[k]];
+		VECTOR(layers)[VECTOR(order)[k]] = VECTOR(next)[l];
+		pairs += n - VECTOR(next)[l];
+	}
+
+	expected = p * pairs;
+	expected = expected + 3.0*sqrt(expected) + 1.0;
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_IGRAPH(igraph_vector_reserve(&edges,2*(long)expected));
+
+	lp = log1p(-p);
+	if(r->type == ggen_rng_philox)
+	{
+		a.n = n;
+		a.lp = lp;
+		a.order = &order;
+		a.start = &layers;
+		GGEN_CHECK_INTERNAL_ERRNO(rows_run(r,n,lbl_row_cost,lbl_row,&a,&edges));
+		goto create;
+	}
+
+	// k is the position of the current vertex, j the next candidate in its
+	// range. The range of position k is [layers[order[k]], n).
+	k = 0;
+	j = 0;
+	while(k < n)
+	{
+		skip = floor(log(gsl_rng_uniform_pos(r))/lp);
+		if(skip >= pairs)
+			break;
+
+		j = j + (unsigned long)skip;
+		while(k < n && j >= n - VECTOR(layers)[VECTOR(order)[k]])
+		{
+			j -= n - VECTOR(layers)[VECTOR(order)[k]];
+			k++;
+		}
+		if(k < n)
+		{
+			i = VECTOR(order)[k];
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,i));
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,
+						VECTOR(order)[VECTOR(layers)[i] + j]));
+			j++;
+		}
+	}
+
+create:
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,n,1));
 end:
 	ggen_error_clean(1);
 	return g;
@@ -218,18 +1093,118 @@ ggen_error_label:
 	return NULL;
 }
 
+/* Fenwick tree helpers for the fifo and random orders methods: t is a 1-based
+ * binary indexed tree over vertex ids, each vertex being present (1) or not (0).
+ */
+static inline void fenwick_add(igraph_vector_long_t *t, unsigned long i, long d)
+{
+	unsigned long size = igraph_vector_long_size(t);
+	for(i = i + 1; i < size; i += i & (~i + 1))
+		VECTOR(*t)[i] += d;
+}
+
+/* number of present vertices with an id lower than i */
+static inline unsigned long fenwick_prefix(igraph_vector_long_t *t, unsigned long i)
+{
+	unsigned long sum = 0;
+	for(; i > 0; i -= i & (~i + 1))
+		sum += VECTOR(*t)[i];
+	return sum;
+}
+
+/* find the present vertex of rank k (0-based) */
+static inline unsigned long fenwick_select(igraph_vector_long_t *t, unsigned long k)
+{
+	unsigned long size = igraph_vector_long_size(t);
+	unsigned long pos = 0, step = 1;
+	while(2*step < size)
+		step *= 2;
+	for(; step > 0; step /= 2)
+		if(pos + step < size && (unsigned long)VECTOR(*t)[pos+step] <= k)
+		{
+			pos += step;
+			k -= VECTOR(*t)[pos];
+		}
+	return pos;
+}
+
+/* bookkeeping of the fifo method: the fan-out candidates (childless vertices)
+ * and the fan-in candidates (vertices with some out degree available), both
+ * in id order.
+ */
+struct fifo_state {
+	unsigned long od;
+	igraph_vector_long_t out_degrees;
+	igraph_vector_long_t childless;
+	unsigned long nbchildless;
+	// doubly linked list of fan-in candidates
+	igraph_vector_long_t next;
+	igraph_vector_long_t prev;
+	long head,tail;
+	unsigned long nbavail;
+};
+
+/* add a vertex, it must have the largest id so far */
+static inline void fifo_new_vertex(struct fifo_state *s, unsigned long v)
+{
+	fenwick_add(&s->childless,v,1);
+	s->nbchildless++;
+	VECTOR(s->prev)[v] = s->tail;
+	VECTOR(s->next)[v] = -1;
+	if(s->tail == -1)
+		s->head = v;
+	else
+		VECTOR(s->next)[s->tail] = v;
+	s->tail = v;
+	s->nbavail++;
+}
+
+/* v gets a new child */
+static inline void fifo_new_child(struct fifo_state *s, unsigned long v)
+{
+	long p,q;
+	if(VECTOR(s->out_degrees)[v] == 0)
+	{
+		fenwick_add(&s->childless,v,-1);
+		s->nbchildless--;
+	}
+	VECTOR(s->out_degrees)[v]++;
+	if(VECTOR(s->out_degrees)[v] == s->od)
+	{
+		// v is saturated, unlink it from the fan-in candidates
+		p = VECTOR(s->prev)[v];
+		q = VECTOR(s->next)[v];
+		if(p == -1)
+			s->head = q;
+		else
+			VECTOR(s->next)[p] = q;
+		if(q == -1)
+			s->tail = p;
+		else
+			VECTOR(s->prev)[q] = p;
+		s->nbavail--;
+	}
+}
+
 /* Fan-in/ Fan-out method
-*/
+ * The available out degree of each vertex is maintained incrementally:
+ * - the vertex created last never has children, so the maximum available
+ *   out degree is always od and the fan-out candidates are exactly the
+ *   childless vertices. We pick one by its rank in O(log n).
+ * - gsl_ran_choose draws a number for each fan-in candidate until it has
+ *   enough of them. We do the same walk on the list of candidates so that the
+ *   random number generator is used exactly as before: the same seed gives
+ *   the same graph.
+ * Edges are accumulated in a single list, the graph is built at the end.
+ */
 igraph_t *ggen_generate_fifo(gsl_rng *r, unsigned long n, unsigned long od, unsigned long id)
 {
 	igraph_t *g = NULL;
-	igraph_vector_t available_od;
-	igraph_vector_t out_degrees;
-	igraph_vector_t vertices;
-	igraph_vector_t choice;
+	struct fifo_state s;
 	igraph_vector_t edges;
-	unsigned long max;
-	unsigned long i,j,k;
+	unsigned long max,size,chosen;
+	unsigned long i,j,k,v;
+	long cur;
 	unsigned long vcount = 1;
 	int err;
 
@@ -244,101 +1219,80 @@ igraph_t *ggen_generate_fifo(gsl_rng *r, unsigned long n, unsigned long od, unsi
 	GGEN_CHECK_ALLOC(g);
 	GGEN_FINALLY3(free,g,1);
 
-	GGEN_CHECK_IGRAPH(igraph_empty(g,1,1));
-	GGEN_FINALLY3(igraph_destroy,g,1);
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&available_od,n));
-	GGEN_FINALLY(igraph_vector_destroy,&available_od);
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&out_degrees,n));
-	GGEN_FINALLY(igraph_vector_destroy,&out_degrees);
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&vertices,n));
-	GGEN_FINALLY(igraph_vector_destroy,&vertices);
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&choice,n));
-	GGEN_FINALLY(igraph_vector_destroy,&choice);
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,n*2));
+	// a fan-out can overshoot n by od-1 vertices
+	size = n + od;
+	s.od = od;
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&s.out_degrees,size));
+	GGEN_FINALLY(igraph_vector_long_destroy,&s.out_degrees);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&s.childless,size+1));
+	GGEN_FINALLY(igraph_vector_long_destroy,&s.childless);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&s.next,size));
+	GGEN_FINALLY(igraph_vector_long_destroy,&s.next);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&s.prev,size));
+	GGEN_FINALLY(igraph_vector_long_destroy,&s.prev);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
 	GGEN_FINALLY(igraph_vector_destroy,&edges);
-	while(vcount < n)
-	{
-		// never trigger errors as it doesn't allocate or free memory
-		igraph_vector_resize(&available_od,vcount);
-		igraph_vector_resize(&out_degrees,vcount);
-		igraph_vector_resize(&vertices,vcount);
-
-		// compute the available out degree of each vertex
-		GGEN_CHECK_IGRAPH(igraph_degree(g,&out_degrees,igraph_vss_all(),IGRAPH_OUT,0));
+	GGEN_CHECK_IGRAPH(igraph_vector_reserve(&edges,2*size));
 
-		// fill available with od and substract out_degrees
-		igraph_vector_fill(&available_od,od);
-		GGEN_CHECK_IGRAPH(igraph_vector_sub(&available_od,&out_degrees));
+	s.nbchildless = 0;
+	s.nbavail = 0;
+	s.head = s.tail = -1;
+	fifo_new_vertex(&s,0);
 
+	while(vcount < n)
+	{
 		if(gsl_ran_bernoulli(r,0.5))     //Fan-out Step
 		{
-			// find max
-			max = igraph_vector_max(&available_od);
-
-			// register all vertices having max as outdegree
-			j = 0;
-			for (i = 0; i < vcount;i++)
-				if(VECTOR(available_od)[i] == max)
-					VECTOR(vertices)[j++] = i;
+			max = od;
 
 			// choose randomly a vertex among availables
-			GGEN_CHECK_GSL_DO(i = gsl_rng_uniform_int(r,j));
+			GGEN_CHECK_GSL_DO(i = gsl_rng_uniform_int(r,s.nbchildless));
+			v = fenwick_select(&s.childless,i);
 
 			// how many children ?
 			GGEN_CHECK_GSL_DO(j = gsl_rng_uniform_int(r,max));
 			j = j+1;
 
-			// create all new nodes and add edges
-			GGEN_CHECK_IGRAPH(igraph_add_vertices(g,j,NULL));
-
-			// cannot fail
-			igraph_vector_resize(&edges,j*2);
-
 			for(k = 0; k < j; k++)
 			{
-				VECTOR(edges)[2*k] = VECTOR(vertices)[i];
-				VECTOR(edges)[2*k+1] = vcount + k;
+				GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,v));
+				GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,vcount+k));
+				fifo_new_child(&s,v);
+				fifo_new_vertex(&s,vcount+k);
 			}
 			vcount+=k;
 		}
 		else	//Fan-In Step
 		{
-			// register all vertices having an available outdegree
-			j = 0;
-			for (i = 0; i < vcount;i++)
-				if(VECTOR(available_od)[i] > 0)
-					VECTOR(vertices)[j++] = i;
-
 			// we can add at most id vertices
+			j = s.nbavail;
 			max =( j > id)? id: j;
 			// how many edges to add
 			GGEN_CHECK_GSL_DO(k = gsl_rng_uniform_int(r,max));
 			k = k+1;
 
-			// choose that many nodes and add edges from them to the new node
-			// cannot fail either
-			igraph_vector_resize(&choice,k);
-
-			gsl_ran_choose(r,VECTOR(choice),k,
-				VECTOR(vertices),j,sizeof(VECTOR(vertices)[0]));
-
-			// add a vertex to the graph
-			GGEN_CHECK_IGRAPH(igraph_add_vertices(g,1,NULL));
-
-			igraph_vector_resize(&edges,k*2);
-			// be carefull, vcount is the last ID of vertices not vcount +1
-			for(i = 0; i < k; i++)
+			// choose k vertices among the j candidates, exactly like
+			// gsl_ran_choose, and add edges from them to the new node
+			chosen = 0;
+			cur = s.head;
+			for(i = 0; i < j && chosen < k; i++)
 			{
-				VECTOR(edges)[2*i] = VECTOR(choice)[i];
-				VECTOR(edges)[2*i+1] = vcount;
+				v = cur;
+				cur = VECTOR(s.next)[cur];
+				if((j - i) * gsl_rng_uniform(r) < k - chosen)
+				{
+					GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,v));
+					GGEN_CHECK_IGRAPH(igraph_vector_push_back(&edges,vcount));
+					fifo_new_child(&s,v);
+					chosen++;
+				}
 			}
+			fifo_new_vertex(&s,vcount);
 			vcount++;
-
 		}
-		// in all cases, edges should be added
-		GGEN_CHECK_IGRAPH(igraph_add_edges(g,&edges,NULL));
 	}
+
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,vcount,1));
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
@@ -347,16 +1301,268 @@ ggen_error_label:
 
 
 /* Random Orders Method :
-*/
+ * Vertex i is linked to vertex j if i comes before j in all the orders. We
+ * only keep, for each order, the position of each vertex (pos[o*n + v]) and
+ * compute the dominated pairs from that. The edges are emitted in (i,j) order,
+ * like igraph_adjacency would on the n*n matrix of the relation.
+ */
+
+/* two orders: sweep the vertices in the first order, keeping the previous
+ * ones sorted by their position in the second order (a list, with a Fenwick
+ * tree to find insertion points). The predecessors of a vertex are then a
+ * prefix of the list. O(n log n + m) time, O(n + m) memory.
+ */
+static int random_orders_sweep(unsigned long n, igraph_vector_long_t *pos,
+		igraph_vector_t *edges)
+{
+	igraph_vector_long_t by0,by1,tree,next,start,count,preds;
+	unsigned long i,j,k,p,x,rank,m = 0;
+	long head = -1, cur;
+	int err;
+
+	ggen_error_start_stack();
+
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&by0,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&by0);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&by1,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&by1);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&tree,n+1));
+	GGEN_FINALLY(igraph_vector_long_destroy,&tree);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&next,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&next);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&start,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&start);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&count,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&count);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&preds,0));
+	GGEN_FINALLY(igraph_vector_long_destroy,&preds);
+
+	for(i = 0; i < n; i++)
+	{
+		VECTOR(by0)[VECTOR(*pos)[i]] = i;
+		VECTOR(by1)[VECTOR(*pos)[n+i]] = i;
+	}
+
+	// count holds the number of predecessors first, successors later
+	for(p = 0; p < n; p++)
+	{
+		j = VECTOR(by0)[p];
+		x = VECTOR(*pos)[n+j];
+		rank = fenwick_prefix(&tree,x);
+		VECTOR(start)[j] = m;
+		VECTOR(count)[j] = rank;
+		m += rank;
+		for(k = 0, cur = head; k < rank; k++, cur = VECTOR(next)[cur])
+			GGEN_CHECK_IGRAPH(igraph_vector_long_push_back(&preds,cur));
+
+		// insert j after its predecessor in the second order
+		if(rank == 0)
+		{
+			VECTOR(next)[j] = head;
+			head = j;
+		}
+		else
+		{
+			i = VECTOR(by1)[fenwick_select(&tree,rank-1)];
+			VECTOR(next)[j] = VECTOR(next)[i];
+			VECTOR(next)[i] = j;
+		}
+		fenwick_add(&tree,x,1);
+	}
+
+	// bucket the edges by source, walking the targets in increasing order
+	igraph_vector_long_null(&tree);
+	for(k = 0; k < m; k++)
+		VECTOR(tree)[VECTOR(preds)[k]]++;
+	for(i = 0, x = 0; i < n; i++)
+	{
+		p = VECTOR(tree)[i];
+		VECTOR(tree)[i] = x;
+		x += p;
+	}
+	GGEN_CHECK_IGRAPH(igraph_vector_resize(edges,2*m));
+	for(j = 0; j < n; j++)
+		for(k = 0; k < (unsigned long)VECTOR(count)[j]; k++)
+		{
+			i = VECTOR(preds)[VECTOR(start)[j]+k];
+			p = VECTOR(tree)[i]++;
+			VECTOR(*edges)[2*p] = i;
+			VECTOR(*edges)[2*p+1] = j;
+		}
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* many orders: for each vertex, filter the candidates one order at a time.
+ * The first order costs n comparisons and each following one removes half of
+ * the remaining candidates on average, so a vertex costs about 2n
+ * comparisons, O(n^2) in total, in O(kn) memory.
+ */
+static int random_orders_filter(unsigned long n, unsigned int orders,
+		igraph_vector_long_t *pos, igraph_vector_t *edges)
+{
+	igraph_vector_long_t cand;
+	unsigned long i,j,k,c,nbcand;
+	long *p;
+	int err;
+
+	ggen_error_start_stack();
+
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&cand,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&cand);
+
+	for(i = 0; i < n; i++)
+	{
+		p = VECTOR(*pos);
+		nbcand = 0;
+		for(j = 0; j < n; j++)
+			if(p[j] > p[i])
+				VECTOR(cand)[nbcand++] = j;
+
+		for(k = 1; k < orders && nbcand > 0; k++)
+		{
+			p = VECTOR(*pos) + k*n;
+			for(j = 0, c = 0; j < nbcand; j++)
+				if(p[VECTOR(cand)[j]] > p[i])
+					VECTOR(cand)[c++] = VECTOR(cand)[j];
+			nbcand = c;
+		}
+
+		for(j = 0; j < nbcand; j++)
+		{
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(edges,i));
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(edges,VECTOR(cand)[j]));
+		}
+	}
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* a few orders: packed bitsets. The successors of the vertex of rank r in an
+ * order are the vertices of rank r+1 and above. For each order and each
+ * multiple of 64, the set of vertices ranked at or above it is stored, and a
+ * successor set is the stored set of the next multiple of 64, patched with at
+ * most 63 vertices. A vertex then ANDs its successor sets, n/64 words per
+ * order. O(k*n*n/64 + m) time, k*n*n/512 bytes for the stored sets.
+ *
+ * With k orders there are about n*n/2^k edges, 16 bytes each in the edge
+ * vector, so above 9 orders the stored sets would outweigh the graph: the
+ * candidate filter is used instead.
+ */
+#define RANDOM_ORDERS_BITSETS_MAX 9
+#define ORDERS_BIT(v) ((uint64_t)1 << ((v)%64))
+
+static inline int orders_lowest_bit(uint64_t x)
+{
+#ifdef __GNUC__
+	return __builtin_ctzll(x);
+#else
+	int i = 0;
+	while(!(x & 1))
+	{
+		x >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+static int random_orders_bitsets(unsigned long n, unsigned int orders,
+		igraph_vector_long_t *pos, igraph_vector_t *edges)
+{
+	igraph_vector_long_t by;
+	uint64_t *sets,*acc,*row,*dst,x;
+	unsigned long i,j,t,c,r,end;
+	size_t k,words,per;
+	int err;
+
+	ggen_error_start_stack();
+
+	// set c-1 of order t: the vertices of rank 64c and above, 0 < c < words
+	words = (n + 63)/64;
+	per = words > 0 ? words*(words-1) : 0;
+	sets = calloc(orders*per + 1,sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(sets);
+	GGEN_FINALLY(free,sets);
+	acc = malloc((2*words + 1)*sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(acc);
+	GGEN_FINALLY(free,acc);
+	row = acc + words;
+
+	// vertex at each rank of each order
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&by,n*orders));
+	GGEN_FINALLY(igraph_vector_long_destroy,&by);
+	for(t = 0; t < orders; t++)
+		for(i = 0; i < n; i++)
+			VECTOR(by)[t*n + VECTOR(*pos)[t*n + i]] = i;
+
+	for(t = 0; t < orders; t++)
+		for(c = words-1; c > 0; c--)
+		{
+			dst = sets + t*per + (c-1)*words;
+			if(c + 1 < words)
+				for(k = 0; k < words; k++)
+					dst[k] = dst[words + k];
+			end = 64*(c+1) < n ? 64*(c+1) : n;
+			for(r = 64*c; r < end; r++)
+			{
+				j = VECTOR(by)[t*n + r];
+				dst[j/64] |= ORDERS_BIT(j);
+			}
+		}
+
+	for(i = 0; i < n; i++)
+	{
+		for(t = 0; t < orders; t++)
+		{
+			dst = t == 0 ? acc : row;
+			r = VECTOR(*pos)[t*n + i];
+			c = r/64 + 1;
+			if(c < words)
+				for(k = 0; k < words; k++)
+					dst[k] = sets[t*per + (c-1)*words + k];
+			else
+				for(k = 0; k < words; k++)
+					dst[k] = 0;
+			end = 64*c < n ? 64*c : n;
+			for(r = r + 1; r < end; r++)
+			{
+				j = VECTOR(by)[t*n + r];
+				dst[j/64] |= ORDERS_BIT(j);
+			}
+			if(t > 0)
+				for(k = 0; k < words; k++)
+					acc[k] &= row[k];
+		}
+
+		for(k = 0; k < words; k++)
+			for(x = acc[k]; x != 0; x &= x - 1)
+			{
+				j = 64*k + orders_lowest_bit(x);
+				GGEN_CHECK_IGRAPH(igraph_vector_push_back(edges,i));
+				GGEN_CHECK_IGRAPH(igraph_vector_push_back(edges,j));
+			}
+	}
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
 igraph_t * ggen_generate_random_orders(gsl_rng *r, unsigned long n, unsigned int orders)
 {
 	igraph_t *g = NULL;
-	igraph_matrix_t m,edge_validity;
+	igraph_vector_long_t perm,pos;
+	igraph_vector_t edges;
 	int err = 0;
-	long long i = 0,j,k;
-	igraph_vector_ptr_t posets;
-	igraph_vector_ptr_t indexes;
-	igraph_vector_t *v,*w;
+	unsigned long i,j;
 
 	ggen_error_start_stack();
 	if(r == NULL)
@@ -370,72 +1576,34 @@ igraph_t * ggen_generate_random_orders(gsl_rng *r, unsigned long n, unsigned int
 	GGEN_CHECK_ALLOC(g);
 	GGEN_FINALLY3(free,g,1);
 
-	GGEN_CHECK_IGRAPH(igraph_matrix_init(&m,n,n));
-	GGEN_FINALLY(igraph_matrix_destroy,&m);
-
-	GGEN_CHECK_IGRAPH(igraph_matrix_init(&edge_validity,n,n));
-	GGEN_FINALLY(igraph_matrix_destroy,&edge_validity);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&perm,n));
+	GGEN_FINALLY(igraph_vector_long_destroy,&perm);
 
-	GGEN_CHECK_IGRAPH(igraph_vector_ptr_init(&posets,orders));
-	IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&posets,igraph_vector_destroy);
-	GGEN_FINALLY(igraph_vector_ptr_destroy_all,&posets);
+	GGEN_CHECK_IGRAPH(igraph_vector_long_init(&pos,n*orders));
+	GGEN_FINALLY(igraph_vector_long_destroy,&pos);
 
-	GGEN_CHECK_IGRAPH(igraph_vector_ptr_init(&indexes,orders));
-	IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&indexes,igraph_vector_destroy);
-	GGEN_FINALLY(igraph_vector_ptr_destroy_all,&indexes);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
 
+	// use gsl to shuffle each order, and save the position of each vertex
 	for(i = 0; i < orders; i++)
 	{
-		// posets is used for permutation computations
-		// it should contain vertices
-		VECTOR(posets)[i] = calloc(1,sizeof(igraph_vector_t));
-		GGEN_CHECK_ALLOC(VECTOR(posets)[i]);
-		GGEN_CHECK_IGRAPH_VECTPTR(igraph_vector_init_seq(VECTOR(posets)[i],0,n-1),posets,i);
-
-		VECTOR(indexes)[i] = calloc(1,sizeof(igraph_vector_t));
-		GGEN_CHECK_ALLOC(VECTOR(indexes)[i]);
-		GGEN_CHECK_IGRAPH_VECTPTR(igraph_vector_init(VECTOR(indexes)[i],n),indexes,i);
-	}
-
-	// zero all structs
-	igraph_matrix_null(&m);
-	igraph_matrix_null(&edge_validity);
-
-	// use gsl to shuffle each poset
-	for( j = 0; j < orders; j++)
-	{
-		v = VECTOR(posets)[j];
-		GGEN_CHECK_GSL_DO(gsl_ran_shuffle(r,VECTOR(*v), n, sizeof(VECTOR(*v)[0])));
+		for(j = 0; j < n; j++)
+			VECTOR(perm)[j] = j;
+		if(n > 1)
+			GGEN_CHECK_GSL_DO(gsl_ran_shuffle(r,VECTOR(perm), n, sizeof(VECTOR(perm)[0])));
+		for(j = 0; j < n; j++)
+			VECTOR(pos)[i*n + VECTOR(perm)[j]] = j;
 	}
-	// index saves the indices of each vertex in each permutation
-	for( i = 0; i < orders; i++)
-		for( j = 0; j < n; j++)
-		{
-			v = VECTOR(posets)[i];
-			w = VECTOR(indexes)[i];
-			k = VECTOR(*v)[j];
-			VECTOR(*w)[k] = j;
-		}
 
-	// edge_validity count if an edge is in all permutations
-	for( i = 0; i < n; i++)
-		for( j = 0; j < n; j++)
-			for( k = 0; k < orders; k++)
-			{
-				v = VECTOR(indexes)[k];
-				if( VECTOR(*v)[i] < VECTOR(*v)[j])
-					igraph_matrix_set(&edge_validity,i,j,
-						igraph_matrix_e(&edge_validity,i,j)+1);
-			}
-
-	// if an edge is present in all permutations then add it to the graph
-	for( i = 0; i < n; i++)
-		for( j = 0; j < n; j++)
-			if(igraph_matrix_e(&edge_validity,i,j) == orders)
-				igraph_matrix_set(&m,i,j,1);
+	if(orders == 2)
+		GGEN_CHECK_INTERNAL_ERRNO(random_orders_sweep(n,&pos,&edges));
+	else if(orders <= RANDOM_ORDERS_BITSETS_MAX)
+		GGEN_CHECK_INTERNAL_ERRNO(random_orders_bitsets(n,orders,&pos,&edges));
+	else
+		GGEN_CHECK_INTERNAL_ERRNO(random_orders_filter(n,orders,&pos,&edges));
 
-	// translate the matrix to a graph
-	GGEN_CHECK_IGRAPH(igraph_adjacency(g,&m,IGRAPH_ADJ_DIRECTED));
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,n,1));
 
 	ggen_error_clean(1);
 	return g;
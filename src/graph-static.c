@@ -41,47 +41,317 @@
 * INRIA, Grenoble Universities.
 */
 
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+
 #include "ggen.h"
 #include "error.h"
+#include "graph-family.h"
 
 /**********************************************************
  * Utils
  *********************************************************/
 
-static inline unsigned long addtask(igraph_t *g)
+/* Static graphs are built in one go: their exact size is known beforehand,
+ * vertices get consecutive ids and edges are written into a preallocated
+ * edge list, given to igraph_create at the end.
+ */
+struct static_builder {
+	igraph_real_t *edges;
+	unsigned long vcount;
+	unsigned long ecount;
+};
+
+static inline unsigned long addtask(struct static_builder *b)
+{
+	return b->vcount++;
+}
+
+static inline void addedge(struct static_builder *b, unsigned long from,
+			   unsigned long to)
+{
+	b->edges[2*b->ecount] = from;
+	b->edges[2*b->ecount+1] = to;
+	b->ecount++;
+}
+
+/* Recursive graphs are built one subtree at a time. The size of any subtree is
+ * known in closed form, so a task reserves for each of its children a range
+ * of vertex ids and one of edge slots, in the order the recursive
+ * construction would have used: subtrees are then independent, and the graph
+ * does not depend on the order they are built in, nor on the number of
+ * threads.
+ */
+struct subtree {
+	unsigned long root;
+	unsigned long n;
+	/* vertices, root included, and edges of the subtree */
+	unsigned long vcount;
+	unsigned long ecount;
+	/* where the descendants of root go */
+	struct static_builder b;
+};
+
+struct subtree_list {
+	struct subtree *items;
+	unsigned long size;
+	unsigned long max;
+};
+
+static int subtree_push(struct subtree_list *l, const struct subtree *s)
+{
+	struct subtree *items;
+	if(l->size == l->max)
+	{
+		items = realloc(l->items,2*(l->max+8)*sizeof(struct subtree));
+		if(items == NULL)
+			return GGEN_ENOMEM;
+		l->items = items;
+		l->max = 2*(l->max+8);
+	}
+	l->items[l->size++] = *s;
+	return GGEN_SUCCESS;
+}
+
+static int subtree_pop(struct subtree_list *l, struct subtree *s)
+{
+	if(l->size == 0)
+		return 0;
+	*s = l->items[--l->size];
+	return 1;
+}
+
+static void subtree_list_destroy(struct subtree_list *l)
+{
+	free(l->items);
+}
+
+/* reserve the ranges of child, a subtree of child->vcount vertices and
+ * child->ecount edges rooted on root, right after the ones s already used.
+ * Returns the last vertex of child.
+ */
+static unsigned long subtree_reserve(struct subtree *s, unsigned long root,
+				     struct subtree *child)
+{
+	child->root = root;
+	child->b = s->b;
+	s->b.vcount += child->vcount - 1;
+	s->b.ecount += child->ecount;
+	return root + child->vcount - 1;
+}
+
+/* child is built later from stack, or by another thread from split if it is at
+ * most grain vertices.
+ */
+static int subtree_defer(const struct subtree *child, unsigned long grain,
+			 struct subtree_list *split, struct subtree_list *stack)
+{
+	if(split != NULL && child->vcount <= grain)
+		return subtree_push(split,child);
+	return subtree_push(stack,child);
+}
+
+/* builds a subtree, the children it does not build itself go to
+ * subtree_defer. Called from several threads: must not use the
+ * ggen error stack, returns GGEN_SUCCESS or a ggen error code.
+ */
+typedef int (*subtree_fn_t)(void *arg, struct subtree *s, unsigned long grain,
+			    struct subtree_list *split,
+			    struct subtree_list *stack);
+
+static int subtree_build(subtree_fn_t fn, void *arg, const struct subtree *s,
+			 unsigned long grain, struct subtree_list *split,
+			 struct subtree_list *stack)
+{
+	struct subtree t;
+	int status;
+
+	stack->size = 0;
+	status = subtree_push(stack,s);
+	while(status == GGEN_SUCCESS && subtree_pop(stack,&t))
+		status = fn(arg,&t,grain,split,stack);
+	return status;
+}
+
+/* subtrees waiting to be built, threads take them one at a time */
+struct subtree_pool {
+	subtree_fn_t fn;
+	void *arg;
+	struct subtree_list todo;
+	unsigned long next;
+};
+
+struct subtree_worker {
+	struct subtree_pool *pool;
+	struct subtree_list stack;
+	pthread_t thread;
+	int status;
+	int started;
+};
+
+static void *subtree_worker_run(void *data)
+{
+	struct subtree_worker *w = data;
+	struct subtree_pool *p = w->pool;
+	unsigned long i;
+	while(w->status == GGEN_SUCCESS &&
+	      (i = __sync_fetch_and_add(&p->next,1)) < p->todo.size)
+		w->status = subtree_build(p->fn,p->arg,&p->todo.items[i],0,
+					  NULL,&w->stack);
+	return NULL;
+}
+
+static void subtree_workers_free(struct subtree_worker *workers)
 {
-	unsigned long curtask = igraph_vcount(g);
-	igraph_add_vertices(g, 1, NULL);
-	return curtask;
+	unsigned long t;
+	for(t = 0; workers[t].pool != NULL; t++)
+		subtree_list_destroy(&workers[t].stack);
+	free(workers);
+}
+
+/* subtrees smaller than total/(SUBTREE_GRAIN*threads) are not split further */
+#define SUBTREE_GRAIN 16
+
+/* build the whole tree rooted on s. With several threads, the calling thread
+ * first splits it into small subtrees, which are then built in parallel: a
+ * thread done with one takes the next, which balances the load.
+ */
+static int subtree_run(subtree_fn_t fn, void *arg, const struct subtree *s)
+{
+	struct subtree_pool pool;
+	struct subtree_worker *workers;
+	struct subtree_list stack = { NULL, 0, 0 };
+	unsigned long t,nbt,grain;
+
+	ggen_error_start_stack();
+	GGEN_FINALLY(subtree_list_destroy,&stack);
+
+	pool.fn = fn;
+	pool.arg = arg;
+	pool.todo.items = NULL;
+	pool.todo.size = pool.todo.max = 0;
+	pool.next = 0;
+	GGEN_FINALLY(subtree_list_destroy,&pool.todo);
+
+	nbt = ggen_get_threads();
+	grain = s->vcount/(SUBTREE_GRAIN*nbt);
+	GGEN_CHECK_INTERNAL(subtree_build(fn,arg,s,grain,
+					  nbt > 1 ? &pool.todo : NULL,&stack));
+
+	if(nbt > pool.todo.size)
+		nbt = pool.todo.size > 0 ? pool.todo.size : 1;
+	// one more worker, zeroed, marks the end of the array
+	workers = calloc(nbt+1,sizeof(struct subtree_worker));
+	GGEN_CHECK_ALLOC(workers);
+	GGEN_FINALLY(subtree_workers_free,workers);
+	for(t = 0; t < nbt; t++)
+	{
+		workers[t].pool = &pool;
+		workers[t].status = GGEN_SUCCESS;
+	}
+
+	// the calling thread is the first worker, and replaces the ones no
+	// thread could be created for
+	for(t = 1; t < nbt; t++)
+		workers[t].started = !pthread_create(&workers[t].thread,NULL,
+						     subtree_worker_run,
+						     &workers[t]);
+	subtree_worker_run(&workers[0]);
+	for(t = 1; t < nbt; t++)
+		if(workers[t].started)
+			pthread_join(workers[t].thread,NULL);
+		else
+			subtree_worker_run(&workers[t]);
+	for(t = 0; t < nbt; t++)
+		GGEN_CHECK_INTERNAL(workers[t].status);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
 }
 
 /**********************************************************
  * Methods
  *********************************************************/
 
+/* Fibonacci: a task of value n <= max(1,cutoff) is a leaf, others have two
+ * children, of values n-1 and n-2. With W(n) = V(n) + 1, W(n) = W(n-1) +
+ * W(n-2) and W = 2 on leaves: V(n) = 2F(n-b+2) - 1, F being the fibonacci
+ * sequence and b = max(1,cutoff). The graph is a tree.
+ */
+int ggen_count_fibonacci(unsigned long n, unsigned long cutoff,
+			 unsigned long *vertices, unsigned long *edges)
+{
+	unsigned long b,k,f0,f1,t;
+
+	ggen_error_start_stack();
+	if(cutoff > n || vertices == NULL || edges == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	b = cutoff > 1 ? cutoff : 1;
+	// F(k) for k = n-b+2, the loop starts at F(1),F(2)
+	f0 = 1;
+	f1 = 1;
+	for(k = 2; n >= b && k < n-b+2; k++)
+	{
+		if(f1 > ULONG_MAX - f0)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		t = f0 + f1;
+		f0 = f1;
+		f1 = t;
+	}
+	if(n < b)
+		*vertices = 1;
+	else
+	{
+		if(f1 > (ULONG_MAX-1)/2)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		*vertices = 2*f1 - 1;
+	}
+	*edges = *vertices - 1;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+struct fibonacci_args {
+	unsigned long cutoff;
+	/* vertices in the subtree of a task, by value */
+	const unsigned long *sizes;
+	igraph_vector_t *values;
+};
 
 /* creates two subtasks, add the right edges to the graph */
-int _fibonacci_add_tasks(unsigned long n, unsigned long cutoff,
-			 unsigned long myid, igraph_t *g)
+static int fibonacci_add_tasks(void *arg, struct subtree *s,
+			       unsigned long grain, struct subtree_list *split,
+			       struct subtree_list *stack)
 {
-	unsigned long lastid;
-	SETVAN(g, "n", myid, n);
-	/* this task has already been created, or we got to the bottom */
-	if(n < 2 || n <= cutoff)
+	struct fibonacci_args *a = arg;
+	struct subtree child[2];
+	unsigned long lastid,i;
+	int err;
+
+	VECTOR(*a->values)[s->root] = s->n;
+	/* we got to the bottom */
+	if(s->n < 2 || s->n <= a->cutoff)
 		return GGEN_SUCCESS;
-	else
+	/* create our two subtasks, and link them to me */
+	lastid = addtask(&s->b);
+	addtask(&s->b);
+	addedge(&s->b, lastid, s->root);
+	addedge(&s->b, lastid+1, s->root);
+	for(i = 0; i < 2; i++)
 	{
-		/* create our two subtasks, and link them to me
-		 * we need to know the current number of vertices, to identify
-		 * which vertices id the new ones will have.
-		 */
-		lastid = igraph_vcount(g);
-		igraph_add_vertices(g,2,NULL);
-		igraph_add_edge(g, lastid, myid);
-		igraph_add_edge(g, lastid+1, myid);
-		_fibonacci_add_tasks(n-1, cutoff, lastid, g);
-		_fibonacci_add_tasks(n-2, cutoff, lastid+1, g);
+		child[i].n = s->n - 1 - i;
+		child[i].vcount = a->sizes[child[i].n];
+		child[i].ecount = child[i].vcount - 1;
+		subtree_reserve(s, lastid+i, &child[i]);
 	}
+	for(i = 0; i < 2; i++)
+		if((err = subtree_defer(&child[i], grain, split, stack)))
+			return err;
 	return GGEN_SUCCESS;
 }
 
@@ -94,27 +364,71 @@ int _fibonacci_add_tasks(unsigned long n, unsigned long cutoff,
 igraph_t *ggen_generate_fibonacci(unsigned long n, unsigned long cutoff)
 {
 	igraph_t *g = NULL;
+	igraph_vector_t edges,values;
+	struct fibonacci_args args;
+	struct subtree root;
+	unsigned long vcount,ecount,k,*sizes;
+	int err;
 
 	ggen_error_start_stack();
-	if(cutoff > n)
-		GGEN_SET_ERRNO(GGEN_EINVAL);
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_count_fibonacci(n,cutoff,&vcount,&ecount));
 
 	g = malloc(sizeof(igraph_t));
 	GGEN_CHECK_ALLOC(g);
 	GGEN_FINALLY3(free,g,1);
 
-	/* recursive creation: create a task, call the function, it will create
-	 * the right edges itself.
-	 */
-	GGEN_CHECK_IGRAPH(igraph_empty(g,1,1));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,2*ecount));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&values,vcount));
+	GGEN_FINALLY(igraph_vector_destroy,&values);
+
+	/* n is small: the count would overflow otherwise */
+	sizes = calloc(n+1,sizeof(unsigned long));
+	GGEN_CHECK_ALLOC(sizes);
+	GGEN_FINALLY(free,sizes);
+	for(k = 0; k <= n; k++)
+		sizes[k] = k < 2 || k <= cutoff ? 1 : 1 + sizes[k-1] + sizes[k-2];
+
+	args.cutoff = cutoff;
+	args.sizes = sizes;
+	args.values = &values;
+	root.root = 0;
+	root.n = n;
+	root.vcount = vcount;
+	root.ecount = ecount;
+	root.b.edges = VECTOR(edges);
+	root.b.vcount = 1;
+	root.b.ecount = 0;
+	GGEN_CHECK_INTERNAL_ERRNO(subtree_run(fibonacci_add_tasks,&args,&root));
+
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,vcount,1));
 	GGEN_FINALLY3(igraph_destroy,g,1);
-	GGEN_CHECK_INTERNAL(_fibonacci_add_tasks(n, cutoff, 0, g));
+	GGEN_CHECK_IGRAPH(SETVANV(g,"n",&values));
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
 	return NULL;
 }
 
+/* fork-join: 1 source, then for each phase diameter forks and 1 join. Each
+ * fork has an edge from the previous join and one to the next.
+ */
+int ggen_count_forkjoin(unsigned long phases, unsigned long diameter,
+			unsigned long *vertices, unsigned long *edges)
+{
+	ggen_error_start_stack();
+	if(vertices == NULL || edges == NULL || diameter > ULONG_MAX/2)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	if(count_madd(1,diameter+1,phases,vertices)
+	   || count_madd(0,2*diameter,phases,edges))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
 /* fork-join: generate a graph of multiple phases of fork-joins. All phases have
  * the same diameter (number of forks).
  */
@@ -122,21 +436,23 @@ igraph_t *ggen_generate_forkjoin(unsigned long phases, unsigned long diameter)
 {
 	igraph_t *g = NULL;
 	igraph_vector_t edges;
-	unsigned long numvertices, source, sink, i;
+	struct static_builder b;
+	unsigned long numvertices, numedges, source, sink, i;
+	int err;
 
 	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_count_forkjoin(phases,diameter,
+						      &numvertices,&numedges));
 
 	g = malloc(sizeof(igraph_t));
 	GGEN_CHECK_ALLOC(g);
 	GGEN_FINALLY3(free,g,1);
 
-	/* number of tasks: 1 source, for each phase diameter forks and 1 join.
-	 */
-	numvertices = 1 + (diameter+1)*phases;
-	GGEN_CHECK_IGRAPH(igraph_empty(g,numvertices,1));
-	GGEN_FINALLY3(igraph_destroy,g,1);
-
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges, 4*diameter));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,2*numedges));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	b.edges = VECTOR(edges);
+	b.vcount = numvertices;
+	b.ecount = 0;
 
 	/* iterate over the phases, adding the right edges at the time.
 	 * We stop once source points to the last sink.
@@ -146,13 +462,12 @@ igraph_t *ggen_generate_forkjoin(unsigned long phases, unsigned long diameter)
 		sink = source + diameter +1;
 		for(i = 0; i < diameter; i++)
 		{
-			VECTOR(edges)[4*i] = source;
-			VECTOR(edges)[4*i+1] = source + i +1;
-			VECTOR(edges)[4*i+2] = source + i +1;
-			VECTOR(edges)[4*i+3] = sink;
+			addedge(&b, source, source + i + 1);
+			addedge(&b, source + i + 1, sink);
 		}
-		GGEN_CHECK_IGRAPH(igraph_add_edges(g, &edges, NULL));
 	}
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,numvertices,1));
+	GGEN_FINALLY3(igraph_destroy,g,1);
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
@@ -160,157 +475,217 @@ ggen_error_label:
 
 }
 
+/* a level at depth d (the first one is at depth 1) recurses if
+ * size >> (d-1) > cutoff and d < depth. The shift stops at 0 <= cutoff at the
+ * latest.
+ */
+static unsigned long strassen_levels(unsigned long size, unsigned long depth,
+				     unsigned long cutoff)
+{
+	unsigned long levels;
+	for(levels = 0; (size >> levels) > cutoff && 1 + levels < depth; levels++);
+	return levels;
+}
 
-/* recursive part of strassen:
- * takes as input the last tasks to touch a and b.
+/* Strassen: a task recursing creates 8 tasks computing the S matrices, 7
+ * tasks recursing on a quadrant, 4 tasks accumulating into C and a taskwait.
+ * That is 14 + 7V' vertices and 42 + 7E' edges, V' and E' being the size of
+ * the next level. The last level is a single task.
  */
-long _strassen(unsigned long mytask, unsigned long size,
-	      unsigned long depth, unsigned long cutdepth, unsigned long cutseq,
-	      igraph_t *g)
+int ggen_count_strassen(unsigned long size, unsigned long depth,
+			unsigned long cutoff, unsigned long *vertices,
+			unsigned long *edges)
 {
-	unsigned long quadrant = size >> 1;
+	unsigned long levels,l,v,e;
+
+	ggen_error_start_stack();
+	if(vertices == NULL || edges == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	levels = strassen_levels(size,depth,cutoff);
+	v = 1;
+	e = 0;
+	for(l = 0; l < levels; l++)
+		if(count_madd(14,7,v,&v) || count_madd(42,7,e,&e))
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+	*vertices = v;
+	*edges = e;
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* kernel types of strassen tasks */
+enum {
+	STRASSEN, S1, S2, S3, S4, S5, S6, S7, S8, M2, M5, T1, C22, C, C12,
+	C21, C_INOUT, C12_INOUT, C21_INOUT, C22_INOUT, TASKWAIT
+};
+static const char *strassen_kernels[] = {
+	"strassen", "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "m2",
+	"m5", "t1", "c22", "c", "c12", "c21", "c_inout", "c12_inout",
+	"c21_inout", "c22_inout", "taskwait"
+};
+
+/* one level of strassen: the 7 tasks recursing on a quadrant are subtrees
+ * of (V-14)/7 vertices and (E-42)/7 edges, built after this level.
+ */
+static int _strassen(void *arg, struct subtree *s, unsigned long grain,
+		     struct subtree_list *split, struct subtree_list *stack)
+{
+	igraph_vector_t *kernel = arg;
+	struct static_builder *b = &s->b;
+	struct subtree child[7];
+	unsigned long mytask = s->root;
 	unsigned long c, c12, c21, c22;
-	unsigned long s1, s2, s3, s4, s5, s6, s7, s8, m2, m5, t1, task;
+	unsigned long s1, s2, s3, s4, s5, s6, s7, s8, m2, m5, t1, task, i;
+	int err;
+
+	VECTOR(*kernel)[mytask] = STRASSEN;
+	if(s->vcount == 1)
+		return GGEN_SUCCESS;
 
-	SETVAS(g, "kernel", mytask, "strassen");
-	if(size <= cutseq || depth >= cutdepth)
+	for(i = 0; i < 7; i++)
 	{
-		return mytask;
+		child[i].n = 0;
+		child[i].vcount = (s->vcount - 14)/7;
+		child[i].ecount = (s->ecount - 42)/7;
 	}
 
 	/* S1 compute: in a21 a22, out:s1 */
-	s1 = addtask(g);
-	SETVAS(g, "kernel", s1, "s1");
-	igraph_add_edge(g, mytask, s1);
+	s1 = addtask(b);
+	VECTOR(*kernel)[s1] = S1;
+	addedge(b, mytask, s1);
 
 	/* S2: in: s1  a, out: s2 */
-	s2 = addtask(g);
-	SETVAS(g, "kernel", s2, "s2");
-	igraph_add_edge(g, s1, s2);
-	igraph_add_edge(g, mytask, s2);
+	s2 = addtask(b);
+	VECTOR(*kernel)[s2] = S2;
+	addedge(b, s1, s2);
+	addedge(b, mytask, s2);
 
 	/* S4: in: a12 s2, out: s4 */
-	s4 = addtask(g);
-	SETVAS(g, "kernel", s4, "s4");
-	igraph_add_edge(g, s2, s4);
-	igraph_add_edge(g, mytask, s4);
+	s4 = addtask(b);
+	VECTOR(*kernel)[s4] = S4;
+	addedge(b, s2, s4);
+	addedge(b, mytask, s4);
 
 	/* S5: in: b12 b out: s5 */
-	s5 = addtask(g);
-	SETVAS(g, "kernel", s5, "s5");
-	igraph_add_edge(g, mytask, s5);
+	s5 = addtask(b);
+	VECTOR(*kernel)[s5] = S5;
+	addedge(b, mytask, s5);
 
 	/* S6: in: b22 s5 out: s6 */
-	s6 = addtask(g);
-	SETVAS(g, "kernel", s6, "s6");
-	igraph_add_edge(g, s5, s6);
-	igraph_add_edge(g, mytask, s6);
+	s6 = addtask(b);
+	VECTOR(*kernel)[s6] = S6;
+	addedge(b, s5, s6);
+	addedge(b, mytask, s6);
 
 	/* S8: in: s6 b21 out: s8 */
-	s8 = addtask(g);
-	SETVAS(g, "kernel", s8, "s8");
-	igraph_add_edge(g, s6, s8);
-	igraph_add_edge(g, mytask, s8);
+	s8 = addtask(b);
+	VECTOR(*kernel)[s8] = S8;
+	addedge(b, s6, s8);
+	addedge(b, mytask, s8);
 
 	/* S3: in: a a21 out: s3 */
-	s3 = addtask(g);
-	SETVAS(g, "kernel", s3, "s3");
-	igraph_add_edge(g, mytask, s3);
+	s3 = addtask(b);
+	VECTOR(*kernel)[s3] = S3;
+	addedge(b, mytask, s3);
 
 	/* S7: in: b22 b12 out: s7 */
-	s7 = addtask(g);
-	SETVAS(g, "kernel", s7, "s7");
-	igraph_add_edge(g, mytask, s7);
+	s7 = addtask(b);
+	VECTOR(*kernel)[s7] = S7;
+	addedge(b, mytask, s7);
+
+	/* the 7 tasks recursing are strassen tasks themselves, their subtrees
+	 * end on their own taskwait.
+	 */
 
 	/* M2: in a, b out: m2 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "m2");
-	igraph_add_edge(g, mytask, task);
-	m2 = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, mytask, task);
+	m2 = subtree_reserve(s, task, &child[0]);
 
 	/* M5: in: s1 s5 out: m5 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "m5");
-	igraph_add_edge(g, s1, task);
-	igraph_add_edge(g, s5, task);
-	m5 = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, s1, task);
+	addedge(b, s5, task);
+	m5 = subtree_reserve(s, task, &child[1]);
 
 	/* t1: in s2 s6 out: t1 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "t1");
-	igraph_add_edge(g, s2, task);
-	igraph_add_edge(g, s6, task);
-	t1 = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, s2, task);
+	addedge(b, s6, task);
+	t1 = subtree_reserve(s, task, &child[2]);
 
 	/* C22: in: s3 s7 out: c22 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c22");
-	igraph_add_edge(g, s3, task);
-	igraph_add_edge(g, s7, task);
-	c22 = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, s3, task);
+	addedge(b, s7, task);
+	c22 = subtree_reserve(s, task, &child[3]);
 
 	/* C: in: a12 b21 out: c */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c");
-	igraph_add_edge(g, mytask, task);
-	c = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, mytask, task);
+	c = subtree_reserve(s, task, &child[4]);
 
 	/* C12: in: s4 b22 out: c12 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c12");
-	igraph_add_edge(g, s4, task);
-	igraph_add_edge(g, mytask, task);
-	c12 = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, s4, task);
+	addedge(b, mytask, task);
+	c12 = subtree_reserve(s, task, &child[5]);
 
 	/* C21: in: a22 s8 out: c21 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c21");
-	igraph_add_edge(g, mytask, task);
-	igraph_add_edge(g, s8, task);
-	c21 = _strassen(task, quadrant, depth+1, cutdepth, cutseq, g);
+	task = addtask(b);
+	addedge(b, mytask, task);
+	addedge(b, s8, task);
+	c21 = subtree_reserve(s, task, &child[6]);
 
 	/* C: inout: C in: m2 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c_inout");
-	igraph_add_edge(g, c, task);
-	igraph_add_edge(g, m2, task);
+	task = addtask(b);
+	VECTOR(*kernel)[task] = C_INOUT;
+	addedge(b, c, task);
+	addedge(b, m2, task);
 	c = task;
 
 	/* C12: inout: c12 in: m5 t1 m2 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c12_inout");
-	igraph_add_edge(g, m5, task);
-	igraph_add_edge(g, t1, task);
-	igraph_add_edge(g, m2, task);
-	igraph_add_edge(g, c12, task);
+	task = addtask(b);
+	VECTOR(*kernel)[task] = C12_INOUT;
+	addedge(b, m5, task);
+	addedge(b, t1, task);
+	addedge(b, m2, task);
+	addedge(b, c12, task);
 	c12 = task;
 
 	/* C21: inout: c21 in: c22 t1 m2 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c21_inout");
-	igraph_add_edge(g, c22, task);
-	igraph_add_edge(g, t1, task);
-	igraph_add_edge(g, m2, task);
-	igraph_add_edge(g, c21, task);
+	task = addtask(b);
+	VECTOR(*kernel)[task] = C21_INOUT;
+	addedge(b, c22, task);
+	addedge(b, t1, task);
+	addedge(b, m2, task);
+	addedge(b, c21, task);
 	c21 = task;
 
 	/* C22: inout: c22 in: m5 t1 m2 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "c22_inout");
-	igraph_add_edge(g, m5, task);
-	igraph_add_edge(g, t1, task);
-	igraph_add_edge(g, m2, task);
-	igraph_add_edge(g, c22, task);
+	task = addtask(b);
+	VECTOR(*kernel)[task] = C22_INOUT;
+	addedge(b, m5, task);
+	addedge(b, t1, task);
+	addedge(b, m2, task);
+	addedge(b, c22, task);
 	c22 = task;
 
 	/* taskwait: c c12 c21 c22 */
-	task = addtask(g);
-	SETVAS(g, "kernel", task, "taskwait");
-	igraph_add_edge(g, c, task);
-	igraph_add_edge(g, c12, task);
-	igraph_add_edge(g, c21, task);
-	igraph_add_edge(g, c22, task);
-	return task;
+	task = addtask(b);
+	VECTOR(*kernel)[task] = TASKWAIT;
+	addedge(b, c, task);
+	addedge(b, c12, task);
+	addedge(b, c21, task);
+	addedge(b, c22, task);
+
+	for(i = 0; i < 7; i++)
+		if((err = subtree_defer(&child[i], grain, split, stack)))
+			return err;
+	return GGEN_SUCCESS;
 }
 
 /* Strassen: efficient matrix multiply, of size n*n.
@@ -322,21 +697,151 @@ igraph_t *ggen_generate_strassen(unsigned long n, unsigned long depth,
 				 unsigned long seq)
 {
 	igraph_t *g = NULL;
+	igraph_vector_t edges,kernel;
+	struct subtree root;
+	igraph_strvector_t names;
+	unsigned long vcount,ecount,i,k;
+	int err;
 
 	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_count_strassen(n,depth,seq,&vcount,&ecount));
 
 	g = malloc(sizeof(igraph_t));
 	GGEN_CHECK_ALLOC(g);
 	GGEN_FINALLY3(free,g,1);
 
-	GGEN_CHECK_IGRAPH(igraph_empty(g,1,1));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,2*ecount));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&kernel,vcount));
+	GGEN_FINALLY(igraph_vector_destroy,&kernel);
+
+	root.root = 0;
+	root.n = 0;
+	root.vcount = vcount;
+	root.ecount = ecount;
+	root.b.edges = VECTOR(edges);
+	root.b.vcount = 1;
+	root.b.ecount = 0;
+	GGEN_CHECK_INTERNAL_ERRNO(subtree_run(_strassen,&kernel,&root));
+
+	GGEN_CHECK_IGRAPH(igraph_create(g,&edges,vcount,1));
 	GGEN_FINALLY3(igraph_destroy,g,1);
+	k = sizeof(strassen_kernels)/sizeof(strassen_kernels[0]);
+	GGEN_CHECK_IGRAPH(igraph_strvector_init(&names,k));
+	GGEN_FINALLY(igraph_strvector_destroy,&names);
+	for(i = 0; i < k; i++)
+		GGEN_CHECK_IGRAPH(igraph_strvector_set(&names,i,strassen_kernels[i]));
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_set_kernels(g,&names,&kernel));
 
-	_strassen(0, n, 1, depth, seq, g);
-	
 	ggen_error_clean(1);
 	return g;
 ggen_error_label:
 	return NULL;
 
 }
+
+/**********************************************************
+ * Families
+ *********************************************************/
+
+/* Fibonacci: a longest path goes through all the values from b = max(1,cutoff)
+ * to n. The graph is a binary tree: its leaves are a longest antichain.
+ */
+int family_fibonacci(const unsigned long *params, struct ggen_family_metrics *m,
+		     igraph_strvector_t *kernels, igraph_vector_t *counts)
+{
+	unsigned long n = params[0], cutoff = params[1], b;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_count_fibonacci(n,cutoff,&m->vertices,
+						       &m->edges));
+	b = cutoff > 1 ? cutoff : 1;
+	m->critical_path = n < b ? 1 : n - b + 1;
+	m->width = (m->vertices + 1)/2;
+	if(kernels != NULL)
+		GGEN_CHECK_INTERNAL_ERRNO(family_kernels(kernels,counts,0));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* fork-join: a longest path goes through one fork of each phase, the forks of
+ * a phase are a longest antichain. Without forks, the joins are unrelated.
+ */
+int family_forkjoin(const unsigned long *params, struct ggen_family_metrics *m,
+		    igraph_strvector_t *kernels, igraph_vector_t *counts)
+{
+	unsigned long phases = params[0], diameter = params[1];
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_count_forkjoin(phases,diameter,
+						      &m->vertices,&m->edges));
+	if(phases == 0 || diameter == 0)
+	{
+		m->critical_path = 1;
+		m->width = m->vertices;
+	}
+	else
+	{
+		m->critical_path = 2*phases + 1;
+		m->width = diameter;
+	}
+	if(kernels != NULL)
+		GGEN_CHECK_INTERNAL_ERRNO(family_kernels(kernels,counts,0));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* Strassen: a level adds 6 tasks to the longest path of the level below (the
+ * task recursing, s1, s2, s4, c12_inout and the taskwait around c12). On the
+ * last level recursing, s3, s4, s7, s8 and the M tasks m2, m5, t1 and c form
+ * an antichain of 8, and 8 chains cover the level: the task, s1, s2, s4, c12
+ * and its inout and the taskwait; s5, s6, s8, c21 and its inout; s3, c22 and
+ * its inout; m2 and c_inout; s7, m5, t1 and c alone. Above it the 7
+ * subtrees are independent and each larger than the other tasks of a level.
+ */
+int family_strassen(const unsigned long *params, struct ggen_family_metrics *m,
+		    igraph_strvector_t *kernels, igraph_vector_t *counts)
+{
+	unsigned long size = params[0], depth = params[1], cutoff = params[2];
+	unsigned long levels,l,i,k,recursing,leaves;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_count_strassen(size,depth,cutoff,
+						      &m->vertices,&m->edges));
+	levels = strassen_levels(size,depth,cutoff);
+	m->critical_path = 1 + 6*levels;
+	m->width = 1;
+	recursing = 0;
+	leaves = 1;
+	for(l = 0; l < levels; l++)
+	{
+		m->width = l == 0 ? 8 : 7*m->width;
+		recursing = 1 + 7*recursing;
+		leaves *= 7;
+	}
+
+	if(kernels != NULL)
+	{
+		k = sizeof(strassen_kernels)/sizeof(strassen_kernels[0]);
+		GGEN_CHECK_INTERNAL_ERRNO(family_kernels(kernels,counts,k));
+		for(i = 0; i < k; i++)
+			GGEN_CHECK_IGRAPH(igraph_strvector_set(kernels,i,
+							       strassen_kernels[i]));
+		/* tasks recursing are strassen tasks, the others are created
+		 * once by each of them.
+		 */
+		for(i = 0; i < k; i++)
+			VECTOR(*counts)[i] = recursing;
+		for(i = M2; i <= C21; i++)
+			VECTOR(*counts)[i] = 0;
+		VECTOR(*counts)[STRASSEN] = recursing + leaves;
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
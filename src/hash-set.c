@@ -0,0 +1,111 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+/* A minimal hash set for the sampling of edges without replacement. Keys are
+ * stored shifted by one, so that a zeroed slot means empty. The table is kept
+ * at most half full, so that probe sequences stay short.
+ */
+
+#include <stdlib.h>
+#include "hash-set.h"
+#include "error.h"
+
+/* a 64 bits finalizer (from splitmix64), we need good mixing since keys are
+ * often consecutive integers */
+static inline uint64_t hash_set_mix(uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+int hash_set_init(hash_set_t *s, unsigned long n)
+{
+	unsigned long size = 16;
+	ggen_error_start_stack();
+	while(size < 2*n)
+		size *= 2;
+	s->size = size;
+	s->count = 0;
+	s->table = calloc(size,sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(s->table);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+void hash_set_free(hash_set_t *s)
+{
+	free(s->table);
+	s->table = NULL;
+}
+
+int hash_set_insert(hash_set_t *s, uint64_t key)
+{
+	unsigned long i = hash_set_mix(key) & (s->size - 1);
+	while(s->table[i] != 0)
+	{
+		if(s->table[i] == key + 1)
+			return 0;
+		i = (i + 1) & (s->size - 1);
+	}
+	s->table[i] = key + 1;
+	s->count++;
+	return 1;
+}
+
+int hash_set_contains(const hash_set_t *s, uint64_t key)
+{
+	unsigned long i = hash_set_mix(key) & (s->size - 1);
+	while(s->table[i] != 0)
+	{
+		if(s->table[i] == key + 1)
+			return 1;
+		i = (i + 1) & (s->size - 1);
+	}
+	return 0;
+}
@@ -35,6 +35,7 @@
 #define GGEN_CGRAPH_DEFAULT_VALUE ""
 #include <graphviz/cgraph.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "ggen.h"
@@ -64,6 +65,178 @@ char *ggen_vname(igraph_t *g, char *buf, unsigned long id)
 	}
 }
 
+/* Kernel types: the dictionary is a single string, each name followed by a
+ * comma, so that an empty dictionary and a single empty name differ.
+ */
+static int kernel_names_parse(const char *dict, igraph_strvector_t *names)
+{
+	const char *end;
+	char buf[GGEN_DEFAULT_NAME_SIZE];
+	size_t len;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_IGRAPH(igraph_strvector_resize(names, 0));
+	for(; (end = strchr(dict, ',')) != NULL; dict = end + 1)
+	{
+		len = end - dict;
+		if(len >= GGEN_DEFAULT_NAME_SIZE)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		memcpy(buf, dict, len);
+		buf[len] = '\0';
+		GGEN_CHECK_IGRAPH(igraph_strvector_add(names, buf));
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* names fit in the dictionary if they hold no comma and can be parsed back */
+static int kernel_names_valid(const igraph_strvector_t *names)
+{
+	unsigned long i;
+
+	for(i = 0; i < igraph_strvector_size(names); i++)
+		if(strchr(STR(*names,i),',') != NULL ||
+		   strlen(STR(*names,i)) >= GGEN_DEFAULT_NAME_SIZE)
+			return 0;
+	return 1;
+}
+
+/* whether a kernel type indexes one of size names, NaN included */
+static int kernel_type_valid(double type, unsigned long size)
+{
+	return type >= 0 && type < size;
+}
+
+/* type of a vertex attribute, -1 if it does not exist */
+static int vertex_attr_type(igraph_t *g, const char *attr, int *type)
+{
+	igraph_strvector_t vnames;
+	igraph_vector_t vtypes;
+	long i;
+
+	ggen_error_start_stack();
+	GGEN_CHECK_IGRAPH(igraph_strvector_init(&vnames,0));
+	GGEN_FINALLY(igraph_strvector_destroy,&vnames);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&vtypes,0));
+	GGEN_FINALLY(igraph_vector_destroy,&vtypes);
+	GGEN_CHECK_IGRAPH(igraph_cattribute_list(g,NULL,NULL,&vnames,&vtypes,
+						 NULL,NULL));
+	*type = -1;
+	for(i = 0; i < igraph_strvector_size(&vnames); i++)
+		if(!strcmp(STR(vnames,i),attr))
+			*type = VECTOR(vtypes)[i];
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int ggen_get_kernels(igraph_t *g, igraph_strvector_t *names,
+		     igraph_vector_t *types)
+{
+	unsigned long i, k, vcount;
+	int type;
+	const char *str;
+
+	ggen_error_start_stack();
+	if(g == NULL || names == NULL || types == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	vcount = igraph_vcount(g);
+
+	GGEN_CHECK_INTERNAL_ERRNO(vertex_attr_type(g,GGEN_KERNEL_ATTR,&type));
+	GGEN_CHECK_IGRAPH(igraph_strvector_resize(names,0));
+	GGEN_CHECK_IGRAPH(igraph_vector_resize(types,vcount));
+	if(type == IGRAPH_ATTRIBUTE_NUMERIC &&
+	   igraph_cattribute_has_attr(g,IGRAPH_ATTRIBUTE_GRAPH,
+				      GGEN_KERNEL_NAMES_ATTR))
+	{
+		GGEN_CHECK_INTERNAL_ERRNO(kernel_names_parse(
+				GAS(g,GGEN_KERNEL_NAMES_ATTR),names));
+		GGEN_CHECK_IGRAPH(VANV(g,GGEN_KERNEL_ATTR,types));
+		/* vertices added after the kernels were set have a NaN type */
+		for(i = 0; i < vcount; i++)
+			if(!kernel_type_valid(VECTOR(*types)[i],
+					      igraph_strvector_size(names)))
+				VECTOR(*types)[i] = -1;
+	}
+	else if(type == IGRAPH_ATTRIBUTE_STRING)
+	{
+		/* intern the names, there's only a handful of them. An empty
+		 * name is a vertex without kernel, as written by
+		 * ggen_write_graph */
+		for(i = 0; i < vcount; i++)
+		{
+			str = VAS(g,GGEN_KERNEL_ATTR,i);
+			if(str[0] == '\0')
+			{
+				VECTOR(*types)[i] = -1;
+				continue;
+			}
+			for(k = 0; k < igraph_strvector_size(names); k++)
+				if(!strcmp(STR(*names,k),str))
+					break;
+			if(k == igraph_strvector_size(names))
+				GGEN_CHECK_IGRAPH(igraph_strvector_add(names,str));
+			VECTOR(*types)[i] = k;
+		}
+	}
+	else
+		igraph_vector_fill(types,-1);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int ggen_set_kernels(igraph_t *g, const igraph_strvector_t *names,
+		     const igraph_vector_t *types)
+{
+	char *dict = NULL, *p;
+	size_t size = 1, len;
+	unsigned long i;
+	int type;
+
+	ggen_error_start_stack();
+	if(g == NULL || names == NULL || types == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	if(igraph_vector_size(types) != igraph_vcount(g))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+	for(i = 0; i < igraph_vector_size(types); i++)
+		if(VECTOR(*types)[i] != -1 &&
+		   !kernel_type_valid(VECTOR(*types)[i],
+				      igraph_strvector_size(names)))
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+	if(!kernel_names_valid(names))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	for(i = 0; i < igraph_strvector_size(names); i++)
+		size += strlen(STR(*names,i)) + 1;
+	dict = malloc(size);
+	GGEN_CHECK_ALLOC(dict);
+	GGEN_FINALLY(free,dict);
+	for(i = 0, p = dict; i < igraph_strvector_size(names); i++)
+	{
+		len = strlen(STR(*names,i));
+		memcpy(p,STR(*names,i),len);
+		p += len;
+		*p++ = ',';
+	}
+	*p = '\0';
+
+	/* a kernel attribute read from a file is a string one */
+	GGEN_CHECK_INTERNAL_ERRNO(vertex_attr_type(g,GGEN_KERNEL_ATTR,&type));
+	if(type == IGRAPH_ATTRIBUTE_STRING)
+		DELVA(g,GGEN_KERNEL_ATTR);
+	GGEN_CHECK_IGRAPH(SETGAS(g,GGEN_KERNEL_NAMES_ATTR,dict));
+	GGEN_CHECK_IGRAPH(SETVANV(g,GGEN_KERNEL_ATTR,types));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
 /* find an id in an array */
 static int find_id(unsigned long *ret, unsigned long id, igraph_vector_t v, 
 		unsigned long size)
@@ -93,6 +266,8 @@ int ggen_read_graph(igraph_t *g, FILE *input)
 	unsigned long from, to;
 	igraph_integer_t eid;
 	Agsym_t *att;
+	igraph_strvector_t knames;
+	igraph_vector_t ktypes;
 
 	ggen_error_start_stack();
 	if(g == NULL)
@@ -167,6 +342,20 @@ int ggen_read_graph(igraph_t *g, FILE *input)
 			SETVAS(g,GGEN_VERTEX_NAME_ATTR,from,agnameof(v));
 	}
 
+	/* kernel types are kept interned in memory, unless their names do
+	 * not fit in the dictionary: they then stay a string attribute */
+	if(igraph_cattribute_has_attr(g,IGRAPH_ATTRIBUTE_VERTEX,GGEN_KERNEL_ATTR))
+	{
+		GGEN_CHECK_IGRAPH(igraph_strvector_init(&knames,0));
+		GGEN_FINALLY(igraph_strvector_destroy,&knames);
+		GGEN_CHECK_IGRAPH(igraph_vector_init(&ktypes,0));
+		GGEN_FINALLY(igraph_vector_destroy,&ktypes);
+		GGEN_CHECK_INTERNAL_ERRNO(ggen_get_kernels(g,&knames,&ktypes));
+		if(kernel_names_valid(&knames))
+			GGEN_CHECK_INTERNAL_ERRNO(ggen_set_kernels(g,&knames,
+								   &ktypes));
+	}
+
 
 	/* read edges properties */
 	att = agnxtattr(cg,AGEDGE,NULL);
@@ -203,6 +392,7 @@ int ggen_write_graph(igraph_t *g, FILE *output)
 	int err;
 	unsigned long i,j;
 	unsigned long vcount;
+	double k;
 	igraph_integer_t from,to;
 	char name[GGEN_DEFAULT_NAME_SIZE];
 	char *str = NULL;
@@ -210,6 +400,8 @@ int ggen_write_graph(igraph_t *g, FILE *output)
 	igraph_vector_t gtypes,vtypes,etypes;
 	Agsym_t *attr;
 	igraph_bool_t hasattr;
+	igraph_strvector_t knames;
+	int interned = 0;
 
 	ggen_error_start_stack();
 	if(g == NULL)
@@ -279,7 +471,8 @@ int ggen_write_graph(igraph_t *g, FILE *output)
 	/* add graph properties */
 	for(i = 0; i < igraph_strvector_size(&gnames); i++)
 	{
-		if(strcmp(GGEN_GRAPH_NAME_ATTR,STR(gnames,i)))
+		if(strcmp(GGEN_GRAPH_NAME_ATTR,STR(gnames,i)) &&
+		   strcmp(GGEN_KERNEL_NAMES_ATTR,STR(gnames,i)))
 		{
 			if(VECTOR(gtypes)[i]==IGRAPH_ATTRIBUTE_NUMERIC) {
 				snprintf(name,GGEN_DEFAULT_NAME_SIZE,"%g",
@@ -292,6 +485,17 @@ int ggen_write_graph(igraph_t *g, FILE *output)
 		}
 	}
 
+	/* interned kernel types are written with their names */
+	GGEN_CHECK_IGRAPH(igraph_strvector_init(&knames,0));
+	GGEN_FINALLY(igraph_strvector_destroy,&knames);
+	if(igraph_cattribute_has_attr(g,IGRAPH_ATTRIBUTE_GRAPH,
+				      GGEN_KERNEL_NAMES_ATTR))
+	{
+		GGEN_CHECK_INTERNAL_ERRNO(kernel_names_parse(
+				GAS(g,GGEN_KERNEL_NAMES_ATTR),&knames));
+		interned = 1;
+	}
+
 	/* add vertex properties */
 	for(i = 0; i < igraph_strvector_size(&vnames); i++)
 	{
@@ -302,7 +506,16 @@ int ggen_write_graph(igraph_t *g, FILE *output)
 			for(j = 0; j < vcount; j++)
 			{
 				f = (Agnode_t *) VECTOR(vertices)[j];
-				if(VECTOR(vtypes)[i]==IGRAPH_ATTRIBUTE_NUMERIC) {
+				if(interned && VECTOR(vtypes)[i]==IGRAPH_ATTRIBUTE_NUMERIC &&
+				   !strcmp(GGEN_KERNEL_ATTR,STR(vnames,i))) {
+					/* vertices without kernel are empty */
+					k = VAN(g,GGEN_KERNEL_ATTR,j);
+					if(kernel_type_valid(k,igraph_strvector_size(&knames)))
+						agxset(f,attr,(char *)STR(knames,(long)k));
+					else
+						agxset(f,attr,"");
+				}
+				else if(VECTOR(vtypes)[i]==IGRAPH_ATTRIBUTE_NUMERIC) {
 					snprintf(name,GGEN_DEFAULT_NAME_SIZE,"%g",
 							(double)VAN(g,STR(vnames,i),j));
 					agxset(f,attr,name);
@@ -0,0 +1,172 @@
+/* Copyright Swann Perarnau 2009
+*
+*   contact : swann.perarnau@imag.fr
+*
+* This software is a computer program whose purpose is to help the
+* random generation of graph structures and adding various properties
+* on those structures.
+*
+* This software is governed by the CeCILL  license under French law and
+* abiding by the rules of distribution of free software.  You can  use,
+* modify and/ or redistribute the software under the terms of the CeCILL
+* license as circulated by CEA, CNRS and INRIA at the following URL
+* "http://www.cecill.info".
+*
+* As a counterpart to the access to the source code and  rights to copy,
+* modify and redistribute granted by the license, users are provided only
+* with a limited warranty  and the software's author,  the holder of the
+* economic rights,  and the successive licensors  have only  limited
+* liability.
+*
+* In this respect, the user's attention is drawn to the risks associated
+* with loading,  using,  modifying and/or developing or reproducing the
+* software by the user in light of its specific status of free software,
+* that may mean  that it is complicated to manipulate,  and  that  also
+* therefore means  that it is reserved for developers  and  experienced
+* professionals having in-depth computer knowledge. Users are therefore
+* encouraged to load and test the software's suitability as regards their
+* requirements in conditions enabling the security of their systems and/or
+* data to be ensured and,  more generally, to use and operate it in the
+* same conditions as regards security.
+*
+* The fact that you are presently reading this means that you have had
+* knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* GGen is a random graph generator :
+* it provides means to generate a graph following a
+* collection of methods found in the litterature.
+*
+* This is a research project founded by the MOAIS Team,
+* INRIA, Grenoble Universities.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ggen.h"
+#include "error.h"
+
+/* Operation counts are the usual ones of the LAPACK/BLAS kernels on b*b
+ * blocks, every task sending its output block. Strassen tasks are counted as
+ * if they all worked on blocks of the same size: the S and C tasks add
+ * blocks, the M, T and recursing tasks multiply them. Poisson2d tasks work on
+ * rows of the grid.
+ */
+const struct ggen_kernel_cost ggen_kernel_costs[] = {
+	/* cholesky */
+	{ "potrf", 1.0/3.0, 3, 1.0, 2 },
+	{ "trsm", 1.0, 3, 1.0, 2 },
+	{ "syrk", 1.0, 3, 1.0, 2 },
+	{ "gemm", 2.0, 3, 1.0, 2 },
+	/* dense and sparse lu */
+	{ "lu", 2.0/3.0, 3, 1.0, 2 },
+	{ "fwd", 1.0, 3, 1.0, 2 },
+	{ "bdiv", 1.0, 3, 1.0, 2 },
+	{ "bmod", 2.0, 3, 1.0, 2 },
+	/* poisson2d */
+	{ "copy", 1.0, 1, 1.0, 1 },
+	{ "apply", 5.0, 1, 1.0, 1 },
+	/* strassen */
+	{ "strassen", 2.0, 3, 1.0, 2 },
+	{ "s1", 1.0, 2, 1.0, 2 },
+	{ "s2", 1.0, 2, 1.0, 2 },
+	{ "s3", 1.0, 2, 1.0, 2 },
+	{ "s4", 1.0, 2, 1.0, 2 },
+	{ "s5", 1.0, 2, 1.0, 2 },
+	{ "s6", 1.0, 2, 1.0, 2 },
+	{ "s7", 1.0, 2, 1.0, 2 },
+	{ "s8", 1.0, 2, 1.0, 2 },
+	{ "m2", 2.0, 3, 1.0, 2 },
+	{ "m5", 2.0, 3, 1.0, 2 },
+	{ "t1", 2.0, 3, 1.0, 2 },
+	{ "c", 1.0, 2, 1.0, 2 },
+	{ "c12", 1.0, 2, 1.0, 2 },
+	{ "c21", 1.0, 2, 1.0, 2 },
+	{ "c22", 1.0, 2, 1.0, 2 },
+	{ "c_inout", 1.0, 2, 1.0, 2 },
+	{ "c12_inout", 3.0, 2, 1.0, 2 },
+	{ "c21_inout", 3.0, 2, 1.0, 2 },
+	{ "c22_inout", 3.0, 2, 1.0, 2 },
+	{ "taskwait", 0.0, 0, 0.0, 0 },
+};
+const unsigned long ggen_kernel_costs_size =
+	sizeof(ggen_kernel_costs)/sizeof(ggen_kernel_costs[0]);
+
+static const struct ggen_kernel_cost *find_cost(const char *name,
+		const struct ggen_kernel_cost *table, unsigned long n)
+{
+	unsigned long i;
+	for(i = 0; i < n; i++)
+		if(!strcmp(table[i].name,name))
+			return &table[i];
+	for(i = 0; i < ggen_kernel_costs_size; i++)
+		if(!strcmp(ggen_kernel_costs[i].name,name))
+			return &ggen_kernel_costs[i];
+	return NULL;
+}
+
+/* costs are computed once per kernel type, then spread over the vertices and
+ * edges by their type: the attributes are set in one call each.
+ */
+int ggen_set_costs(igraph_t *g, unsigned long b,
+		   const struct ggen_kernel_cost *table, unsigned long n)
+{
+	const struct ggen_kernel_cost *c;
+	igraph_strvector_t names;
+	igraph_vector_t types,kcomp,kcomm,cost,comm,edges;
+	unsigned long i,k,v;
+
+	ggen_error_start_stack();
+	if(g == NULL || (table == NULL && n != 0))
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_IGRAPH(igraph_strvector_init(&names,0));
+	GGEN_FINALLY(igraph_strvector_destroy,&names);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&types,0));
+	GGEN_FINALLY(igraph_vector_destroy,&types);
+	GGEN_CHECK_INTERNAL_ERRNO(ggen_get_kernels(g,&names,&types));
+	k = igraph_strvector_size(&names);
+	if(k == 0 && igraph_vcount(g) > 0)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&kcomp,k));
+	GGEN_FINALLY(igraph_vector_destroy,&kcomp);
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&kcomm,k));
+	GGEN_FINALLY(igraph_vector_destroy,&kcomm);
+	for(i = 0; i < k; i++)
+	{
+		c = find_cost(STR(names,i),table,n);
+		if(c == NULL)
+			GGEN_SET_ERRNO(GGEN_EINVAL);
+		VECTOR(kcomp)[i] = c->comp * pow(b,c->comp_exp);
+		VECTOR(kcomm)[i] = c->comm * pow(b,c->comm_exp);
+	}
+
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&cost,igraph_vcount(g)));
+	GGEN_FINALLY(igraph_vector_destroy,&cost);
+	/* tasks without a kernel, like added sources and sinks, are free */
+	for(i = 0; i < igraph_vcount(g); i++)
+		if(VECTOR(types)[i] >= 0)
+			VECTOR(cost)[i] = VECTOR(kcomp)[(long)VECTOR(types)[i]];
+
+	/* an edge carries the output of its source */
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&edges,0));
+	GGEN_FINALLY(igraph_vector_destroy,&edges);
+	GGEN_CHECK_IGRAPH(igraph_get_edgelist(g,&edges,0));
+	GGEN_CHECK_IGRAPH(igraph_vector_init(&comm,igraph_ecount(g)));
+	GGEN_FINALLY(igraph_vector_destroy,&comm);
+	for(i = 0; i < igraph_ecount(g); i++)
+	{
+		v = VECTOR(edges)[2*i];
+		if(VECTOR(types)[v] >= 0)
+			VECTOR(comm)[i] = VECTOR(kcomm)[(long)VECTOR(types)[v]];
+	}
+
+	GGEN_CHECK_IGRAPH(SETVANV(g,GGEN_COST_ATTR,&cost));
+	GGEN_CHECK_IGRAPH(SETEANV(g,GGEN_COMM_ATTR,&comm));
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
@@ -0,0 +1,428 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+/* Reachability of DAGs as bit matrices, and the matching behind Dilworth's
+ * theorem on top of them: a longest antichain is found without building the
+ * transitive closure of the graph nor the bipartite graph of the matching.
+ * See:
+ * https://en.wikipedia.org/wiki/Dilworth%27s_theorem
+ * http://en.wikipedia.org/wiki/K%C3%B6nig%27s_theorem_%28graph_theory%29
+ * http://en.wikipedia.org/wiki/Hopcroft%E2%80%93Karp_algorithm
+ */
+
+#include <stdlib.h>
+#include "reachability.h"
+#include "error.h"
+
+#define BIT(v) ((uint64_t)1 << ((v)%64))
+
+static inline int lowest_bit(uint64_t x)
+{
+#ifdef __GNUC__
+	return __builtin_ctzll(x);
+#else
+	int i = 0;
+	while(!(x & 1))
+	{
+		x >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+/* set the n first bits of a row, clear the others */
+static void row_fill(uint64_t *row, size_t words, int32_t n)
+{
+	size_t k;
+
+	for(k = 0; k < words; k++)
+		row[k] = ~(uint64_t)0;
+	if(n % 64)
+		row[words-1] = BIT(n) - 1;
+}
+
+int reach_init(reach_t *r, const csr_t *c, const int32_t *order)
+{
+	int32_t u,v,i;
+	uint64_t *row,*vrow;
+	int64_t j;
+	size_t k;
+
+	ggen_error_start_stack();
+	if(r == NULL || c == NULL || order == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	r->vcount = c->vcount;
+	r->words = ((size_t)c->vcount + 63)/64;
+	r->rows = calloc(r->vcount*r->words + 1,sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(r->rows);
+
+	/* the successors of a vertex are done before it: its row is the union
+	 * of theirs and of the successors themselves.
+	 */
+	for(i = c->vcount - 1; i >= 0; i--)
+	{
+		u = order[i];
+		row = REACH_ROW(r,u);
+		for(j = c->out_offsets[u]; j < c->out_offsets[u+1]; j++)
+		{
+			v = c->out_targets[j];
+			/* already reached through another successor, which
+			 * reaches everything v does */
+			if(REACH_TEST(r,u,v))
+				continue;
+			vrow = REACH_ROW(r,v);
+			for(k = 0; k < r->words; k++)
+				row[k] |= vrow[k];
+			row[v/64] |= BIT(v);
+		}
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+void reach_free(reach_t *r)
+{
+	free(r->rows);
+}
+
+/* Hopcroft-Karp: each phase computes the layers of the shortest augmenting
+ * paths with a bfs from the free left vertices, then augments along as many
+ * vertex disjoint paths of this length as possible. A set bit in avail is a
+ * right vertex not yet visited in the current pass, so that each row is
+ * scanned once per bfs. The right vertices of each layer are then listed as
+ * the words holding their bits, the dfs only reading those words of the rows:
+ * it never meets the edges leaving the layers, most of them in a closure.
+ */
+int reach_maximum_matching(const reach_t *r, int32_t *match_left,
+			   int32_t *match_right)
+{
+	int32_t *dist,*layer,*queue,*loff,*lw,*su,*sv,*sk;
+	int32_t n,u,v,w,d,i,e,head,tail,limit;
+	size_t k,words;
+	uint64_t *avail,*lm,*srem,*row,x;
+
+	ggen_error_start_stack();
+	if(r == NULL || match_left == NULL || match_right == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	n = r->vcount;
+	words = r->words;
+	dist = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(dist);
+	GGEN_FINALLY(free,dist);
+	layer = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(layer);
+	GGEN_FINALLY(free,layer);
+	queue = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(queue);
+	GGEN_FINALLY(free,queue);
+	loff = malloc((n+2)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(loff);
+	GGEN_FINALLY(free,loff);
+	lw = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(lw);
+	GGEN_FINALLY(free,lw);
+	lm = malloc((n+1)*sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(lm);
+	GGEN_FINALLY(free,lm);
+	su = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(su);
+	GGEN_FINALLY(free,su);
+	sv = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(sv);
+	GGEN_FINALLY(free,sv);
+	sk = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(sk);
+	GGEN_FINALLY(free,sk);
+	srem = malloc((n+1)*sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(srem);
+	GGEN_FINALLY(free,srem);
+	avail = malloc((words+1)*sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(avail);
+	GGEN_FINALLY(free,avail);
+
+	/* greedy start: each vertex takes its first free successor */
+	row_fill(avail,words,n);
+	for(u = 0; u < n; u++)
+	{
+		match_left[u] = -1;
+		match_right[u] = -1;
+	}
+	for(u = 0; u < n; u++)
+	{
+		row = REACH_ROW(r,u);
+		for(k = 0; k < words; k++)
+			if((x = row[k] & avail[k]))
+			{
+				v = k*64 + lowest_bit(x);
+				avail[k] &= ~BIT(v);
+				match_left[u] = v;
+				match_right[v] = u;
+				break;
+			}
+	}
+
+	while(1)
+	{
+		/* layers: free left vertices are at 0, the left vertex matched
+		 * to a right one reached from layer d is at d+1, the right one
+		 * being in layer[] at d. limit is the layer of the first free
+		 * right vertices reached.
+		 */
+		row_fill(avail,words,n);
+		limit = -1;
+		for(u = 0, tail = 0; u < n; u++)
+		{
+			layer[u] = -1;
+			if(match_left[u] == -1)
+			{
+				dist[u] = 0;
+				queue[tail++] = u;
+			}
+			else
+				dist[u] = -1;
+		}
+		for(head = 0; head < tail; head++)
+		{
+			u = queue[head];
+			if(limit != -1 && dist[u] >= limit)
+				break;
+			row = REACH_ROW(r,u);
+			for(k = 0; k < words; k++)
+				for(x = row[k] & avail[k]; x; x &= x - 1)
+				{
+					v = k*64 + lowest_bit(x);
+					avail[k] &= ~BIT(v);
+					layer[v] = dist[u];
+					w = match_right[v];
+					if(w == -1)
+					{
+						if(limit == -1)
+							limit = dist[u] + 1;
+					}
+					else if(dist[w] == -1)
+					{
+						dist[w] = dist[u] + 1;
+						queue[tail++] = w;
+					}
+				}
+		}
+		if(limit == -1)
+			break;
+
+		/* the right vertices a path can go through: the matched ones
+		 * before the last layer, the free ones in it. They are sorted
+		 * by layer into queue, then packed into words: layer d is the
+		 * bits lm[i] of the words lw[i], for i in loff[d] to
+		 * loff[d+1]-1.
+		 */
+		for(d = 0; d <= limit; d++)
+			loff[d] = 0;
+		for(v = 0; v < n; v++)
+		{
+			if(layer[v] == -1 || (match_right[v] == -1) !=
+			   (layer[v] == limit - 1))
+				layer[v] = -1;
+			else
+				loff[layer[v]+1]++;
+		}
+		for(d = 0; d < limit; d++)
+			loff[d+1] += loff[d];
+		for(d = 0; d < limit; d++)
+			su[d] = loff[d];
+		for(v = 0; v < n; v++)
+			if(layer[v] != -1)
+				queue[su[layer[v]]++] = v;
+		for(d = 0, e = 0; d < limit; d++)
+		{
+			i = loff[d];
+			loff[d] = e;
+			for(; i < su[d]; i++)
+			{
+				v = queue[i];
+				if(e == loff[d] || lw[e-1] != v/64)
+				{
+					lw[e] = v/64;
+					lm[e++] = 0;
+				}
+				lm[e-1] |= BIT(v);
+			}
+		}
+		loff[limit] = e;
+
+		/* augmenting paths, by an iterative dfs along the layers:
+		 * level d of the stack is the left vertex su[d], the words of
+		 * its layer being scanned up to sk[d] with the bits srem[d]
+		 * left, and sv[d] the right vertex the path goes through.
+		 * Vertices leading nowhere are taken out of the layers.
+		 */
+		row_fill(avail,words,n);
+		for(u = 0; u < n; u++)
+		{
+			if(match_left[u] != -1)
+				continue;
+			d = 0;
+			su[0] = u;
+			sk[0] = loff[0];
+			srem[0] = 0;
+			while(d >= 0)
+			{
+				w = su[d];
+				if(srem[d] == 0)
+				{
+					if(sk[d] >= loff[dist[w]+1])
+					{
+						dist[w] = -1;
+						d--;
+					}
+					else
+					{
+						k = lw[sk[d]];
+						srem[d] = REACH_ROW(r,w)[k] &
+							avail[k] & lm[sk[d]];
+						sk[d]++;
+					}
+					continue;
+				}
+				v = lw[sk[d]-1]*64 + lowest_bit(srem[d]);
+				srem[d] &= srem[d] - 1;
+				/* taken by a deeper level */
+				if(!(avail[v/64] & BIT(v)))
+					continue;
+				avail[v/64] &= ~BIT(v);
+				sv[d] = v;
+				if(match_right[v] == -1)
+				{
+					for(i = 0; i <= d; i++)
+					{
+						match_left[su[i]] = sv[i];
+						match_right[sv[i]] = su[i];
+					}
+					break;
+				}
+				d++;
+				su[d] = match_right[v];
+				sk[d] = loff[dist[su[d]]];
+				srem[d] = 0;
+			}
+		}
+	}
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+/* König: Z is the set of vertices reachable from the free left vertices by
+ * alternating paths, unmatched edges going left to right and matched ones
+ * right to left. The minimum vertex cover is (L - Z) + (R inter Z), so a
+ * vertex is in neither of its sides iff its left copy is in Z and its right
+ * copy is not.
+ */
+int reach_antichain(const reach_t *r, const int32_t *match_left,
+		    const int32_t *match_right, igraph_vector_t *res)
+{
+	int32_t *queue,n,u,v,w,head,tail;
+	char *left;
+	size_t k,words;
+	uint64_t *avail,*row,x;
+
+	ggen_error_start_stack();
+	if(r == NULL || match_left == NULL || match_right == NULL ||
+	   res == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	n = r->vcount;
+	words = r->words;
+	queue = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(queue);
+	GGEN_FINALLY(free,queue);
+	left = calloc(n+1,sizeof(char));
+	GGEN_CHECK_ALLOC(left);
+	GGEN_FINALLY(free,left);
+	avail = malloc((words+1)*sizeof(uint64_t));
+	GGEN_CHECK_ALLOC(avail);
+	GGEN_FINALLY(free,avail);
+
+	row_fill(avail,words,n);
+	for(u = 0, tail = 0; u < n; u++)
+		if(match_left[u] == -1)
+		{
+			left[u] = 1;
+			queue[tail++] = u;
+		}
+	for(head = 0; head < tail; head++)
+	{
+		row = REACH_ROW(r,queue[head]);
+		for(k = 0; k < words; k++)
+			for(x = row[k] & avail[k]; x; x &= x - 1)
+			{
+				v = k*64 + lowest_bit(x);
+				avail[k] &= ~BIT(v);
+				/* free right vertices here would mean the
+				 * matching is not maximum */
+				w = match_right[v];
+				if(w == -1)
+					GGEN_SET_ERRNO(GGEN_EINVAL);
+				if(!left[w])
+				{
+					left[w] = 1;
+					queue[tail++] = w;
+				}
+			}
+	}
+
+	igraph_vector_clear(res);
+	for(u = 0; u < n; u++)
+		if(left[u] && (avail[u/64] & BIT(u)))
+			GGEN_CHECK_IGRAPH(igraph_vector_push_back(res,u));
+
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
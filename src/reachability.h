@@ -0,0 +1,89 @@
+/* Copyright Swann Perarnau 2013
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+
+#ifndef REACHABILITY_H
+#define REACHABILITY_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include "csr.h"
+
+/* The reachability relation of a DAG, as one row of vcount bits per vertex:
+ * bit v of the row of u is set iff there is a path of at least one edge from
+ * u to v. The whole relation takes vcount^2/8 bytes.
+ */
+typedef struct {
+	int32_t vcount;
+	size_t words;
+	uint64_t *rows;
+} reach_t;
+
+/* build the relation of the snapshot c, order being a topological order of
+ * it, as given by csr_topological_order. O(V + E*V/64).
+ */
+int reach_init(reach_t *r, const csr_t *c, const int32_t *order);
+
+void reach_free(reach_t *r);
+
+#define REACH_ROW(r,u) ((r)->rows + (size_t)(u)*(r)->words)
+#define REACH_TEST(r,u,v) ((REACH_ROW(r,u)[(v)/64] >> ((v)%64)) & 1)
+
+/* Maximum matching of the bipartite graph with a copy of each vertex on both
+ * sides, u on the left being adjacent to v on the right iff u reaches v. The
+ * edges of this graph are never built, they are read from the rows.
+ * match_left[u] is the vertex matched to the left copy of u, -1 if none, and
+ * match_right[v] the one matched to the right copy of v. Both are arrays of
+ * vcount vertices.
+ */
+int reach_maximum_matching(const reach_t *r, int32_t *match_left,
+			   int32_t *match_right);
+
+/* the vertices outside of the minimum vertex cover given by a maximum
+ * matching (König's theorem) on both sides: a longest antichain, in
+ * increasing order.
+ */
+int reach_antichain(const reach_t *r, const int32_t *match_left,
+		    const int32_t *match_right, igraph_vector_t *res);
+
+#endif
@@ -0,0 +1,180 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : firstname.lastname@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+/* GGen is a random graph generator :
+ * it provides means to generate a graph following a
+ * collection of methods found in the litterature.
+ *
+ * This is a research project founded by the MOAIS Team,
+ * INRIA, Grenoble Universities.
+ */
+/* Philox4x32-10 counter based random number generator (J. Salmon et al.,
+ * Parallel random numbers: as easy as 1, 2, 3, SC'11), wrapped as a GSL
+ * generator type.
+ * Each block of 4 numbers is a pure function of the key (the seed) and of a
+ * 128 bits counter, made of a 64 bits stream id and a 64 bits position in that
+ * stream. Any part of any stream can thus be reached directly, and independent
+ * streams can be given to independent computations.
+ */
+
+#include <stdint.h>
+#include "ggen.h"
+#include "error.h"
+#include "rng-philox.h"
+
+#define PHILOX_M0 UINT32_C(0xD2511F53)
+#define PHILOX_M1 UINT32_C(0xCD9E8D57)
+#define PHILOX_W0 UINT32_C(0x9E3779B9)
+#define PHILOX_W1 UINT32_C(0xBB67AE85)
+
+/* this struct is also the format of rng state files */
+typedef struct {
+	uint32_t key[2];
+	// position low, position high, stream low, stream high
+	uint32_t ctr[4];
+	uint32_t out[4];
+	unsigned int idx;
+} philox_state_t;
+
+static inline void philox_round(uint32_t c[4], const uint32_t k[2])
+{
+	uint64_t p0 = (uint64_t)PHILOX_M0 * c[0];
+	uint64_t p1 = (uint64_t)PHILOX_M1 * c[2];
+	uint32_t c1 = c[1], c3 = c[3];
+	c[0] = (uint32_t)(p1 >> 32) ^ c1 ^ k[0];
+	c[1] = (uint32_t)p1;
+	c[2] = (uint32_t)(p0 >> 32) ^ c3 ^ k[1];
+	c[3] = (uint32_t)p0;
+}
+
+static void philox_block(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4])
+{
+	uint32_t k[2] = { key[0], key[1] };
+	int i;
+
+	for(i = 0; i < 4; i++)
+		out[i] = ctr[i];
+	for(i = 0; i < 10; i++)
+	{
+		if(i > 0)
+		{
+			k[0] += PHILOX_W0;
+			k[1] += PHILOX_W1;
+		}
+		philox_round(out,k);
+	}
+}
+
+static void philox_set(void *vstate, unsigned long seed)
+{
+	philox_state_t *s = vstate;
+	s->key[0] = (uint32_t)seed;
+	s->key[1] = (uint32_t)((uint64_t)seed >> 32);
+	s->ctr[0] = s->ctr[1] = s->ctr[2] = s->ctr[3] = 0;
+	s->idx = 4;
+}
+
+static unsigned long philox_get(void *vstate)
+{
+	philox_state_t *s = vstate;
+	if(s->idx == 4)
+	{
+		philox_block(s->ctr,s->key,s->out);
+		// next position in the stream
+		if(++s->ctr[0] == 0)
+			s->ctr[1]++;
+		s->idx = 0;
+	}
+	return s->out[s->idx++];
+}
+
+static double philox_get_double(void *vstate)
+{
+	return philox_get(vstate) / 4294967296.0;
+}
+
+static const gsl_rng_type philox_type = {
+	"philox",
+	0xffffffffUL,
+	0,
+	sizeof(philox_state_t),
+	&philox_set,
+	&philox_get,
+	&philox_get_double
+};
+
+const gsl_rng_type *ggen_rng_philox = &philox_type;
+
+void philox_seek(gsl_rng *r, unsigned long stream, unsigned long counter)
+{
+	philox_state_t *s = r->state;
+	s->ctr[0] = (uint32_t)counter;
+	s->ctr[1] = (uint32_t)((uint64_t)counter >> 32);
+	s->ctr[2] = (uint32_t)stream;
+	s->ctr[3] = (uint32_t)((uint64_t)stream >> 32);
+	s->idx = 4;
+}
+
+int ggen_rng_philox_seek(gsl_rng *r, unsigned long stream, unsigned long counter)
+{
+	ggen_error_start_stack();
+	if(r == NULL || r->type != ggen_rng_philox)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	philox_seek(r,stream,counter);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
+
+int ggen_rng_philox_tell(const gsl_rng *r, unsigned long *stream, unsigned long *counter)
+{
+	philox_state_t *s;
+	ggen_error_start_stack();
+	if(r == NULL || r->type != ggen_rng_philox)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	s = r->state;
+	if(stream != NULL)
+		*stream = s->ctr[2] | ((uint64_t)s->ctr[3] << 32);
+	if(counter != NULL)
+		*counter = s->ctr[0] | ((uint64_t)s->ctr[1] << 32);
+	ggen_error_clean(1);
+	return GGEN_SUCCESS;
+ggen_error_label:
+	return GGEN_FAILURE;
+}
@@ -1,4 +1,4 @@
-/* Copyright Swann Perarnau 2009
+/* Copyright Swann Perarnau 2013
  *
  *   contributor(s) :
  *
@@ -41,9 +41,15 @@
  * This is a research project founded by the MOAIS Team,
  * INRIA, Grenoble Universities.
  */
-#ifndef BIPARTITE_MATCHING_H
-#define BIPARTITE_MATCHING 1
 
-int bipartite_maximum_matching(igraph_t *g, igraph_vector_t *res);
+#ifndef RNG_PHILOX_H
+#define RNG_PHILOX_H 1
 
-#endif
+#include "ggen.h"
+
+/* ggen_rng_philox_seek without any check or error reporting: r must be a
+ * philox generator. Safe to call from several threads on distinct generators.
+ */
+void philox_seek(gsl_rng *r, unsigned long stream, unsigned long counter);
+
+#endif /* RNG_PHILOX_H */
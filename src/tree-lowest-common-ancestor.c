@@ -41,283 +41,100 @@
  * This is a research project founded by the MOAIS Team,
  * INRIA, Grenoble Universities.
  */
-/* An implementation of offline lca query, with a prepocessing in O(n) and
- * query in O(1).
- * - we need a fast LCA tree data structure.
- * - and the LCA algorithm itself.
- * See "On finding lowest common ancestors: simplification and parallelization"
- * by Baruch Schieber and Uzi Vishkin (1988).
+/* An implementation of online lca queries, on a tree growing by its leaves:
+ * adding a leaf is O(1), a query O(log n).
+ * Each node has a jump pointer, defined from the one of its parent so that the
+ * jumps of a path from the root follow the skew-binary decomposition of the
+ * depths: from any node, a level ancestor is found by O(log n) jumps or moves
+ * to the parent. As the jump of a node only depends on its depth, two nodes at
+ * the same depth climb the tree in lockstep until they meet.
+ * See "An applicative random-access stack" by Eugene W. Myers (1983).
  */
 
-#include <igraph/igraph.h>
+#include <stdlib.h>
 #include "tree-lowest-common-ancestor.h"
 #include "error.h"
 
-/* a few utility functions for repetitive actions in the other functions */
-
-/* find the index of a key in the table. Could be implemented faster with a
- * real hash table. */
-static inline int head_search(head_t *h, unsigned long key, unsigned long *index)
-{
-	unsigned long i;
-	for(i = 0; i < h->size; i++)
-		if(h->table[i].key == key)
-		{
-			*index = i;
-			return GGEN_SUCCESS;
-		}
-	return GGEN_FAILURE;
-}
-
-/* Find the father of a vid in the tree. Aborts program if we call it with a
- * node with no father. */
-static inline int tree_father(const igraph_t *tree, unsigned long vid, unsigned long *ret)
+int tree_lca_init(lca_tree *t, unsigned long n)
 {
-	int err;
-	unsigned long father;
-	igraph_vs_t vs;
-	igraph_vit_t vit;
-
 	ggen_error_start_stack();
-	GGEN_CHECK_IGRAPH(igraph_vs_adj(&vs, vid, IGRAPH_IN));
-	GGEN_FINALLY(igraph_vs_destroy,&vs);
-	GGEN_CHECK_IGRAPH(igraph_vit_create(tree,vs,&vit));
-	GGEN_FINALLY(igraph_vit_destroy,&vit);
-	father = (unsigned long)IGRAPH_VIT_GET(vit);
-	*ret = father;
-	ggen_error_clean(1);
-	return GGEN_SUCCESS;
-ggen_error_label:
-	*ret = 0;
-	return GGEN_FAILURE;
-}
+	if(t == NULL)
+		GGEN_SET_ERRNO(GGEN_EINVAL);
+
+	t->parent = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(t->parent);
+	GGEN_FINALLY3(free,t->parent,1);
+	t->depth = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(t->depth);
+	GGEN_FINALLY3(free,t->depth,1);
+	t->jump = malloc((n+1)*sizeof(int32_t));
+	GGEN_CHECK_ALLOC(t->jump);
 
-int tree_lca_metadata_init(igraph_t *tree, lca_metadata *m)
-{
-	unsigned long i;
-	ggen_error_start_stack();
-	m->tsize = igraph_vcount(tree);
-	m->table = calloc(m->tsize,sizeof(unsigned long *));
-	GGEN_CHECK_ALLOC(m->table);
-	GGEN_FINALLY3(free,m->table,1);
-	m->table[0] = calloc(m->tsize*3,sizeof(unsigned long));
-	GGEN_CHECK_ALLOC(m->table[0]);
-	GGEN_FINALLY3(free,m->table[0],1);
-
-	for(i = 0; i < m->tsize; i++)
-	{
-		m->table[i] = m->table[0] + i*3;
-	}
-	m->head.table = calloc(m->tsize,sizeof(head_e));
-	GGEN_CHECK_ALLOC(m->head.table);
-	m->head.size = 0;
 	ggen_error_clean(1);
 	return GGEN_SUCCESS;
 ggen_error_label:
 	return GGEN_FAILURE;
 }
 
-void tree_lca_metadata_free(lca_metadata *m)
+void tree_lca_free(lca_tree *t)
 {
-	free(m->table[0]);
-	free(m->table);
-	free(m->head.table);
+	free(t->parent);
+	free(t->depth);
+	free(t->jump);
 }
 
-/* meta->table access macros */
-#define INLABEL(t,v) (t)[v][0]
-#define ASCENDANT(t,v) (t)[v][1]
-#define LEVEL(t,v) (t)[v][2]
-
-/* a bfs callback. Builds the meta->table during the bfs. */
-static igraph_bool_t  tree_ascendant_bfs_callback(const igraph_t *tree,
-	igraph_integer_t vid, igraph_integer_t pred, igraph_integer_t succ,
-	igraph_integer_t rank, igraph_integer_t dist, void *extra)
+void tree_lca_add_root(lca_tree *t, int32_t v)
 {
-	unsigned long **table = (unsigned long **)extra;
-	unsigned long father;
-
-	ggen_error_start_stack();
-	GGEN_CHECK_INTERNAL_ERRNO(tree_father(tree,vid,&father));
-	// compute ascendant
-	if(INLABEL(table,vid) == INLABEL(table,father))
-	{
-		ASCENDANT(table,vid) = ASCENDANT(table,father);
-	}
-	else
-	{
-		unsigned long i = log2(INLABEL(table,vid) - (INLABEL(table,vid) & (INLABEL(table,vid)-1)));
-		ASCENDANT(table,vid) = ASCENDANT(table,father) + (1 << i);
-	}
-	ggen_error_clean(1);
-	return GGEN_SUCCESS;
-ggen_error_label:
-	return GGEN_FAILURE;
+	t->parent[v] = v;
+	t->depth[v] = 0;
+	t->jump[v] = v;
 }
 
-/* builds recursively a preorder numbering of all vertices in the tree.
- * Also fills a vector containing the size of the subtree of a root (includes
- * the current node).
- */
-static int tree_build_preorder(igraph_t *tree, unsigned long node,
-	igraph_vector_t *preorder, igraph_vector_t *size, unsigned long *value)
+void tree_lca_add_leaf(lca_tree *t, int32_t v, int32_t parent)
 {
-	unsigned long sz = 0;
-	igraph_vs_t vs;
-	igraph_vit_t vit;
-
-	ggen_error_start_stack();
-	// save current value
-	sz = *value;
-	// asign preorder to node
-	*value = *value +1;
-	VECTOR(*preorder)[node] = *value;
+	int32_t j = t->jump[parent];
 
-	// find children and recurse
-	GGEN_CHECK_IGRAPH(igraph_vs_adj(&vs, node, IGRAPH_OUT));
-	GGEN_FINALLY(igraph_vs_destroy,&vs);
-	GGEN_CHECK_IGRAPH(igraph_vit_create(tree,vs,&vit));
-	GGEN_FINALLY(igraph_vit_destroy,&vit);
-	for(vit;!IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit))
-	{
-		GGEN_CHECK_INTERNAL_ERRNO(tree_build_preorder(tree,IGRAPH_VIT_GET(vit),preorder,size,value));
-	}
-	// compute size of subtree
-	sz = *value - sz;
-	VECTOR(*size)[node] = sz;
-	ggen_error_clean(1);
-	return GGEN_SUCCESS;
-ggen_error_label:
-	return GGEN_FAILURE;
+	t->parent[v] = parent;
+	t->depth[v] = t->depth[parent] + 1;
+	/* two jumps of the same length merge into one twice as long */
+	if(t->depth[parent] - t->depth[j] == t->depth[j] - t->depth[t->jump[j]])
+		t->jump[v] = t->jump[j];
+	else
+		t->jump[v] = parent;
 }
 
-/* Preprocess a tree to answer LCA queries in constant time.
- * See paper for full explanation of the various steps.
- */
-int tree_lca_preprocessing(igraph_t *tree, unsigned long root, lca_metadata *m)
+/* the ancestor of v at depth d */
+static inline int32_t tree_level_ancestor(const lca_tree *t, int32_t v,
+					  int32_t d)
 {
-	/* INLABEL(v) */
-	/* first step, compute the preorder of each vertex in the tree. */
-	igraph_vector_t preorder, size, dist;
-	unsigned long v = 0, l, i, father;
-
-	ggen_error_start_stack();
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&preorder,igraph_vcount(tree)));
-	GGEN_FINALLY(igraph_vector_destroy,&preorder);
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&size,igraph_vcount(tree)));
-	GGEN_FINALLY(igraph_vector_destroy,&size);
-	GGEN_CHECK_INTERNAL_ERRNO(tree_build_preorder(tree,root,&preorder,&size,&v));
-
-	/* second step, compute inlabel(v) */
-	for(v = 0; v < igraph_vcount(tree); v++)
+	while(t->depth[v] > d)
 	{
-		// step 2.1
-		i = (unsigned long)(VECTOR(preorder)[v] -1);
-		i = i ^ (unsigned long)(VECTOR(preorder)[v]+VECTOR(size)[v] -1);
-		i = (unsigned long)log2(i);
-		// step 2.2
-		l = ((unsigned long)(VECTOR(preorder)[v] + VECTOR(size)[v] -1)) >> i;
-		INLABEL(m->table,v) = l << i;
-	}
-	/* ASCENDANT(v) & LEVEL(v)*/
-	GGEN_CHECK_IGRAPH(igraph_vector_init(&dist,igraph_vcount(tree)));
-	GGEN_FINALLY(igraph_vector_destroy,&dist);
-
-	l = ceil(log2(igraph_vcount(tree)+1)) -1;
-	ASCENDANT(m->table,0) = 1 << l;
-
-	GGEN_CHECK_INTERNAL_DO(igraph_bfs(tree,root, NULL, IGRAPH_OUT, 0, NULL, NULL, NULL, NULL, NULL, NULL, &dist, tree_ascendant_bfs_callback,m->table));
-	/* Finish LEVEL(v) */
-	for(v = 0; v < igraph_vcount(tree); v++)
-	{
-		LEVEL(m->table,v) = VECTOR(dist)[v];
-	}
-	/* HEAD table */
-	for(v = 0; v < igraph_vcount(tree); v++)
-	{
-		if(head_search(&(m->head), INLABEL(m->table,v),&i) == GGEN_FAILURE);
-		{
-			m->head.table[m->head.size].key = INLABEL(m->table,v);
-			m->head.table[m->head.size].value = v;
-			m->head.size++;
-		}
-	}
-	for(v = 1; v < igraph_vcount(tree); v++)
-	{
-		GGEN_CHECK_INTERNAL_ERRNO(tree_father(tree,v,&father));
-		if(INLABEL(m->table,v) != INLABEL(m->table,father))
-		{
-			GGEN_CHECK_INTERNAL_ERRNO(head_search(&(m->head), INLABEL(m->table,v),&i));
-			m->head.table[i].value = v;
-		}
+		if(t->depth[t->jump[v]] >= d)
+			v = t->jump[v];
+		else
+			v = t->parent[v];
 	}
-	ggen_error_clean(1);
-	return GGEN_SUCCESS;
-ggen_error_label:
-	return GGEN_FAILURE;
+	return v;
 }
 
-int tree_lca_query(igraph_t *tree, unsigned long u, unsigned long v,
-	unsigned long *ret, lca_metadata *m)
+int32_t tree_lca_query(const lca_tree *t, int32_t u, int32_t v)
 {
-	unsigned long i,b,c,ci,j,iz,ubar,vbar,k,iw,w;
-	unsigned long tmp;
-	unsigned long **table = m->table;
-	head_t *head = &(m->head);
-
-	ggen_error_start_stack();
-	if(INLABEL(table,u) == INLABEL(table,v))
-	{
-		if(LEVEL(table,u) <= LEVEL(table,v))
-			*ret = u;
-		else
-			*ret = v;
-	}
+	if(t->depth[u] > t->depth[v])
+		u = tree_level_ancestor(t,u,t->depth[v]);
 	else
+		v = tree_level_ancestor(t,v,t->depth[u]);
+	while(u != v)
 	{
-		// step 1
-		i = (unsigned long) log2(INLABEL(table,u) ^ INLABEL(table,v));
-		b = ((INLABEL(table,u) >> (i+1)) << (i+1)) + (1 << i);
-		// step 2
-		c = ASCENDANT(table,u) & ASCENDANT(table,v);
-		ci = (c >> i) << i;
-		j = log2(ci - (ci & (ci -1)));
-		iz = ((INLABEL(table,u) >> (j+1)) << (j+1)) + (1 << j);
-		// step 3
-		if(INLABEL(table,u) == iz)
-			ubar = u;
-		else
+		if(t->jump[u] != t->jump[v])
 		{
-			k = ((1 << j) -1) & ASCENDANT(table,u);
-			if(k != 0)
-				k = log2(k);
-			iw = ((INLABEL(table,u) >> (k+1)) << (k+1)) + (1 << k);
-			GGEN_CHECK_INTERNAL(head_search(head,iw,&tmp));
-			w = head->table[tmp].value;
-			GGEN_CHECK_INTERNAL_ERRNO(tree_father(tree,w,&ubar));
+			u = t->jump[u];
+			v = t->jump[v];
 		}
-		if(INLABEL(table,v) == iz)
-			vbar = v;
 		else
 		{
-			k = ((1 << j) -1) & ASCENDANT(table,v);
-			if(k != 0)
-				k = log2(k);
-			iw = ((INLABEL(table,v) >> (k+1)) << (k+1)) + (1 << k);
-			GGEN_CHECK_INTERNAL(head_search(head,iw,&tmp));
-			w = head->table[tmp].value;
-			GGEN_CHECK_INTERNAL_ERRNO(tree_father(tree,w,&vbar));
+			u = t->parent[u];
+			v = t->parent[v];
 		}
-		if(LEVEL(table,ubar) <= LEVEL(table,vbar))
-			*ret = ubar;
-		else
-			*ret = vbar;
 	}
-	ggen_error_clean(1);
-	return GGEN_SUCCESS;
-ggen_error_label:
-	*ret = 0;
-	return GGEN_FAILURE;
+	return u;
 }
-
-
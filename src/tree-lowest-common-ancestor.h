@@ -44,28 +44,30 @@
 
 #ifndef TREE_LOWEST_COMMON_ANCESTOR_H
 #define TREE_LOWEST_COMMON_ANCESTOR_H 1
-typedef struct {
-	unsigned long key;
-	unsigned long value;
-} head_e;
 
-typedef struct {
-	unsigned long size;
-	head_e *table;
-} head_t;
+#include <stdint.h>
 
+/* A rooted tree over vertex ids, grown one leaf at a time. Each node keeps its
+ * parent, its depth and a jump pointer to one of its ancestors, so that level
+ * ancestor and lowest common ancestor queries take O(log n), whatever the
+ * shape of the tree, with 3 integers per node.
+ */
 typedef struct {
-	unsigned long tsize;
-	unsigned long **table;
-	head_t head;
-} lca_metadata;
+	int32_t *parent;
+	int32_t *depth;
+	int32_t *jump;
+} lca_tree;
+
+/* a tree with room for the vertex ids 0 to n-1, none of them in the tree */
+int tree_lca_init(lca_tree *t, unsigned long n);
 
-int tree_lca_metadata_init(igraph_t *, lca_metadata *);
+void tree_lca_free(lca_tree *t);
 
-int tree_lca_preprocessing(igraph_t *, unsigned long, lca_metadata *);
+void tree_lca_add_root(lca_tree *t, int32_t v);
 
-int tree_lca_query(igraph_t *, unsigned long, unsigned long, unsigned long *, lca_metadata *);
+/* add v to the tree, as a child of parent */
+void tree_lca_add_leaf(lca_tree *t, int32_t v, int32_t parent);
 
-void tree_lca_metadata_free(lca_metadata *);
+int32_t tree_lca_query(const lca_tree *t, int32_t u, int32_t v);
 
 #endif
@@ -45,13 +45,26 @@
 int ggen_rng_init(gsl_rng **r)
 {
 	const gsl_rng_type *T;
-	char *seedenv;
+	char *seedenv,*typeenv;
 	unsigned long seedval;
 	FILE *file;
 
-	gsl_rng_env_setup();
-
-	T = gsl_rng_default;
+	/* gsl does not know about our own generators, and refuses to read the
+	 * seed if the type is unknown to it.
+	 */
+	typeenv = getenv("GSL_RNG_TYPE");
+	if(typeenv != NULL && !strcmp(typeenv,ggen_rng_philox->name))
+	{
+		T = ggen_rng_philox;
+		seedenv = getenv("GSL_RNG_SEED");
+		if(seedenv != NULL)
+			gsl_rng_default_seed = strtoul(seedenv,NULL,0);
+	}
+	else
+	{
+		gsl_rng_env_setup();
+		T = gsl_rng_default;
+	}
 	*r = gsl_rng_alloc(T);
 
 	info("Using %s as RNG.\n",gsl_rng_name(*r));
@@ -154,3 +167,115 @@ int s2d(char *s,double *d)
 	return 0;
 
 }
+
+/* replace each occurrence of key in template by value, the result must be
+ * freed by the caller
+ */
+char *template_fill(const char *template, const char *key, const char *value)
+{
+	unsigned long len,klen = strlen(key);
+	const char *c,*k;
+	char *res;
+
+	len = strlen(template) + 1;
+	for(c = template; (k = strstr(c,key)) != NULL; c = k + klen)
+		len += strlen(value);
+	res = malloc(len);
+	if(res == NULL)
+		return NULL;
+
+	res[0] = '\0';
+	for(c = template; (k = strstr(c,key)) != NULL; c = k + klen)
+	{
+		strncat(res,c,k-c);
+		strcat(res,value);
+	}
+	strcat(res,c);
+	return res;
+}
+
+struct ggen_edge_sink *stream_sink(const char *format, FILE *out)
+{
+	struct ggen_edge_sink *sink;
+
+	if(!strcmp(format,"dot"))
+		sink = ggen_edge_sink_dot(out,NULL);
+	else if(!strcmp(format,"edgelist"))
+		sink = ggen_edge_sink_edgelist(out);
+	else
+	{
+		error("Unknown stream format %s\n",format);
+		return NULL;
+	}
+	if(sink == NULL)
+		error("ggen error: %s\n",ggen_error_strerror());
+	return sink;
+}
+
+int read_cost_table(const char *file, struct ggen_kernel_cost **table,
+		    unsigned long *n)
+{
+	FILE *f;
+	char line[256],kname[128];
+	struct ggen_kernel_cost *t = NULL,*tmp,*c;
+	unsigned long size = 0,max = 0,lineno = 0;
+	int status = 0;
+
+	f = fopen(file,"r");
+	if(f == NULL)
+	{
+		error("Cannot open cost table %s: %s\n",file,strerror(errno));
+		return 1;
+	}
+	while(fgets(line,sizeof(line),f) != NULL)
+	{
+		lineno++;
+		if(line[0] == '#' || line[strspn(line," \t\r\n")] == '\0')
+			continue;
+		if(size == max)
+		{
+			max = max ? 2*max : 16;
+			tmp = realloc(t,max*sizeof(*t));
+			if(tmp == NULL)
+			{
+				error("Cannot allocate cost table\n");
+				status = 1;
+				break;
+			}
+			t = tmp;
+		}
+		c = &t[size];
+		if(sscanf(line," %127[^, ] , %lf , %u , %lf , %u",kname,&c->comp,
+			  &c->comp_exp,&c->comm,&c->comm_exp) != 5)
+		{
+			error("Invalid cost table entry at %s:%lu\n",file,lineno);
+			status = 1;
+			break;
+		}
+		c->name = strdup(kname);
+		if(c->name == NULL)
+		{
+			error("Cannot allocate cost table\n");
+			status = 1;
+			break;
+		}
+		size++;
+	}
+	fclose(f);
+	if(status)
+	{
+		free_cost_table(t,size);
+		return status;
+	}
+	info("Read %lu kernel costs from %s\n",size,file);
+	*table = t;
+	*n = size;
+	return 0;
+}
+
+void free_cost_table(struct ggen_kernel_cost *table, unsigned long n)
+{
+	for(unsigned long i = 0; i < n; i++)
+		free((char *)table[i].name);
+	free(table);
+}
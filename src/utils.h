@@ -47,5 +47,18 @@ int ggen_rng_load(gsl_rng **r,const char *file);
 int s2ul(char *s,unsigned long *l);
 int s2d(char *s,double *d);
 
+/* output file names */
+char *template_fill(const char *template, const char *key, const char *value);
+
+/* the sink writing to out in a --stream format, NULL on error */
+struct ggen_edge_sink *stream_sink(const char *format, FILE *out);
+
+/* kernel cost tables: one "name,comp,comp_exp,comm,comm_exp" line per kernel,
+ * lines starting with # are ignored. free_cost_table releases the result.
+ */
+int read_cost_table(const char *file, struct ggen_kernel_cost **table,
+		    unsigned long *n);
+void free_cost_table(struct ggen_kernel_cost *table, unsigned long n);
+
 
 #endif
@@ -0,0 +1,159 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the analytic properties of the graph families against the
+ * graphs their generators build.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <string.h>
+
+/* the metrics of family match g, which is destroyed */
+static void check_family(const char *family, const unsigned long *params,
+			 unsigned long nparams, igraph_t *g)
+{
+	struct ggen_family_metrics m;
+	igraph_strvector_t kernels,names;
+	igraph_vector_t counts,types,*lp,*a;
+	unsigned long i,v,cnt;
+
+	assert(g != NULL);
+	igraph_strvector_init(&kernels,0);
+	igraph_vector_init(&counts,0);
+	assert(ggen_analyze_family(family,params,nparams,&m,&kernels,
+				   &counts) == 0);
+	assert(m.vertices == (unsigned long)igraph_vcount(g));
+	assert(m.edges == (unsigned long)igraph_ecount(g));
+	if(m.edges > 0)
+	{
+		lp = ggen_analyze_longest_path(g);
+		assert(lp != NULL);
+		assert(m.critical_path == (unsigned long)igraph_vector_size(lp));
+		igraph_vector_destroy(lp);
+		free(lp);
+	}
+	a = ggen_analyze_longest_antichain(g);
+	assert(a != NULL);
+	assert(m.width == (unsigned long)igraph_vector_size(a));
+	igraph_vector_destroy(a);
+	free(a);
+
+	if(igraph_strvector_size(&kernels) > 0)
+	{
+		igraph_strvector_init(&names,0);
+		igraph_vector_init(&types,0);
+		assert(ggen_get_kernels(g,&names,&types) == 0);
+		for(i = 0; i < (unsigned long)igraph_strvector_size(&kernels); i++)
+		{
+			for(v = 0, cnt = 0; v < (unsigned long)igraph_vcount(g); v++)
+				if(!strcmp(STR(names,(long)VECTOR(types)[v]),
+					   STR(kernels,i)))
+					cnt++;
+			assert(cnt == VECTOR(counts)[i]);
+		}
+		igraph_vector_destroy(&types);
+		igraph_strvector_destroy(&names);
+	}
+	igraph_vector_destroy(&counts);
+	igraph_strvector_destroy(&kernels);
+	igraph_destroy(g);
+	free(g);
+}
+
+static unsigned long width(const char *family, unsigned long n,
+			   unsigned long a, unsigned long b, unsigned long c)
+{
+	struct ggen_family_metrics m;
+	unsigned long params[3] = { a, b, c };
+	assert(ggen_analyze_family(family,params,n,&m,NULL,NULL) == 0);
+	return m.width;
+}
+
+int main()
+{
+	struct ggen_family_metrics m;
+	unsigned long p[3];
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+	// invalid families and parameters, overflows
+	p[0] = 5;
+	p[1] = 6;
+	assert(ggen_analyze_family("nope",p,1,&m,NULL,NULL) != 0);
+	assert(ggen_analyze_family("cholesky",p,2,&m,NULL,NULL) != 0);
+	assert(ggen_analyze_family("fibonacci",p,2,&m,NULL,NULL) != 0);
+	assert(ggen_analyze_family("cholesky",p,1,NULL,NULL,NULL) != 0);
+	p[0] = 1UL << 40;
+	assert(ggen_analyze_family("denselu",p,1,&m,NULL,NULL) != 0);
+
+	// the generators
+	for(p[0] = 0; p[0] < 8; p[0]++)
+	{
+		check_family("cholesky",p,1,ggen_generate_cholesky(p[0]));
+		check_family("denselu",p,1,ggen_generate_denselu(p[0]));
+	}
+	for(p[0] = 0; p[0] < 12; p[0]++)
+		for(p[1] = 0; p[1] <= p[0]; p[1]++)
+			check_family("fibonacci",p,2,
+				     ggen_generate_fibonacci(p[0],p[1]));
+	for(p[0] = 0; p[0] < 4; p[0]++)
+		for(p[1] = 0; p[1] < 4; p[1]++)
+			check_family("forkjoin",p,2,
+				     ggen_generate_forkjoin(p[0],p[1]));
+	for(p[0] = 1; p[0] <= 64; p[0] *= 4)
+		for(p[1] = 0; p[1] < 5; p[1]++)
+		{
+			p[2] = 4;
+			check_family("strassen",p,3,
+				     ggen_generate_strassen(p[0],p[1],p[2]));
+		}
+
+	// widths, found by exhaustive search on the generated graphs
+	assert(width("cholesky",1,0,0,0) == 0);
+	assert(width("cholesky",1,2,0,0) == 1);
+	assert(width("cholesky",1,5,0,0) == 10);
+	assert(width("denselu",1,2,0,0) == 2);
+	assert(width("denselu",1,5,0,0) == 16);
+	assert(width("fibonacci",2,6,0,0) == 13);
+	assert(width("fibonacci",2,9,3,0) == 21);
+	assert(width("forkjoin",2,3,0,0) == 4);
+	assert(width("forkjoin",2,3,2,0) == 2);
+	assert(width("strassen",3,1024,2,1) == 8);
+	assert(width("strassen",3,1024,4,1) == 392);
+	return 0;
+}
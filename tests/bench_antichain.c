@@ -0,0 +1,122 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* Longest antichain on G(n,p) graphs: the reachability of the graph is built
+ * as bit rows, then matched in place. Both steps are timed, with the memory
+ * taken by the rows. The expected degree of the graphs stays constant.
+ *
+ * Usage: bench_antichain [degree] [max n]
+ * This program is not run by make check.
+ */
+
+#include "ggen.h"
+#include "csr.h"
+#include "reachability.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double seconds(clock_t start, clock_t stop)
+{
+	return (double)(stop - start)/CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	gsl_rng *r;
+	igraph_t *g;
+	igraph_vector_t *a;
+	csr_t c;
+	int32_t *order;
+	reach_t reach;
+	clock_t start,mid,stop;
+	unsigned long n,max = 32000;
+	double degree = 4.0;
+
+	if(argc > 1)
+		degree = strtod(argv[1],NULL);
+	if(argc > 2)
+		max = strtoul(argv[2],NULL,10);
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	if(r == NULL)
+		return EXIT_FAILURE;
+
+	printf("%-10s %-12s %-10s %-10s %-10s %s\n","n","edges","rows MB",
+	       "closure","total","width");
+	for(n = 1000; n <= max; n *= 2)
+	{
+		g = ggen_generate_erdos_gnp(r,n,degree/n);
+		if(g == NULL)
+		{
+			fprintf(stderr,"generation failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+
+		order = malloc((n+1)*sizeof(int32_t));
+		start = clock();
+		if(order == NULL || csr_init(&c,g) || csr_topological_order(&c,order) ||
+		   reach_init(&reach,&c,order))
+		{
+			fprintf(stderr,"reachability failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+		mid = clock();
+		reach_free(&reach);
+		csr_free(&c);
+		free(order);
+
+		a = ggen_analyze_longest_antichain(g);
+		stop = clock();
+		if(a == NULL)
+		{
+			fprintf(stderr,"antichain failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+		printf("%-10lu %-12lu %-10.1f %-10f %-10f %lu\n",n,
+		       (unsigned long)igraph_ecount(g),
+		       (double)n*((n+63)/64)*8/1e6,seconds(start,mid),
+		       seconds(mid,stop),(unsigned long)igraph_vector_size(a));
+		igraph_vector_destroy(a);
+		free(a);
+		igraph_destroy(g);
+		free(g);
+	}
+	gsl_rng_free(r);
+	return EXIT_SUCCESS;
+}
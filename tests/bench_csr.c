@@ -0,0 +1,153 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* Neighbour iteration throughput: the analyses used to walk the neighbours of
+ * each vertex with a vertex selector and an iterator, they now scan the
+ * arrays of an adjacency snapshot. Both walks sum the out-neighbours of every
+ * vertex of a G(n,m) graph, the snapshot being built once, its construction
+ * time reported separately.
+ *
+ * Usage: bench_csr [degree] [max n] [rounds]
+ * This program is not run by make check.
+ */
+
+#include "ggen.h"
+#include "csr.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double seconds(clock_t start, clock_t stop)
+{
+	return (double)(stop - start)/CLOCKS_PER_SEC;
+}
+
+static unsigned long walk_igraph(igraph_t *g)
+{
+	igraph_vs_t vs;
+	igraph_vit_t vit;
+	unsigned long v,sum = 0;
+
+	for(v = 0; v < (unsigned long)igraph_vcount(g); v++)
+	{
+		igraph_vs_adj(&vs,v,IGRAPH_OUT);
+		igraph_vit_create(g,vs,&vit);
+		for(; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit))
+			sum += IGRAPH_VIT_GET(vit);
+		igraph_vit_destroy(&vit);
+		igraph_vs_destroy(&vs);
+	}
+	return sum;
+}
+
+static unsigned long walk_csr(csr_t *c)
+{
+	unsigned long sum = 0;
+	int32_t v;
+	int64_t i;
+
+	for(v = 0; v < c->vcount; v++)
+		for(i = c->out_offsets[v]; i < c->out_offsets[v+1]; i++)
+			sum += c->out_targets[i];
+	return sum;
+}
+
+int main(int argc, char **argv)
+{
+	gsl_rng *r;
+	igraph_t *g;
+	csr_t c;
+	clock_t start,mid,stop;
+	unsigned long n,i,s1,s2,rounds = 10,max = 1000000;
+	double degree = 10.0,t1,t2,e;
+
+	if(argc > 1)
+		degree = strtod(argv[1],NULL);
+	if(argc > 2)
+		max = strtoul(argv[2],NULL,10);
+	if(argc > 3)
+		rounds = strtoul(argv[3],NULL,10);
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	if(r == NULL)
+		return EXIT_FAILURE;
+
+	printf("%-10s %-12s %-10s %-14s %-14s %s\n","n","edges","build",
+	       "igraph Me/s","csr Me/s","speedup");
+	for(n = 1000; n <= max; n *= 4)
+	{
+		g = ggen_generate_erdos_gnm_sparse(r,n,degree*n);
+		if(g == NULL)
+		{
+			fprintf(stderr,"generation failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+		e = (double)igraph_ecount(g)*rounds/1e6;
+
+		start = clock();
+		for(i = 0, s1 = 0; i < rounds; i++)
+			s1 += walk_igraph(g);
+		stop = clock();
+		t1 = seconds(start,stop);
+
+		start = clock();
+		if(csr_init(&c,g))
+		{
+			fprintf(stderr,"snapshot failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+		mid = clock();
+		for(i = 0, s2 = 0; i < rounds; i++)
+			s2 += walk_csr(&c);
+		stop = clock();
+		t2 = seconds(mid,stop);
+		if(s1 != s2)
+		{
+			fprintf(stderr,"walks differ\n");
+			return EXIT_FAILURE;
+		}
+		printf("%-10lu %-12lu %-10f %-14.1f %-14.1f %.1fx\n",n,
+		       (unsigned long)igraph_ecount(g),seconds(start,mid),
+		       e/t1,e/t2,t1/t2);
+		csr_free(&c);
+		igraph_destroy(g);
+		free(g);
+	}
+	gsl_rng_free(r);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* Scaling benchmark of the two G(n,p) methods: the adjacency matrix one and
+ * the sparse (geometric skip) one. The average degree is kept constant, so
+ * the sparse method should scale linearly with n while the matrix one is
+ * quadratic in time and memory.
+ *
+ * Usage: bench_gnp [degree] [max n for the matrix method] [max n]
+ * This program is not run by make check.
+ */
+
+#include "ggen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef igraph_t *(*gnp_method)(gsl_rng *, unsigned long, double);
+
+static double run(gnp_method f, gsl_rng *r, unsigned long n, double p,
+		unsigned long *edges)
+{
+	clock_t start,stop;
+	igraph_t *g;
+
+	start = clock();
+	g = f(r,n,p);
+	stop = clock();
+	if(g == NULL)
+	{
+		fprintf(stderr,"generation failed: %s\n",ggen_error_strerror());
+		exit(EXIT_FAILURE);
+	}
+	*edges = igraph_ecount(g);
+	igraph_destroy(g);
+	free(g);
+	return (double)(stop - start)/CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	gsl_rng *r;
+	unsigned long n,edges;
+	unsigned long matrix_max = 8000, max = 1000000;
+	double degree = 10.0, p, t;
+
+	if(argc > 1)
+		degree = strtod(argv[1],NULL);
+	if(argc > 2)
+		matrix_max = strtoul(argv[2],NULL,10);
+	if(argc > 3)
+		max = strtoul(argv[3],NULL,10);
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	if(r == NULL)
+		return EXIT_FAILURE;
+
+	printf("%-10s %-12s %-8s %-12s %s\n","n","p","method","edges","seconds");
+	for(n = 1000; n <= max; n *= 2)
+	{
+		p = degree/(n-1);
+		if(n <= matrix_max)
+		{
+			t = run(ggen_generate_erdos_gnp,r,n,p,&edges);
+			printf("%-10lu %-12g %-8s %-12lu %f\n",n,p,"matrix",edges,t);
+		}
+		t = run(ggen_generate_erdos_gnp_sparse,r,n,p,&edges);
+		printf("%-10lu %-12g %-8s %-12lu %f\n",n,p,"sparse",edges,t);
+	}
+	gsl_rng_free(r);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* Lowest single ancestor on G(n,m) graphs given a single source: each vertex
+ * is added to the lsa tree as the lowest common ancestor of its parents, so
+ * the analysis should grow as (V+E) log V.
+ *
+ * Usage: bench_lsa [degree] [max n]
+ * This program is not run by make check.
+ */
+
+#include "ggen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double seconds(clock_t start, clock_t stop)
+{
+	return (double)(stop - start)/CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	gsl_rng *r;
+	igraph_t *g;
+	igraph_vector_t *lsa;
+	clock_t start,stop;
+	unsigned long n,max = 1000000;
+	double degree = 4.0,t;
+
+	if(argc > 1)
+		degree = strtod(argv[1],NULL);
+	if(argc > 2)
+		max = strtoul(argv[2],NULL,10);
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	if(r == NULL)
+		return EXIT_FAILURE;
+
+	printf("%-10s %-12s %-10s %s\n","n","edges","lsa","ns/edge");
+	for(n = 1000; n <= max; n *= 4)
+	{
+		g = ggen_generate_erdos_gnm_sparse(r,n,degree*n);
+		if(g == NULL || ggen_transform_add(g,GGEN_TRANSFORM_SOURCE))
+		{
+			fprintf(stderr,"generation failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+
+		start = clock();
+		lsa = ggen_analyze_lowest_single_ancestor(g);
+		stop = clock();
+		if(lsa == NULL)
+		{
+			fprintf(stderr,"lsa failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+		t = seconds(start,stop);
+		printf("%-10lu %-12lu %-10f %.1f\n",n,
+		       (unsigned long)igraph_ecount(g),t,
+		       t*1e9/(igraph_ecount(g)+n));
+		igraph_vector_destroy(lsa);
+		free(lsa);
+		igraph_destroy(g);
+		free(g);
+	}
+	gsl_rng_free(r);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* Random orders with k orders: up to 9 orders the generator ANDs packed
+ * successor sets, n/64 words per order and vertex, above that it filters
+ * candidates, about 2n comparisons per vertex. Prints the time per vertex
+ * pair for each number of orders, the edges are about n*n/2^k.
+ *
+ * Usage: bench_orders [n] [max orders]
+ * This program is not run by make check.
+ */
+
+#include "ggen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double seconds(clock_t start, clock_t stop)
+{
+	return (double)(stop - start)/CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+	gsl_rng *r;
+	igraph_t *g;
+	clock_t start,stop;
+	unsigned long n = 4000;
+	unsigned int k,max = 12;
+	double t;
+
+	if(argc > 1)
+		n = strtoul(argv[1],NULL,10);
+	if(argc > 2)
+		max = strtoul(argv[2],NULL,10);
+
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	if(r == NULL)
+		return EXIT_FAILURE;
+
+	printf("%-8s %-12s %-10s %s\n","orders","edges","time","ns/pair");
+	for(k = 1; k <= max; k++)
+	{
+		start = clock();
+		g = ggen_generate_random_orders(r,n,k);
+		stop = clock();
+		if(g == NULL)
+		{
+			fprintf(stderr,"generation failed: %s\n",ggen_error_strerror());
+			return EXIT_FAILURE;
+		}
+		t = seconds(start,stop);
+		printf("%-8u %-12lu %-10f %.2f\n",k,
+		       (unsigned long)igraph_ecount(g),t,t*1e9/((double)n*n));
+		igraph_destroy(g);
+		free(g);
+	}
+	gsl_rng_free(r);
+	return EXIT_SUCCESS;
+}
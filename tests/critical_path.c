@@ -0,0 +1,219 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the weighted critical path against a relaxation of all
+ * edges until nothing changes, on random graphs with random weights.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#define EPS 1e-9
+
+/* top and bottom levels by brute force */
+static void relax(igraph_t *g, igraph_vector_t *w, igraph_vector_t *c,
+		  igraph_vector_t *top, igraph_vector_t *bottom)
+{
+	igraph_integer_t from,to;
+	unsigned long e;
+	int changed;
+
+	igraph_vector_null(top);
+	igraph_vector_update(bottom,w);
+	do {
+		changed = 0;
+		for(e = 0; e < (unsigned long)igraph_ecount(g); e++)
+		{
+			igraph_edge(g,e,&from,&to);
+			if(VECTOR(*top)[from] + VECTOR(*w)[from] + VECTOR(*c)[e] >
+			   VECTOR(*top)[to] + EPS)
+			{
+				VECTOR(*top)[to] = VECTOR(*top)[from] +
+					VECTOR(*w)[from] + VECTOR(*c)[e];
+				changed = 1;
+			}
+			if(VECTOR(*w)[from] + VECTOR(*c)[e] + VECTOR(*bottom)[to] >
+			   VECTOR(*bottom)[from] + EPS)
+			{
+				VECTOR(*bottom)[from] = VECTOR(*w)[from] +
+					VECTOR(*c)[e] + VECTOR(*bottom)[to];
+				changed = 1;
+			}
+		}
+	} while(changed);
+}
+
+static void check(igraph_t *g, const char *vw, const char *ew,
+		  igraph_vector_t *w, igraph_vector_t *c)
+{
+	igraph_vector_t path,top,bottom,slack,rtop,rbottom;
+	igraph_integer_t eid,from,to;
+	unsigned long i,n = igraph_vcount(g);
+	double length,sum,max = 0;
+
+	igraph_vector_init(&path,0);
+	igraph_vector_init(&top,0);
+	igraph_vector_init(&bottom,0);
+	igraph_vector_init(&slack,0);
+	igraph_vector_init(&rtop,n);
+	igraph_vector_init(&rbottom,n);
+	assert(ggen_analyze_critical_path(g,vw,ew,&path,&top,&bottom,&slack,
+					  &length) == 0);
+	relax(g,w,c,&rtop,&rbottom);
+	for(i = 0; i < n; i++)
+	{
+		assert(fabs(VECTOR(top)[i] - VECTOR(rtop)[i]) < EPS);
+		assert(fabs(VECTOR(bottom)[i] - VECTOR(rbottom)[i]) < EPS);
+		if(VECTOR(rbottom)[i] > max)
+			max = VECTOR(rbottom)[i];
+	}
+	assert(fabs(length - max) < EPS);
+	for(i = 0; i < n; i++)
+		assert(fabs(VECTOR(slack)[i] - (length - VECTOR(top)[i] -
+					       VECTOR(bottom)[i])) < EPS);
+
+	// the path goes from a source to a sink, through tasks without slack
+	if(n == 0)
+		assert(igraph_vector_size(&path) == 0);
+	else
+	{
+		igraph_degree(g,&rtop,igraph_vss_1(VECTOR(path)[0]),IGRAPH_IN,0);
+		assert(VECTOR(rtop)[0] == 0);
+		to = VECTOR(path)[igraph_vector_size(&path)-1];
+		igraph_degree(g,&rtop,igraph_vss_1(to),IGRAPH_OUT,0);
+		assert(VECTOR(rtop)[0] == 0);
+	}
+	for(i = 0, sum = 0; i < (unsigned long)igraph_vector_size(&path); i++)
+	{
+		from = VECTOR(path)[i];
+		assert(VECTOR(slack)[from] < EPS);
+		sum += VECTOR(*w)[from];
+		if(i + 1 < (unsigned long)igraph_vector_size(&path))
+		{
+			to = VECTOR(path)[i+1];
+			igraph_get_eid(g,&eid,from,to,1,1);
+			sum += VECTOR(*c)[eid];
+		}
+	}
+	assert(fabs(sum - length) < EPS);
+
+	igraph_vector_destroy(&rbottom);
+	igraph_vector_destroy(&rtop);
+	igraph_vector_destroy(&slack);
+	igraph_vector_destroy(&bottom);
+	igraph_vector_destroy(&top);
+	igraph_vector_destroy(&path);
+}
+
+int main()
+{
+	igraph_t *g,cycle;
+	igraph_vector_t w,c,*lp;
+	gsl_rng *r;
+	unsigned long n,i;
+	double length;
+	char buf[32];
+	igraph_real_t edges[] = { 0,1, 1,2, 2,0 };
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	assert(ggen_analyze_critical_path(NULL,NULL,NULL,NULL,NULL,NULL,NULL,
+					  NULL) != 0);
+
+	// cycles
+	igraph_vector_view(&w,edges,6);
+	igraph_create(&cycle,&w,3,IGRAPH_DIRECTED);
+	assert(ggen_analyze_critical_path(&cycle,NULL,NULL,NULL,NULL,NULL,NULL,
+					  &length) != 0);
+	igraph_destroy(&cycle);
+
+	igraph_vector_init(&w,0);
+	igraph_vector_init(&c,0);
+	for(n = 0; n < 40; n += 3)
+	{
+		g = ggen_generate_erdos_gnp(r,n,0.2);
+		assert(g != NULL);
+
+		// without weights, the length of the longest path
+		igraph_vector_resize(&w,n);
+		igraph_vector_fill(&w,1);
+		igraph_vector_resize(&c,igraph_ecount(g));
+		igraph_vector_null(&c);
+		check(g,NULL,NULL,&w,&c);
+		lp = ggen_analyze_longest_path(g);
+		assert(ggen_analyze_critical_path(g,NULL,NULL,NULL,NULL,NULL,
+						  NULL,&length) == 0);
+		// the longest path is empty on graphs without edges
+		if(igraph_ecount(g) == 0)
+			assert(length == (n ? 1 : 0));
+		else
+			assert(length == igraph_vector_size(lp));
+		igraph_vector_destroy(lp);
+		free(lp);
+
+		// numeric vertex weights, string edge weights
+		for(i = 0; i < n; i++)
+			VECTOR(w)[i] = gsl_rng_uniform(r)*10;
+		SETVANV(g,"w",&w);
+		for(i = 0; i < (unsigned long)igraph_ecount(g); i++)
+		{
+			snprintf(buf,sizeof(buf),"%d",(int)gsl_rng_uniform_int(r,5));
+			SETEAS(g,"c",i,buf);
+			VECTOR(c)[i] = atoi(buf);
+		}
+		if(n > 0 && igraph_ecount(g) > 0)
+			check(g,"w","c",&w,&c);
+
+		// missing attributes
+		if(n > 0)
+		{
+			assert(ggen_analyze_critical_path(g,"nope",NULL,NULL,NULL,
+							  NULL,NULL,NULL) != 0);
+			SETVAS(g,"bad",0,"x");
+			assert(ggen_analyze_critical_path(g,"bad",NULL,NULL,NULL,
+							  NULL,NULL,NULL) != 0);
+		}
+		igraph_destroy(g);
+		free(g);
+	}
+	igraph_vector_destroy(&c);
+	igraph_vector_destroy(&w);
+	gsl_rng_free(r);
+	return 0;
+}
@@ -0,0 +1,123 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ */
+/* This file tests the adjacency snapshots against the neighbours and incident
+ * edges igraph lists, in the same order, including multiple edges.
+ */
+
+#include "ggen.h"
+#include "csr.h"
+#include <assert.h>
+
+static void check_mode(igraph_t *g, csr_t *c, igraph_neimode_t mode)
+{
+	igraph_vector_t nbrs,eids;
+	const int64_t *offsets;
+	const int32_t *vids,*ids;
+	long v,i;
+
+	offsets = mode == IGRAPH_OUT ? c->out_offsets : c->in_offsets;
+	vids = mode == IGRAPH_OUT ? c->out_targets : c->in_sources;
+	ids = mode == IGRAPH_OUT ? c->out_eids : c->in_eids;
+	igraph_vector_init(&nbrs,0);
+	igraph_vector_init(&eids,0);
+	for(v = 0; v < igraph_vcount(g); v++)
+	{
+		igraph_neighbors(g,&nbrs,v,mode);
+		igraph_incident(g,&eids,v,mode);
+		assert(offsets[v+1] - offsets[v] == igraph_vector_size(&nbrs));
+		for(i = 0; i < igraph_vector_size(&nbrs); i++)
+		{
+			assert(vids[offsets[v]+i] == VECTOR(nbrs)[i]);
+			assert(ids[offsets[v]+i] == VECTOR(eids)[i]);
+		}
+	}
+	igraph_vector_destroy(&eids);
+	igraph_vector_destroy(&nbrs);
+}
+
+static void check(igraph_t *g)
+{
+	csr_t c;
+	assert(csr_init(&c,g) == 0);
+	assert(c.vcount == igraph_vcount(g));
+	assert(c.ecount == igraph_ecount(g));
+	assert(c.out_offsets[c.vcount] == c.ecount);
+	assert(c.in_offsets[c.vcount] == c.ecount);
+	check_mode(g,&c,IGRAPH_OUT);
+	check_mode(g,&c,IGRAPH_IN);
+	csr_free(&c);
+}
+
+int main()
+{
+	igraph_t g;
+	igraph_vector_t edges;
+	gsl_rng *r;
+	unsigned long i,n;
+	igraph_real_t multi[] = { 3,1, 0,2, 3,1, 0,1, 2,1, 0,2, 3,0 };
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	assert(csr_init(NULL,NULL) != 0);
+
+	// empty graphs
+	igraph_empty(&g,0,IGRAPH_DIRECTED);
+	check(&g);
+	igraph_destroy(&g);
+	igraph_empty(&g,5,IGRAPH_DIRECTED);
+	check(&g);
+	igraph_destroy(&g);
+
+	// edges out of order, duplicated
+	igraph_vector_view(&edges,multi,sizeof(multi)/sizeof(multi[0]));
+	igraph_create(&g,&edges,4,IGRAPH_DIRECTED);
+	check(&g);
+	igraph_destroy(&g);
+
+	// random edges, with duplicates
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	for(n = 1; n < 64; n += 7)
+	{
+		igraph_vector_init(&edges,(long)(6*n));
+		for(i = 0; i < 6*n; i++)
+			VECTOR(edges)[i] = gsl_rng_uniform_int(r,n);
+		igraph_create(&g,&edges,n,IGRAPH_DIRECTED);
+		check(&g);
+		igraph_destroy(&g);
+		igraph_vector_destroy(&edges);
+	}
+	gsl_rng_free(r);
+	return 0;
+}
@@ -0,0 +1,242 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ */
+
+/* This file tests the dataflow graphs: sizes, attributes and small
+ * parameters.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+static int kernel_is(igraph_t *g, unsigned long v, const char *name)
+{
+	igraph_strvector_t names;
+	igraph_vector_t types;
+	int ret;
+	igraph_strvector_init(&names,0);
+	igraph_vector_init(&types,0);
+	assert(ggen_get_kernels(g,&names,&types) == 0);
+	ret = !strcmp(STR(names,(long)VECTOR(types)[v]),name);
+	igraph_vector_destroy(&types);
+	igraph_strvector_destroy(&names);
+	return ret;
+}
+
+static void check_size(igraph_t *g, unsigned long v, unsigned long e)
+{
+	igraph_bool_t dag;
+	assert(g != NULL);
+	assert((unsigned long)igraph_vcount(g) == v);
+	assert((unsigned long)igraph_ecount(g) == e);
+	igraph_is_dag(g,&dag);
+	assert(dag);
+	igraph_destroy(g);
+	free(g);
+}
+
+/* streaming: each task comes before its edges, with the same kernels and
+ * coordinates as in the built graph.
+ */
+struct check_sink {
+	igraph_t *g;
+	unsigned long tasks;
+	unsigned long edges;
+};
+
+static int check_task(void *data, unsigned long v, const char *kernel)
+{
+	struct check_sink *c = data;
+	assert(v == c->tasks);
+	assert(kernel_is(c->g,v,kernel));
+	c->tasks++;
+	return 0;
+}
+
+static int check_dependency(void *data, unsigned long from, unsigned long to,
+			    int dims, const unsigned long *coords)
+{
+	struct check_sink *c = data;
+	igraph_integer_t f,t;
+	assert(to + 1 == c->tasks);
+	igraph_edge(c->g,c->edges,&f,&t);
+	assert((unsigned long)f == from && (unsigned long)t == to);
+	assert(dims == 2 && EAN(c->g,"x",c->edges) == coords[0]);
+	assert(EAN(c->g,"y",c->edges) == coords[1]);
+	c->edges++;
+	return 0;
+}
+
+static int check_edge(void *data, unsigned long from, unsigned long to)
+{
+	(void)data;
+	(void)from;
+	(void)to;
+	assert(0);
+	return 1;
+}
+
+static void check_stream(igraph_t *g, unsigned long size, int sparse)
+{
+	struct check_sink c = { g, 0, 0 };
+	struct ggen_edge_sink s = { NULL, NULL, check_edge, NULL, NULL, &c,
+		check_task, check_dependency };
+	if(sparse)
+		assert(ggen_stream_sparselu(size,&s) == 0);
+	else
+		assert(ggen_stream_cholesky(size,&s) == 0);
+	assert(c.tasks == (unsigned long)igraph_vcount(g) &&
+	       c.edges == (unsigned long)igraph_ecount(g));
+	igraph_destroy(g);
+	free(g);
+}
+
+int main()
+{
+	igraph_t *g, r;
+	igraph_integer_t from,to;
+	igraph_strvector_t names;
+	igraph_vector_t types;
+	FILE *f;
+	unsigned long n,i;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+	// cholesky: n potrf, n(n-1)/2 trsm and syrk, n(n-1)(n-2)/6 gemm
+	for(n = 0; n < 10; n++)
+	{
+		g = ggen_generate_cholesky(n);
+		assert(g != NULL);
+		assert((unsigned long)igraph_vcount(g) ==
+		       n + n*(n-1) + n*(n-1)*(n-2)/6);
+		igraph_destroy(g);
+		free(g);
+	}
+	g = ggen_generate_cholesky(3);
+	assert(kernel_is(g,0,"potrf"));
+	assert(kernel_is(g,1,"trsm"));
+	// the first edge is potrf [0,0] -> trsm
+	igraph_edge(g,0,&from,&to);
+	assert(from == 0 && to == 1);
+	assert(EAN(g,"x",0) == 0 && EAN(g,"y",0) == 0);
+
+	// kernel names are only expanded on output, and interned on input
+	f = tmpfile();
+	assert(f != NULL);
+	assert(ggen_write_graph(g,f) == 0);
+	rewind(f);
+	assert(ggen_read_graph(&r,f) == 0);
+	fclose(f);
+	assert(igraph_cattribute_has_attr(&r,IGRAPH_ATTRIBUTE_VERTEX,
+					  GGEN_KERNEL_ATTR));
+	for(i = 0; i < 10; i++)
+		assert(VAN(&r,GGEN_KERNEL_ATTR,i) >= 0);
+	assert(kernel_is(&r,0,"potrf"));
+
+	// a sink added to a read graph has no kernel, and is written empty
+	assert(ggen_transform_add(&r,GGEN_TRANSFORM_SINK) == 0);
+	igraph_strvector_init(&names,0);
+	igraph_vector_init(&types,0);
+	assert(ggen_get_kernels(&r,&names,&types) == 0);
+	assert(VECTOR(types)[10] == -1);
+	assert(VECTOR(types)[0] >= 0);
+	assert(ggen_set_costs(&r,4,NULL,0) == 0);
+	assert(VAN(&r,GGEN_COST_ATTR,10) == 0);
+	f = tmpfile();
+	assert(f != NULL);
+	assert(ggen_write_graph(&r,f) == 0);
+	igraph_destroy(&r);
+	rewind(f);
+	assert(ggen_read_graph(&r,f) == 0);
+	fclose(f);
+	assert(igraph_vcount(&r) == 11);
+	assert(kernel_is(&r,0,"potrf"));
+	assert(ggen_get_kernels(&r,&names,&types) == 0);
+	assert(VECTOR(types)[10] == -1);
+	for(i = 0; i < (unsigned long)igraph_strvector_size(&names); i++)
+		assert(STR(names,i)[0] != '\0');
+	assert(ggen_set_costs(&r,4,NULL,0) == 0);
+	assert(VAN(&r,GGEN_COST_ATTR,10) == 0);
+	igraph_destroy(&r);
+
+	// kernel names that cannot be interned stay a string attribute
+	f = tmpfile();
+	assert(f != NULL);
+	fprintf(f,"digraph { a [kernel=\"x,y\"]; b [kernel=\"z\"]; a -> b; }\n");
+	rewind(f);
+	assert(ggen_read_graph(&r,f) == 0);
+	fclose(f);
+	assert(!strcmp(VAS(&r,GGEN_KERNEL_ATTR,0),"x,y"));
+	assert(ggen_get_kernels(&r,&names,&types) == 0);
+	assert(igraph_strvector_size(&names) == 2);
+	assert(ggen_set_kernels(&r,&names,&types) != 0);
+	f = tmpfile();
+	assert(f != NULL);
+	assert(ggen_write_graph(&r,f) == 0);
+	fclose(f);
+	igraph_vector_destroy(&types);
+	igraph_strvector_destroy(&names);
+	igraph_destroy(&r);
+	check_size(g,10,12);
+
+	// lu: the dense version has more tasks than the sparse one
+	g = ggen_generate_denselu(4);
+	assert(kernel_is(g,0,"lu"));
+	check_size(g,30,54);
+	check_size(ggen_generate_sparselu(4),18,26);
+
+	// streaming gives the same graphs
+	for(n = 0; n < 8; n++)
+	{
+		check_stream(ggen_generate_cholesky(n),n,0);
+		check_stream(ggen_generate_sparselu(n),n,1);
+	}
+	assert(ggen_stream_poisson2d(5,2,NULL) != 0);
+
+	// poisson2d: 1D edges, no task on the borders
+	for(n = 0; n < 3; n++)
+		for(i = 0; i < 3; i++)
+			check_size(ggen_generate_poisson2d(n,i),0,0);
+	g = ggen_generate_poisson2d(5,2);
+	assert(kernel_is(g,0,"copy"));
+	assert(kernel_is(g,3,"apply"));
+	for(i = 0; i < (unsigned long)igraph_ecount(g); i++)
+		assert(EAN(g,"x",i) >= 1 && EAN(g,"x",i) <= 3);
+	assert(!igraph_cattribute_has_attr(g,IGRAPH_ATTRIBUTE_EDGE,"y"));
+	check_size(g,12,17);
+	return 0;
+}
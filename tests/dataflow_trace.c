@@ -0,0 +1,138 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ */
+
+/* This file tests the dataflow tracer: each kind of dependency, duplicates
+ * and invalid accesses.
+ */
+
+#include "ggen.h"
+#include "dataflow-trace.h"
+#include <assert.h>
+#include <string.h>
+
+enum { W, R, RW, RR, W3 };
+static const struct dataflow_kernel kernels[] = {
+	{ "w", 1, {{0, DATAFLOW_OUT}} },
+	{ "r", 1, {{0, DATAFLOW_IN}} },
+	{ "rw", 1, {{0, DATAFLOW_INOUT}} },
+	{ "rr", 2, {{0, DATAFLOW_IN}, {0, DATAFLOW_IN}} },
+	{ "w3", 1, {{1, DATAFLOW_OUT}} },
+};
+
+static int kernel_is(igraph_t *g, unsigned long v, const char *name)
+{
+	igraph_strvector_t names;
+	igraph_vector_t types;
+	int ret;
+	igraph_strvector_init(&names,0);
+	igraph_vector_init(&types,0);
+	assert(ggen_get_kernels(g,&names,&types) == 0);
+	ret = !strcmp(STR(names,(long)VECTOR(types)[v]),name);
+	igraph_vector_destroy(&types);
+	igraph_strvector_destroy(&names);
+	return ret;
+}
+
+static void check_edge(igraph_t *g, igraph_integer_t e, igraph_integer_t f,
+		       igraph_integer_t t)
+{
+	igraph_integer_t from, to;
+	igraph_edge(g, e, &from, &to);
+	assert(from == f && to == t);
+}
+
+/* w r r w on the same block, the last task is a rw if inout */
+static void trace(igraph_t *g, int hazards, int inout)
+{
+	struct dataflow_trace t;
+	unsigned long shape[3] = { 4, 2, 2 };
+	assert(dataflow_trace_init(&t, kernels, DATAFLOW_NKERNELS(kernels),
+				   hazards) == 0);
+	assert(dataflow_trace_data(&t, 1, shape) == 0);
+	assert(dataflow_trace_data(&t, 3, shape) == 0);
+	assert(dataflow_trace_task(&t, W, (unsigned long[]){1}) == 0);
+	assert(dataflow_trace_task(&t, R, (unsigned long[]){1}) == 1);
+	assert(dataflow_trace_task(&t, RR, (unsigned long[]){1, 1}) == 2);
+	assert(dataflow_trace_task(&t, inout ? RW : W, (unsigned long[]){1}) == 3);
+	// no data declaration after the first task
+	assert(dataflow_trace_data(&t, 1, shape) != 0);
+	assert(dataflow_trace_graph(&t, g) == 0);
+	dataflow_trace_destroy(&t);
+}
+
+int main()
+{
+	igraph_t g;
+	struct dataflow_trace t;
+	unsigned long shape[3] = { 4, 2, 2 };
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+	// true dependencies only: no duplicate edge for rr
+	trace(&g, DATAFLOW_RAW, 0);
+	assert(igraph_vcount(&g) == 4 && igraph_ecount(&g) == 2);
+	check_edge(&g, 0, 0, 1);
+	check_edge(&g, 1, 0, 2);
+	assert(kernel_is(&g,2,"rr"));
+	assert(EAN(&g, "x", 1) == 1 && EAN(&g, "z", 1) == 0);
+	igraph_destroy(&g);
+
+	// all of them: the last writer waits for the readers, newest first,
+	// and the previous writer.
+	trace(&g, DATAFLOW_ALL, 0);
+	assert(igraph_ecount(&g) == 5);
+	check_edge(&g, 2, 2, 3);
+	check_edge(&g, 3, 1, 3);
+	check_edge(&g, 4, 0, 3);
+	igraph_destroy(&g);
+
+	// an inout only has one edge from the last writer
+	trace(&g, DATAFLOW_RAW|DATAFLOW_WAW, 1);
+	assert(igraph_ecount(&g) == 3);
+	check_edge(&g, 2, 0, 3);
+	igraph_destroy(&g);
+
+	// invalid declarations and accesses
+	assert(dataflow_trace_init(&t, kernels, DATAFLOW_NKERNELS(kernels),
+				   DATAFLOW_ALL) == 0);
+	assert(dataflow_trace_data(&t, 0, shape) != 0);
+	assert(dataflow_trace_data(&t, DATAFLOW_MAX_DIMS+1, shape) != 0);
+	assert(dataflow_trace_data(&t, 3, shape) == 0);
+	dataflow_trace_task(&t, W, (unsigned long[]){1, 2, 0});
+	assert(dataflow_trace_graph(&t, &g) != 0);
+	dataflow_trace_destroy(&t);
+	return 0;
+}
@@ -0,0 +1,160 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the edge-disjoint path decompositions: each path must be a
+ * path of the graph, and the minimum method must find as many paths as the
+ * sum over all vertices of max(0, outdegree - indegree).
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void check(igraph_t *g, enum ggen_paths_t method)
+{
+	igraph_vector_t paths,in,out;
+	igraph_integer_t from,to;
+	unsigned long e,v,p,count,starts,edges,min = 0;
+	unsigned long n = igraph_vcount(g);
+
+	igraph_vector_init(&paths,0);
+	igraph_vector_init(&in,n);
+	igraph_vector_init(&out,n);
+	assert(ggen_analyze_path_decomposition(g,method,&paths,&count) == 0);
+	assert(igraph_vector_size(&paths) == igraph_ecount(g));
+
+	// in each path, vertices have at most one edge in and one out, and
+	// only the first vertex has no edge in
+	for(p = 0; p < count; p++)
+	{
+		igraph_vector_null(&in);
+		igraph_vector_null(&out);
+		for(e = 0, edges = 0; e < (unsigned long)igraph_ecount(g); e++)
+			if(VECTOR(paths)[e] == p)
+			{
+				igraph_edge(g,e,&from,&to);
+				VECTOR(out)[from]++;
+				VECTOR(in)[to]++;
+				edges++;
+			}
+		assert(edges > 0);
+		for(v = 0, starts = 0; v < n; v++)
+		{
+			assert(VECTOR(in)[v] <= 1 && VECTOR(out)[v] <= 1);
+			if(VECTOR(out)[v] == 1 && VECTOR(in)[v] == 0)
+				starts++;
+		}
+		assert(starts == 1);
+	}
+	for(e = 0; e < (unsigned long)igraph_ecount(g); e++)
+		assert(VECTOR(paths)[e] < count);
+
+	igraph_degree(g,&in,igraph_vss_all(),IGRAPH_IN,0);
+	igraph_degree(g,&out,igraph_vss_all(),IGRAPH_OUT,0);
+	for(v = 0; v < n; v++)
+		if(VECTOR(out)[v] > VECTOR(in)[v])
+			min += VECTOR(out)[v] - VECTOR(in)[v];
+	assert(count >= min);
+	if(method == GGEN_PATHS_MINIMUM)
+		assert(count == min);
+
+	igraph_vector_destroy(&out);
+	igraph_vector_destroy(&in);
+	igraph_vector_destroy(&paths);
+}
+
+int main()
+{
+	igraph_t g,*r;
+	igraph_vector_t paths,*p;
+	gsl_rng *rng;
+	unsigned long n,e;
+	double prob;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	rng = gsl_rng_alloc(gsl_rng_mt19937);
+	igraph_vector_init(&paths,0);
+
+	// all ggen methods should fail on incorrect arguments
+	assert(ggen_analyze_edge_disjoint_paths(NULL) == NULL);
+	assert(ggen_analyze_path_decomposition(NULL,GGEN_PATHS_MINIMUM,&paths,
+					       NULL) != 0);
+	igraph_small(&g,3,1,0,1,1,2,-1);
+	assert(ggen_analyze_path_decomposition(&g,GGEN_PATHS_MINIMUM,NULL,
+					       NULL) != 0);
+	assert(ggen_analyze_path_decomposition(&g,42,&paths,NULL) != 0);
+	igraph_destroy(&g);
+
+	// cycles
+	igraph_small(&g,3,1,0,1,1,2,2,0,-1);
+	assert(ggen_analyze_path_decomposition(&g,GGEN_PATHS_MINIMUM,&paths,
+					       NULL) != 0);
+	assert(ggen_analyze_path_decomposition(&g,GGEN_PATHS_SHORTEST,&paths,
+					       NULL) != 0);
+	igraph_destroy(&g);
+
+	// a diamond needs two paths
+	igraph_small(&g,4,1,0,1,0,2,1,3,2,3,-1);
+	check(&g,GGEN_PATHS_SHORTEST);
+	check(&g,GGEN_PATHS_MINIMUM);
+	igraph_destroy(&g);
+
+	for(n = 1; n < 200; n += 13)
+		for(prob = 0.01; prob < 0.5; prob *= 3)
+		{
+			r = ggen_generate_erdos_gnp(rng,n,prob);
+			assert(r != NULL);
+			check(r,GGEN_PATHS_SHORTEST);
+			check(r,GGEN_PATHS_MINIMUM);
+
+			// the old interface is the shortest method
+			p = ggen_analyze_edge_disjoint_paths(r);
+			assert(p != NULL);
+			assert(ggen_analyze_path_decomposition(r,
+				GGEN_PATHS_SHORTEST,&paths,NULL) == 0);
+			for(e = 0; e < (unsigned long)igraph_ecount(r); e++)
+				assert(VECTOR(*p)[e] == VECTOR(paths)[e]);
+			igraph_vector_destroy(p);
+			free(p);
+			igraph_destroy(r);
+			free(r);
+		}
+	igraph_vector_destroy(&paths);
+	gsl_rng_free(rng);
+	return 0;
+}
@@ -0,0 +1,235 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file is an usage exemple of the streaming generation and of the edge
+ * sinks. It also serves as a test file to ensure they work correctly
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <stdio.h>
+
+/* a custom sink counting what it receives, and failing after limit edges */
+struct count {
+	unsigned long n,m,vertices,edges,limit;
+	int begun,ended;
+};
+
+static int count_begin(void *data, unsigned long n, unsigned long m)
+{
+	struct count *c = data;
+	c->n = n;
+	c->m = m;
+	c->begun++;
+	return 0;
+}
+
+static int count_vertex(void *data, unsigned long v)
+{
+	struct count *c = data;
+	assert(c->begun && v == c->vertices);
+	c->vertices++;
+	return 0;
+}
+
+static int count_edge(void *data, unsigned long from, unsigned long to)
+{
+	struct count *c = data;
+	assert(c->vertices == c->n);
+	assert(from < to && to < c->n);
+	if(c->edges == c->limit)
+		return 1;
+	c->edges++;
+	return 0;
+}
+
+static int count_end(void *data)
+{
+	struct count *c = data;
+	c->ended++;
+	return 0;
+}
+
+/* check that two graphs have the same edges in the same order */
+static void check_same(igraph_t *a, igraph_t *b)
+{
+	igraph_integer_t f1,t1,f2,t2;
+	long e;
+
+	assert(igraph_vcount(a) == igraph_vcount(b));
+	assert(igraph_ecount(a) == igraph_ecount(b));
+	for(e = 0; e < igraph_ecount(a); e++)
+	{
+		igraph_edge(a,e,&f1,&t1);
+		igraph_edge(b,e,&f2,&t2);
+		assert(f1 == f2 && t1 == t2);
+	}
+}
+
+/* the streaming and sparse versions give the same graph for the same seed */
+static void check_gnp(const gsl_rng_type *t)
+{
+	gsl_rng *r;
+	igraph_t *g,s;
+	struct ggen_edge_sink *sink;
+
+	r = gsl_rng_alloc(t);
+	assert(r != NULL);
+	gsl_rng_set(r,42);
+	g = ggen_generate_erdos_gnp_sparse(r,1000,0.01);
+	assert(g != NULL);
+
+	gsl_rng_set(r,42);
+	sink = ggen_edge_sink_igraph(&s);
+	assert(sink != NULL);
+	assert(ggen_stream_erdos_gnp(r,1000,0.01,sink) == 0);
+	check_same(g,&s);
+
+	igraph_destroy(&s);
+	ggen_edge_sink_free(sink);
+	igraph_destroy(g);
+	free(g);
+	gsl_rng_free(r);
+}
+
+int main()
+{
+	igraph_t *g,s;
+	gsl_rng *r;
+	struct ggen_edge_sink *sink;
+	struct ggen_edge_sink csink = { count_begin, count_vertex, count_edge,
+		count_end, NULL, NULL, NULL, NULL };
+	struct count c = { 0 };
+	FILE *f;
+	unsigned long a,b,lines;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	assert(r != NULL);
+	csink.data = &c;
+
+	// invalid parameters
+	assert(ggen_edge_sink_dot(NULL,NULL) == NULL);
+	assert(ggen_edge_sink_edgelist(NULL) == NULL);
+	assert(ggen_edge_sink_igraph(NULL) == NULL);
+	assert(ggen_stream_erdos_gnp(r,10,0.5,NULL) != 0);
+	assert(ggen_stream_erdos_gnp(r,10,1.5,&csink) != 0);
+	assert(ggen_stream_erdos_gnm(r,10,46,&csink) != 0);
+	assert(c.begun == 0);
+
+	// every hook is called, in order
+	c.limit = 45;
+	assert(ggen_stream_erdos_gnp(r,10,1.0,&csink) == 0);
+	assert(c.begun == 1 && c.ended == 1);
+	assert(c.vertices == 10 && c.edges == 45 && c.m >= 45);
+
+	// a failing hook stops the generation
+	c = (struct count){ .limit = 10 };
+	assert(ggen_stream_erdos_gnm(r,100,50,&csink) != 0);
+	assert(c.edges == 10 && c.ended == 0);
+
+	// only the edge hook is mandatory
+	c = (struct count){ .n = 10, .vertices = 10, .limit = 45 };
+	csink.vertex = NULL;
+	csink.begin = NULL;
+	assert(ggen_stream_erdos_gnp(r,10,0.5,&csink) == 0);
+	assert(c.begun == 0 && c.ended == 1);
+	csink.edge = NULL;
+	assert(ggen_stream_erdos_gnp(r,10,0.5,&csink) != 0);
+	csink.edge = count_edge;
+
+	// a probability so small that 1-p rounds to 1 streams no edge
+	c = (struct count){ .n = 1000, .vertices = 1000 };
+	assert(ggen_stream_erdos_gnp(r,1000,1e-20,&csink) == 0);
+	assert(c.edges == 0 && c.ended == 1);
+
+	check_gnp(gsl_rng_mt19937);
+	check_gnp(ggen_rng_philox);
+
+	// same for gnm, in both the direct and complement cases
+	for(a = 100; a <= 4900; a += 4800)
+	{
+		gsl_rng_set(r,7);
+		g = ggen_generate_erdos_gnm_sparse(r,100,a);
+		assert(g != NULL);
+		gsl_rng_set(r,7);
+		sink = ggen_edge_sink_igraph(&s);
+		assert(ggen_stream_erdos_gnm(r,100,a,sink) == 0);
+		check_same(g,&s);
+		igraph_destroy(&s);
+		ggen_edge_sink_free(sink);
+		igraph_destroy(g);
+		free(g);
+	}
+
+	// a DOT file can be read back, vertices keeping their ids
+	f = tmpfile();
+	assert(f != NULL);
+	sink = ggen_edge_sink_dot(f,NULL);
+	assert(sink != NULL);
+	gsl_rng_set(r,3);
+	assert(ggen_stream_erdos_gnp(r,200,0.05,sink) == 0);
+	ggen_edge_sink_free(sink);
+	rewind(f);
+	assert(ggen_read_graph(&s,f) == 0);
+	fclose(f);
+	gsl_rng_set(r,3);
+	g = ggen_generate_erdos_gnp_sparse(r,200,0.05);
+	assert(g != NULL);
+	assert(igraph_vcount(&s) == 200);
+	check_same(g,&s);
+	igraph_destroy(&s);
+	igraph_destroy(g);
+	free(g);
+
+	// one line per edge in an edge list
+	f = tmpfile();
+	assert(f != NULL);
+	sink = ggen_edge_sink_edgelist(f);
+	assert(sink != NULL);
+	gsl_rng_set(r,3);
+	assert(ggen_stream_erdos_gnm(r,200,300,sink) == 0);
+	ggen_edge_sink_free(sink);
+	rewind(f);
+	for(lines = 0; fscanf(f,"%lu %lu",&a,&b) == 2; lines++)
+		assert(a < b && b < 200);
+	assert(lines == 300);
+	fclose(f);
+
+	gsl_rng_free(r);
+	return 0;
+}
@@ -42,10 +42,35 @@
 #include "ggen.h"
 #include <assert.h>
 
+/* check that all edges go forward and are unique */
+static void check_edges(igraph_t *g)
+{
+	igraph_matrix_t seen;
+	igraph_integer_t from,to;
+	long e,n = igraph_vcount(g);
+
+	igraph_matrix_init(&seen,n,n);
+	igraph_matrix_null(&seen);
+	for(e = 0; e < igraph_ecount(g); e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		assert(from < to);
+		assert(MATRIX(seen,from,to) == 0);
+		MATRIX(seen,from,to) = 1;
+	}
+	igraph_matrix_destroy(&seen);
+}
+
 int main()
 {
 	igraph_t *g;
 	gsl_rng *r;
+	igraph_integer_t from,to;
+	igraph_vector_ptr_t *sweep;
+	double ms[] = { 100, 4000, 0, 2000 };
+	igraph_vector_t mv;
+	igraph_matrix_t in_big;
+	long e,i;
 
 	r = gsl_rng_alloc(gsl_rng_mt19937);
 	assert(r != NULL);
@@ -75,6 +100,87 @@ int main()
 	igraph_destroy(g);
 	free((void *)g);
 
+	// the sparse method follows the same rules
+	assert(ggen_generate_erdos_gnm_sparse(NULL,10,10) == NULL);
+	assert(ggen_generate_erdos_gnm_sparse(r,10,100) == NULL);
+	assert(ggen_generate_erdos_gnm_sparse(r,1,1) == NULL);
+
+	g = ggen_generate_erdos_gnm_sparse(r,10,0);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 10);
+	assert(igraph_ecount(g) == 0);
+	igraph_destroy(g);
+	free((void *)g);
+
+	g = ggen_generate_erdos_gnm_sparse(r,10,45);
+	assert(g != NULL);
+	assert(igraph_ecount(g) == 45);
+	igraph_destroy(g);
+	free((void *)g);
+
+	g = ggen_generate_erdos_gnm_sparse(r,10,20);
+	assert(g != NULL);
+	assert(igraph_ecount(g) == 20);
+	check_edges(g);
+	igraph_destroy(g);
+	free((void *)g);
+
+	// dense graphs are built from their complement
+	g = ggen_generate_erdos_gnm_sparse(r,10,40);
+	assert(g != NULL);
+	assert(igraph_ecount(g) == 40);
+	check_edges(g);
+	igraph_destroy(g);
+	free((void *)g);
+
+	// more pairs than the rng range, no matrix could hold this graph
+	g = ggen_generate_erdos_gnm_sparse(r,200000,1000);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 200000);
+	assert(igraph_ecount(g) == 1000);
+	for(e = 0; e < 1000; e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		assert(from < to && to < 200000);
+	}
+	igraph_destroy(g);
+	free((void *)g);
+
+	// sweeps: invalid parameters
+	igraph_vector_view(&mv,ms,0);
+	assert(ggen_generate_erdos_gnm_sweep(r,100,&mv) == NULL);
+	igraph_vector_view(&mv,ms,4);
+	assert(ggen_generate_erdos_gnm_sweep(NULL,100,&mv) == NULL);
+	assert(ggen_generate_erdos_gnm_sweep(r,10,&mv) == NULL);
+
+	// sweep graphs have exactly m edges and are nested
+	sweep = ggen_generate_erdos_gnm_sweep(r,100,&mv);
+	assert(sweep != NULL);
+	assert(igraph_vector_ptr_size(sweep) == 4);
+	for(i = 0; i < 4; i++)
+	{
+		assert(igraph_vcount(VECTOR(*sweep)[i]) == 100);
+		assert(igraph_ecount(VECTOR(*sweep)[i]) == ms[i]);
+		check_edges(VECTOR(*sweep)[i]);
+	}
+	igraph_matrix_init(&in_big,100,100);
+	igraph_matrix_null(&in_big);
+	g = VECTOR(*sweep)[1];
+	for(e = 0; e < igraph_ecount(g); e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		MATRIX(in_big,from,to) = 1;
+	}
+	g = VECTOR(*sweep)[3];
+	for(e = 0; e < igraph_ecount(g); e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		assert(MATRIX(in_big,from,to) == 1);
+	}
+	igraph_matrix_destroy(&in_big);
+	igraph_vector_ptr_destroy_all(sweep);
+	free(sweep);
+
 	gsl_rng_free(r);
 	return 0;
 }
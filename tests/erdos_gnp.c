@@ -42,13 +42,41 @@
 #include "ggen.h"
 #include <assert.h>
 
+/* check that all edges of a are in b */
+static void check_subgraph(igraph_t *a, igraph_t *b)
+{
+	igraph_matrix_t in_b;
+	igraph_integer_t from,to;
+	long e,n = igraph_vcount(b);
+
+	igraph_matrix_init(&in_b,n,n);
+	igraph_matrix_null(&in_b);
+	for(e = 0; e < igraph_ecount(b); e++)
+	{
+		igraph_edge(b,e,&from,&to);
+		MATRIX(in_b,from,to) = 1;
+	}
+	for(e = 0; e < igraph_ecount(a); e++)
+	{
+		igraph_edge(a,e,&from,&to);
+		assert(MATRIX(in_b,from,to) == 1);
+	}
+	igraph_matrix_destroy(&in_b);
+}
+
 int main()
 {
 	igraph_t *g;
-	gsl_rng *r;
+	gsl_rng *r,*s;
+	igraph_vector_t edges;
+	igraph_vector_ptr_t *sweep;
+	double ps[] = { 0.5, 0.01, 0.1, 0.0 };
+	igraph_vector_t pv;
+	long i;
 
 	r = gsl_rng_alloc(gsl_rng_mt19937);
 	assert(r != NULL);
+	igraph_vector_init(&edges,0);
 
 	// all ggen methods return NULL on invalid parameters
 	assert(ggen_generate_erdos_gnp(r,10,-1) == NULL);
@@ -82,6 +110,105 @@ int main()
 	igraph_destroy(g);
 	free((void *)g);
 
+	// the sparse method follows the same rules
+	assert(ggen_generate_erdos_gnp_sparse(r,10,-1) == NULL);
+	assert(ggen_generate_erdos_gnp_sparse(r,10,2) == NULL);
+	assert(ggen_generate_erdos_gnp_sparse(NULL,10,0.5) == NULL);
+
+	g = ggen_generate_erdos_gnp_sparse(r,10,0);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 10);
+	assert(igraph_ecount(g) == 0);
+	igraph_destroy(g);
+	free((void *)g);
+
+	g = ggen_generate_erdos_gnp_sparse(r,10,1);
+	assert(g != NULL);
+	assert(igraph_ecount(g) == 45);
+	igraph_destroy(g);
+	free((void *)g);
+
+	g = ggen_generate_erdos_gnp_sparse(r,0,0.5);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 0);
+	igraph_destroy(g);
+	free((void *)g);
+
+	g = ggen_generate_erdos_gnp_sparse(r,1,0.5);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 1);
+	assert(igraph_ecount(g) == 0);
+	igraph_destroy(g);
+	free((void *)g);
+
+	// sparse edges are only going forward, without duplicates, and their
+	// number stays close to p*n*(n-1)/2 (here 19990, stddev ~140)
+	g = ggen_generate_erdos_gnp_sparse(r,2000,0.01);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 2000);
+	assert(igraph_ecount(g) > 19990 - 1000 && igraph_ecount(g) < 19990 + 1000);
+	igraph_get_edgelist(g,&edges,0);
+	for(i = 0; i < igraph_ecount(g); i++)
+	{
+		assert(VECTOR(edges)[2*i] < VECTOR(edges)[2*i+1]);
+		if(i > 0)
+			assert(VECTOR(edges)[2*i-2] < VECTOR(edges)[2*i] ||
+				(VECTOR(edges)[2*i-2] == VECTOR(edges)[2*i] &&
+				 VECTOR(edges)[2*i-1] < VECTOR(edges)[2*i+1]));
+	}
+	igraph_destroy(g);
+	free((void *)g);
+
+	// tiny probabilities, where 1-p rounds to 1, give no edge instead of
+	// infinite skips, with both kinds of generators
+	for(i = 0; i < 2; i++)
+	{
+		s = gsl_rng_alloc(i ? ggen_rng_philox : gsl_rng_mt19937);
+		assert(s != NULL);
+		g = ggen_generate_erdos_gnp_sparse(s,1000,1e-20);
+		assert(g != NULL);
+		assert(igraph_vcount(g) == 1000);
+		assert(igraph_ecount(g) == 0);
+		igraph_destroy(g);
+		free((void *)g);
+		g = ggen_generate_erdos_gnp_sparse(s,1000,1e-300);
+		assert(g != NULL);
+		assert(igraph_ecount(g) == 0);
+		igraph_destroy(g);
+		free((void *)g);
+		gsl_rng_free(s);
+	}
+
+	// sweeps need a non empty list of probabilities
+	igraph_vector_view(&pv,ps,0);
+	assert(ggen_generate_erdos_gnp_sweep(r,10,&pv) == NULL);
+	igraph_vector_view(&pv,ps,4);
+	assert(ggen_generate_erdos_gnp_sweep(NULL,10,&pv) == NULL);
+	assert(ggen_generate_erdos_gnp_sweep(r,10,NULL) == NULL);
+	ps[3] = 2.0;
+	assert(ggen_generate_erdos_gnp_sweep(r,10,&pv) == NULL);
+	ps[3] = 0.0;
+
+	// sweep graphs come in the order of the list, are nested and have the
+	// expected sizes (out of 44850 pairs)
+	sweep = ggen_generate_erdos_gnp_sweep(r,300,&pv);
+	assert(sweep != NULL);
+	assert(igraph_vector_ptr_size(sweep) == 4);
+	for(i = 0; i < 4; i++)
+		assert(igraph_vcount(VECTOR(*sweep)[i]) == 300);
+	assert(igraph_ecount(VECTOR(*sweep)[0]) > 22425 - 1000 &&
+		igraph_ecount(VECTOR(*sweep)[0]) < 22425 + 1000);
+	assert(igraph_ecount(VECTOR(*sweep)[1]) > 448 - 150 &&
+		igraph_ecount(VECTOR(*sweep)[1]) < 448 + 150);
+	assert(igraph_ecount(VECTOR(*sweep)[2]) > 4485 - 400 &&
+		igraph_ecount(VECTOR(*sweep)[2]) < 4485 + 400);
+	assert(igraph_ecount(VECTOR(*sweep)[3]) == 0);
+	check_subgraph(VECTOR(*sweep)[1],VECTOR(*sweep)[2]);
+	check_subgraph(VECTOR(*sweep)[2],VECTOR(*sweep)[0]);
+	igraph_vector_ptr_destroy_all(sweep);
+	free(sweep);
+
+	igraph_vector_destroy(&edges);
 	gsl_rng_free(r);
 	return 0;
 }
@@ -46,6 +46,10 @@ int main()
 {
 	igraph_t *g;
 	gsl_rng *r;
+	igraph_vector_t degrees,sizes;
+	igraph_bool_t isdag;
+	double sq;
+	long i;
 
 	r = gsl_rng_alloc(gsl_rng_mt19937);
 	assert(r != NULL);
@@ -84,6 +88,43 @@ int main()
 	igraph_destroy(g);
 	free((void *)g);
 
+	// with p equals one, each vertex is connected to all the vertices of
+	// the next layers: the in-degree identifies the layer of a vertex, and
+	// the number of edges is (n^2 - sum of squared layer sizes)/2
+	g = ggen_generate_erdos_lbl(r,50,1,4);
+	assert(g != NULL);
+	igraph_vector_init(&degrees,50);
+	igraph_vector_init(&sizes,51);
+	igraph_degree(g,&degrees,igraph_vss_all(),IGRAPH_IN,0);
+	for(i = 0; i < 50; i++)
+		VECTOR(sizes)[(long)VECTOR(degrees)[i]]++;
+	sq = 0;
+	for(i = 0; i < 51; i++)
+		sq += VECTOR(sizes)[i]*VECTOR(sizes)[i];
+	assert(igraph_ecount(g) == (2500 - sq)/2);
+	igraph_is_dag(g,&isdag);
+	assert(isdag);
+	igraph_vector_destroy(&sizes);
+	igraph_vector_destroy(&degrees);
+	igraph_destroy(g);
+	free((void *)g);
+
+	// a large sparse layered graph, around p*n^2*(1-1/nbl)/2 = 45000 edges
+	g = ggen_generate_erdos_lbl(r,10000,0.001,10);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 10000);
+	assert(igraph_ecount(g) > 43000 && igraph_ecount(g) < 47000);
+	igraph_destroy(g);
+	free((void *)g);
+
+	// a probability so small that 1-p rounds to 1 gives no edge
+	g = ggen_generate_erdos_lbl(r,1000,1e-20,10);
+	assert(g != NULL);
+	assert(igraph_vcount(g) == 1000);
+	assert(igraph_ecount(g) == 0);
+	igraph_destroy(g);
+	free((void *)g);
+
 	gsl_rng_free(r);
 	return 0;
 }
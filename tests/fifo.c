@@ -90,6 +90,21 @@ int main()
 	igraph_destroy(g);
 	free((void*)g);
 
+	// larger fifo: limits still hold, at most od-1 extra vertices
+	g = ggen_generate_fifo(r, 2000, 3, 4);
+	assert(g != NULL);
+	assert(igraph_vcount(g) >= 2000 && igraph_vcount(g) < 2003);
+	igraph_vector_init(&degrees, 0);
+	igraph_degree(g, &degrees, igraph_vss_all(), IGRAPH_OUT, 0);
+	for(i = 0; i < igraph_vcount(g); i++)
+		assert(VECTOR(degrees)[i] <= 3);
+	igraph_degree(g, &degrees, igraph_vss_all(), IGRAPH_IN, 0);
+	for(i = 1; i < igraph_vcount(g); i++)
+		assert(VECTOR(degrees)[i] >= 1 && VECTOR(degrees)[i] <= 4);
+	igraph_vector_destroy(&degrees);
+	igraph_destroy(g);
+	free((void*)g);
+
 	gsl_rng_free(r);
 	return 0;
 }
@@ -0,0 +1,156 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+/* This file tests the cost annotation of task graphs.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+int main()
+{
+	igraph_t *g;
+	igraph_strvector_t names;
+	igraph_vector_t types,edges;
+	struct ggen_kernel_cost table[2] = {
+		{ "gemm", 1.0, 2, 4.0, 1 },
+		{ "potrf", 0.0, 0, 0.0, 0 },
+	};
+	const char *k;
+	double b = 8;
+	long i,src;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	igraph_strvector_init(&names,0);
+	igraph_vector_init(&types,0);
+	igraph_vector_init(&edges,0);
+
+	// built-in costs
+	g = ggen_generate_cholesky(4);
+	assert(g != NULL);
+	assert(ggen_set_costs(g,8,NULL,0) == 0);
+	assert(ggen_get_kernels(g,&names,&types) == 0);
+	for(i = 0; i < igraph_vcount(g); i++)
+	{
+		k = STR(names,(long)VECTOR(types)[i]);
+		if(!strcmp(k,"potrf"))
+			assert(fabs(VAN(g,GGEN_COST_ATTR,i) - b*b*b/3) < 1e-9);
+		else if(!strcmp(k,"gemm"))
+			assert(VAN(g,GGEN_COST_ATTR,i) == 2*b*b*b);
+		else
+			assert(VAN(g,GGEN_COST_ATTR,i) == b*b*b);
+	}
+	for(i = 0; i < igraph_ecount(g); i++)
+		assert(EAN(g,GGEN_COMM_ATTR,i) == b*b);
+
+	// the user table comes first, and costs can be set again
+	assert(ggen_set_costs(g,8,table,2) == 0);
+	igraph_get_edgelist(g,&edges,0);
+	for(i = 0; i < igraph_vcount(g); i++)
+	{
+		k = STR(names,(long)VECTOR(types)[i]);
+		if(!strcmp(k,"potrf"))
+			assert(VAN(g,GGEN_COST_ATTR,i) == 0);
+		else if(!strcmp(k,"gemm"))
+			assert(VAN(g,GGEN_COST_ATTR,i) == b*b);
+		else
+			assert(VAN(g,GGEN_COST_ATTR,i) == b*b*b);
+	}
+	for(i = 0; i < igraph_ecount(g); i++)
+	{
+		src = VECTOR(edges)[2*i];
+		k = STR(names,(long)VECTOR(types)[src]);
+		if(!strcmp(k,"potrf"))
+			assert(EAN(g,GGEN_COMM_ATTR,i) == 0);
+		else if(!strcmp(k,"gemm"))
+			assert(EAN(g,GGEN_COMM_ATTR,i) == 4*b);
+		else
+			assert(EAN(g,GGEN_COMM_ATTR,i) == b*b);
+	}
+
+	// unknown kernels
+	igraph_strvector_resize(&names,1);
+	igraph_strvector_set(&names,0,"mystery");
+	igraph_vector_null(&types);
+	assert(ggen_set_kernels(g,&names,&types) == 0);
+	assert(ggen_set_costs(g,8,NULL,0) != 0);
+	table[1].name = "mystery";
+	assert(ggen_set_costs(g,8,table,2) == 0);
+	assert(VAN(g,GGEN_COST_ATTR,0) == 0);
+	igraph_destroy(g);
+	free(g);
+
+	// every kernel of the generators has a cost
+	g = ggen_generate_strassen(64,2,4);
+	assert(g != NULL);
+	assert(ggen_set_costs(g,4,NULL,0) == 0);
+	igraph_destroy(g);
+	free(g);
+
+	g = ggen_generate_denselu(3);
+	assert(g != NULL);
+	assert(ggen_set_costs(g,4,NULL,0) == 0);
+	igraph_destroy(g);
+	free(g);
+
+	g = ggen_generate_sparselu(3);
+	assert(g != NULL);
+	assert(ggen_set_costs(g,4,NULL,0) == 0);
+	igraph_destroy(g);
+	free(g);
+
+	g = ggen_generate_poisson2d(4,2);
+	assert(g != NULL);
+	assert(ggen_set_costs(g,4,NULL,0) == 0);
+	igraph_destroy(g);
+	free(g);
+
+	// graphs without kernels
+	g = ggen_generate_fibonacci(6,0);
+	assert(g != NULL);
+	assert(ggen_set_costs(g,4,NULL,0) != 0);
+	igraph_destroy(g);
+	free(g);
+
+	igraph_vector_destroy(&edges);
+	igraph_vector_destroy(&types);
+	igraph_strvector_destroy(&names);
+	return 0;
+}
@@ -0,0 +1,254 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the longest antichain: on small random graphs against an
+ * exhaustive search, on larger ones against the size given by Dilworth's
+ * theorem, computed with a simple augmenting path matching. The chain
+ * decomposition must have as many chains.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXN 400
+
+static char reach[MAXN][MAXN];
+
+/* reach[u][v] iff there is a path from u to v */
+static void closure(igraph_t *g)
+{
+	igraph_integer_t from,to;
+	unsigned long e,i,j,k,n = igraph_vcount(g);
+
+	memset(reach,0,sizeof(reach));
+	for(e = 0; e < (unsigned long)igraph_ecount(g); e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		reach[from][to] = 1;
+	}
+	for(k = 0; k < n; k++)
+		for(i = 0; i < n; i++)
+			if(reach[i][k])
+				for(j = 0; j < n; j++)
+					if(reach[k][j])
+						reach[i][j] = 1;
+}
+
+static int is_antichain(igraph_vector_t *a)
+{
+	unsigned long i,j,u,v;
+
+	for(i = 0; i < (unsigned long)igraph_vector_size(a); i++)
+		for(j = 0; j < (unsigned long)igraph_vector_size(a); j++)
+		{
+			u = VECTOR(*a)[i];
+			v = VECTOR(*a)[j];
+			if(i != j && (u == v || reach[u][v]))
+				return 0;
+		}
+	return 1;
+}
+
+static unsigned long exhaustive(unsigned long n)
+{
+	unsigned long s,u,v,size,best = 0;
+	int ok;
+
+	for(s = 0; s < (1UL << n); s++)
+	{
+		ok = 1;
+		size = 0;
+		for(u = 0; u < n && ok; u++)
+			if(s & (1UL << u))
+			{
+				size++;
+				for(v = 0; v < n; v++)
+					if((s & (1UL << v)) && reach[u][v])
+						ok = 0;
+			}
+		if(ok && size > best)
+			best = size;
+	}
+	return best;
+}
+
+static int match[MAXN];
+static char seen[MAXN];
+
+static int augment(unsigned long u, unsigned long n)
+{
+	unsigned long v;
+
+	for(v = 0; v < n; v++)
+		if(reach[u][v] && !seen[v])
+		{
+			seen[v] = 1;
+			if(match[v] == -1 || augment(match[v],n))
+			{
+				match[v] = u;
+				return 1;
+			}
+		}
+	return 0;
+}
+
+/* the width is the number of vertices minus a maximum matching of the
+ * bipartite graph of the closure */
+static unsigned long dilworth(unsigned long n)
+{
+	unsigned long u,m = 0;
+
+	memset(match,-1,sizeof(match));
+	for(u = 0; u < n; u++)
+	{
+		memset(seen,0,sizeof(seen));
+		m += augment(u,n);
+	}
+	return n - m;
+}
+
+/* the chains cover every vertex, each one being totally ordered */
+static int is_chain_decomposition(igraph_vector_t *chains, unsigned long width)
+{
+	unsigned long u,v,n = igraph_vector_size(chains);
+	static char used[MAXN];
+
+	memset(used,0,sizeof(used));
+	for(u = 0; u < n; u++)
+	{
+		if(VECTOR(*chains)[u] < 0 || VECTOR(*chains)[u] >= width)
+			return 0;
+		used[(unsigned long)VECTOR(*chains)[u]] = 1;
+		for(v = u+1; v < n; v++)
+			if(VECTOR(*chains)[u] == VECTOR(*chains)[v] &&
+			   !reach[u][v] && !reach[v][u])
+				return 0;
+	}
+	for(u = 0; u < width; u++)
+		if(!used[u])
+			return 0;
+	return 1;
+}
+
+static void check(igraph_t *g, unsigned long width)
+{
+	igraph_vector_t *a,chains,b;
+	unsigned long i,w;
+
+	a = ggen_analyze_longest_antichain(g);
+	assert(a != NULL);
+	assert((unsigned long)igraph_vector_size(a) == width);
+	for(i = 1; i < (unsigned long)igraph_vector_size(a); i++)
+		assert(VECTOR(*a)[i-1] < VECTOR(*a)[i]);
+	closure(g);
+	assert(is_antichain(a));
+
+	// the chains come with the same antichain
+	igraph_vector_init(&chains,0);
+	igraph_vector_init(&b,0);
+	assert(ggen_analyze_chain_decomposition(g,&chains,&b,&w) == 0);
+	assert(w == width);
+	assert(igraph_vector_size(&chains) == igraph_vcount(g));
+	assert(is_chain_decomposition(&chains,w));
+	assert(igraph_vector_all_e(a,&b));
+	assert(ggen_analyze_chain_decomposition(g,NULL,NULL,&w) == 0);
+	assert(w == width);
+	igraph_vector_destroy(&b);
+	igraph_vector_destroy(&chains);
+	igraph_vector_destroy(a);
+	free(a);
+}
+
+int main()
+{
+	igraph_t g,*r;
+	gsl_rng *rng;
+	unsigned long n;
+	double p;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	rng = gsl_rng_alloc(gsl_rng_mt19937);
+
+	// all ggen methods should fail on incorrect arguments
+	assert(ggen_analyze_longest_antichain(NULL) == NULL);
+	assert(ggen_analyze_chain_decomposition(NULL,NULL,NULL,NULL) != 0);
+
+	// cycles have no antichain
+	igraph_small(&g,3,1,0,1,1,2,2,0,-1);
+	assert(ggen_analyze_longest_antichain(&g) == NULL);
+	igraph_destroy(&g);
+
+	// empty graphs, full dags, the diamond
+	igraph_empty(&g,0,1);
+	check(&g,0);
+	igraph_destroy(&g);
+	igraph_empty(&g,10,1);
+	check(&g,10);
+	igraph_destroy(&g);
+	igraph_full_citation(&g,10,1);
+	check(&g,1);
+	igraph_destroy(&g);
+	igraph_small(&g,4,1,0,1,0,2,1,3,2,3,-1);
+	check(&g,2);
+	igraph_destroy(&g);
+
+	for(n = 1; n <= 14; n++)
+		for(p = 0.1; p < 1.0; p += 0.2)
+		{
+			r = ggen_generate_erdos_gnp(rng,n,p);
+			assert(r != NULL);
+			closure(r);
+			check(r,exhaustive(n));
+			igraph_destroy(r);
+			free(r);
+		}
+
+	for(n = 50; n <= MAXN; n += 50)
+		for(p = 0.005; p < 0.2; p *= 3)
+		{
+			r = ggen_generate_erdos_gnp(rng,n,p);
+			assert(r != NULL);
+			closure(r);
+			check(r,dilworth(n));
+			igraph_destroy(r);
+			free(r);
+		}
+	gsl_rng_free(rng);
+	return 0;
+}
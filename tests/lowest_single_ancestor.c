@@ -0,0 +1,158 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the lowest single ancestor. In a dag with a single source,
+ * the lsa of a vertex is its immediate dominator: of all the vertices every
+ * path from the source to it goes through, the closest one. Dominators are
+ * found here by removing each vertex in turn.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXN 80
+
+static char adj[MAXN][MAXN];
+static char dom[MAXN][MAXN];
+
+/* mark the vertices reachable from v without going through skip */
+static void dfs(unsigned long n, unsigned long v, unsigned long skip, char *seen)
+{
+	unsigned long u;
+
+	seen[v] = 1;
+	for(u = 0; u < n; u++)
+		if(adj[v][u] && !seen[u] && u != skip)
+			dfs(n,u,skip,seen);
+}
+
+static void check(igraph_t *g, unsigned long root)
+{
+	igraph_vector_t *lsa;
+	igraph_integer_t from,to;
+	unsigned long e,u,v,best,n = igraph_vcount(g);
+	unsigned long depth[MAXN];
+	char seen[MAXN];
+
+	memset(adj,0,sizeof(adj));
+	for(e = 0; e < (unsigned long)igraph_ecount(g); e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		adj[from][to] = 1;
+	}
+	// dom[u][v] iff u dominates v
+	memset(dom,0,sizeof(dom));
+	for(u = 0; u < n; u++)
+	{
+		memset(seen,0,sizeof(seen));
+		if(u != root)
+			dfs(n,root,u,seen);
+		for(v = 0; v < n; v++)
+			dom[u][v] = !seen[v];
+	}
+	for(v = 0; v < n; v++)
+		for(u = 0, depth[v] = 0; u < n; u++)
+			depth[v] += dom[u][v];
+
+	lsa = ggen_analyze_lowest_single_ancestor(g);
+	assert(lsa != NULL);
+	assert((unsigned long)igraph_vector_size(lsa) == n);
+	assert(VECTOR(*lsa)[root] == root);
+	for(v = 0; v < n; v++)
+	{
+		if(v == root)
+			continue;
+		best = n;
+		for(u = 0; u < n; u++)
+			if(u != v && dom[u][v] && (best == n || depth[u] > depth[best]))
+				best = u;
+		assert(VECTOR(*lsa)[v] == best);
+	}
+	igraph_vector_destroy(lsa);
+	free(lsa);
+}
+
+int main()
+{
+	igraph_t g,*r;
+	gsl_rng *rng;
+	unsigned long n;
+	double p;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	rng = gsl_rng_alloc(gsl_rng_mt19937);
+
+	// all ggen methods should fail on incorrect arguments
+	assert(ggen_analyze_lowest_single_ancestor(NULL) == NULL);
+
+	// two sources, cycles
+	igraph_small(&g,3,1,0,2,1,2,-1);
+	assert(ggen_analyze_lowest_single_ancestor(&g) == NULL);
+	igraph_destroy(&g);
+	igraph_small(&g,3,1,0,1,1,2,2,1,-1);
+	assert(ggen_analyze_lowest_single_ancestor(&g) == NULL);
+	igraph_destroy(&g);
+
+	// a path is its own lsa tree
+	igraph_small(&g,4,1,3,2,2,1,1,0,-1);
+	check(&g,3);
+	igraph_destroy(&g);
+
+	// the diamond, and a dag with two diamonds in a row
+	igraph_small(&g,4,1,0,1,0,2,1,3,2,3,-1);
+	check(&g,0);
+	igraph_destroy(&g);
+	igraph_small(&g,7,1,0,1,0,2,1,3,2,3,3,4,3,5,4,6,5,6,-1);
+	check(&g,0);
+	igraph_destroy(&g);
+
+	for(n = 1; n < MAXN; n += 7)
+		for(p = 0.02; p < 0.5; p *= 2)
+		{
+			r = ggen_generate_erdos_gnp(rng,n,p);
+			assert(r != NULL);
+			assert(ggen_transform_add(r,GGEN_TRANSFORM_SOURCE) == 0);
+			// the new source is the last vertex
+			check(r,igraph_vcount(r)-1);
+			igraph_destroy(r);
+			free(r);
+		}
+	gsl_rng_free(rng);
+	return 0;
+}
@@ -41,11 +41,71 @@
 
 #include "ggen.h"
 #include <assert.h>
+#include <string.h>
+
+#define N 60
+#define M 200
+#define MAX_ORDERS 11
+
+/* replay the shuffles of the generator and check that its edges are the
+ * pairs ordered by all the orders, sorted by source then target
+ */
+static void check_edges(unsigned int orders)
+{
+	static long pos[MAX_ORDERS][M];
+	long perm[M];
+	gsl_rng *r;
+	igraph_t *g;
+	igraph_vector_t edges;
+	unsigned long e = 0,i,j,t;
+
+	r = gsl_rng_alloc(gsl_rng_mt19937);
+	assert(r != NULL);
+	gsl_rng_set(r,orders);
+	g = ggen_generate_random_orders(r,M,orders);
+	assert(g != NULL);
+
+	gsl_rng_set(r,orders);
+	for(t = 0; t < orders; t++)
+	{
+		for(i = 0; i < M; i++)
+			perm[i] = i;
+		gsl_ran_shuffle(r,perm,M,sizeof(perm[0]));
+		for(i = 0; i < M; i++)
+			pos[t][perm[i]] = i;
+	}
+
+	igraph_vector_init(&edges,0);
+	igraph_get_edgelist(g,&edges,0);
+	for(i = 0; i < M; i++)
+		for(j = 0; j < M; j++)
+		{
+			for(t = 0; t < orders && pos[t][i] < pos[t][j]; t++)
+				;
+			if(t < orders)
+				continue;
+			assert(e < (unsigned long)igraph_ecount(g));
+			assert(VECTOR(edges)[2*e] == i);
+			assert(VECTOR(edges)[2*e+1] == j);
+			e++;
+		}
+	assert(e == (unsigned long)igraph_ecount(g));
+
+	igraph_vector_destroy(&edges);
+	igraph_destroy(g);
+	free((void *)g);
+	gsl_rng_free(r);
+}
 
 int main()
 {
 	igraph_t *g;
 	gsl_rng *r;
+	igraph_vector_t edges;
+	igraph_bool_t isdag;
+	char adj[N][N];
+	unsigned int orders;
+	long e,i,j,k;
 
 	r = gsl_rng_alloc(gsl_rng_mt19937);
 	assert(r != NULL);
@@ -60,6 +120,41 @@ int main()
 	igraph_destroy(g);
 	free((void *)g);
 
+	// one order is a total order
+	g = ggen_generate_random_orders(r,N,1);
+	assert(g != NULL);
+	assert(igraph_ecount(g) == N*(N-1)/2);
+	igraph_destroy(g);
+	free((void *)g);
+
+	// an intersection of orders is a transitive DAG
+	igraph_vector_init(&edges,0);
+	for(orders = 2; orders < 5; orders++)
+	{
+		g = ggen_generate_random_orders(r,N,orders);
+		assert(g != NULL);
+		assert(igraph_vcount(g) == N);
+		igraph_is_dag(g,&isdag);
+		assert(isdag);
+
+		memset(adj,0,sizeof(adj));
+		igraph_get_edgelist(g,&edges,0);
+		for(e = 0; e < igraph_ecount(g); e++)
+			adj[(long)VECTOR(edges)[2*e]][(long)VECTOR(edges)[2*e+1]] = 1;
+		for(i = 0; i < N; i++)
+			for(j = 0; j < N; j++)
+				for(k = 0; k < N; k++)
+					if(adj[i][j] && adj[j][k])
+						assert(adj[i][k]);
+		igraph_destroy(g);
+		free((void *)g);
+	}
+	igraph_vector_destroy(&edges);
+
+	// exact edges, on both sides of the packed bitsets limit
+	for(orders = 1; orders <= MAX_ORDERS; orders++)
+		check_edges(orders);
+
 	gsl_rng_free(r);
 	return 0;
 }
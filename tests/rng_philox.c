@@ -0,0 +1,173 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+*/
+
+/* This file tests the counter based random number generator, and the
+ * generators using one stream per row with it, on several threads.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+
+/* known answers of the Random123 reference implementation */
+static void check_block(gsl_rng *r, unsigned long seed, unsigned long stream,
+		unsigned long counter, const unsigned long out[4])
+{
+	int i;
+	gsl_rng_set(r,seed);
+	assert(ggen_rng_philox_seek(r,stream,counter) == 0);
+	for(i = 0; i < 4; i++)
+		assert(gsl_rng_get(r) == out[i]);
+}
+
+int main()
+{
+	gsl_rng *r,*s;
+	igraph_t *g,*h;
+	igraph_vector_t e1,e2,e3;
+	unsigned long stream,counter,x[8];
+	const unsigned long zeros[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+	const unsigned long ones[4] = { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd };
+	const unsigned long pi[4] = { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 };
+	int i;
+
+	r = gsl_rng_alloc(ggen_rng_philox);
+	assert(r != NULL);
+	s = gsl_rng_alloc(gsl_rng_mt19937);
+	assert(s != NULL);
+
+	check_block(r,0,0,0,zeros);
+	check_block(r,0xffffffffffffffffUL,0xffffffffffffffffUL,0xffffffffffffffffUL,ones);
+	check_block(r,0x299f31d0a4093822UL,0x0370734413198a2eUL,0x85a308d3243f6a88UL,pi);
+
+	// only philox generators can seek
+	assert(ggen_rng_philox_seek(s,0,0) != 0);
+	assert(ggen_rng_philox_tell(s,&stream,&counter) != 0);
+
+	// any position can be reached again
+	gsl_rng_set(r,42);
+	ggen_rng_philox_seek(r,7,3);
+	for(i = 0; i < 8; i++)
+		x[i] = gsl_rng_get(r);
+	ggen_rng_philox_tell(r,&stream,&counter);
+	assert(stream == 7 && counter == 5);
+	ggen_rng_philox_seek(r,7,4);
+	for(i = 4; i < 8; i++)
+		assert(gsl_rng_get(r) == x[i]);
+
+	// row generators use one stream per row, and skip them all
+	igraph_vector_init(&e1,0);
+	igraph_vector_init(&e2,0);
+	igraph_vector_init(&e3,0);
+	gsl_rng_set(r,42);
+	g = ggen_generate_erdos_gnp(r,100,0.1);
+	assert(g != NULL);
+	ggen_rng_philox_tell(r,&stream,&counter);
+	assert(stream == 101 && counter == 0);
+	assert(igraph_ecount(g) > 495 - 150 && igraph_ecount(g) < 495 + 150);
+	gsl_rng_set(r,42);
+	h = ggen_generate_erdos_gnp(r,100,0.1);
+	igraph_get_edgelist(g,&e1,0);
+	igraph_get_edgelist(h,&e2,0);
+	assert(igraph_vector_all_e(&e1,&e2));
+	igraph_destroy(g);
+	free(g);
+	igraph_destroy(h);
+	free(h);
+
+	// a row only depends on its stream: the rows of a graph started at
+	// stream 10 are the rows 10 and following of a graph started at stream 0
+	gsl_rng_set(r,42);
+	g = ggen_generate_erdos_gnp_sparse(r,1000,0.01);
+	assert(g != NULL);
+	ggen_rng_philox_tell(r,&stream,&counter);
+	assert(stream == 1001);
+	assert(igraph_ecount(g) > 4995 - 500 && igraph_ecount(g) < 4995 + 500);
+	gsl_rng_set(r,42);
+	ggen_rng_philox_seek(r,10,0);
+	h = ggen_generate_erdos_gnp_sparse(r,990,0.01);
+	assert(h != NULL);
+	igraph_get_edgelist(g,&e1,0);
+	igraph_get_edgelist(h,&e2,0);
+	for(i = 0; 2*i < igraph_vector_size(&e1) && VECTOR(e1)[2*i] < 10; i++);
+	assert(igraph_vector_size(&e1) - 2*i == igraph_vector_size(&e2));
+	for(counter = 0; counter < (unsigned long)igraph_vector_size(&e2); counter++)
+		assert(VECTOR(e1)[2*i+counter] == VECTOR(e2)[counter] + 10);
+	igraph_destroy(g);
+	free(g);
+	igraph_destroy(h);
+	free(h);
+
+	// the number of threads does not change the graphs
+	assert(ggen_set_threads(0) != 0);
+	assert(ggen_get_threads() == 1);
+	gsl_rng_set(r,7);
+	g = ggen_generate_erdos_gnp_sparse(r,2000,0.005);
+	assert(g != NULL);
+	igraph_get_edgelist(g,&e1,0);
+	igraph_destroy(g);
+	free(g);
+	gsl_rng_set(r,7);
+	g = ggen_generate_erdos_lbl(r,2000,0.005,5);
+	assert(g != NULL);
+	igraph_get_edgelist(g,&e2,0);
+	igraph_destroy(g);
+	free(g);
+	assert(ggen_set_threads(5) == 0);
+	assert(ggen_get_threads() == 5);
+	gsl_rng_set(r,7);
+	g = ggen_generate_erdos_gnp_sparse(r,2000,0.005);
+	assert(g != NULL);
+	igraph_get_edgelist(g,&e3,0);
+	assert(igraph_vector_all_e(&e1,&e3));
+	igraph_destroy(g);
+	free(g);
+	gsl_rng_set(r,7);
+	g = ggen_generate_erdos_lbl(r,2000,0.005,5);
+	assert(g != NULL);
+	igraph_get_edgelist(g,&e3,0);
+	assert(igraph_vector_all_e(&e2,&e3));
+	igraph_destroy(g);
+	free(g);
+	ggen_set_threads(1);
+
+	igraph_vector_destroy(&e1);
+	igraph_vector_destroy(&e2);
+	igraph_vector_destroy(&e3);
+	gsl_rng_free(r);
+	gsl_rng_free(s);
+	return 0;
+}
@@ -0,0 +1,173 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the static graphs, and that their predicted sizes are the
+ * ones of the generated graphs.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <string.h>
+
+static int kernel_is(igraph_t *g, unsigned long v, const char *name)
+{
+	igraph_strvector_t names;
+	igraph_vector_t types;
+	int ret;
+	igraph_strvector_init(&names,0);
+	igraph_vector_init(&types,0);
+	assert(ggen_get_kernels(g,&names,&types) == 0);
+	ret = !strcmp(STR(names,(long)VECTOR(types)[v]),name);
+	igraph_vector_destroy(&types);
+	igraph_strvector_destroy(&names);
+	return ret;
+}
+
+static void check_size(igraph_t *g, unsigned long v, unsigned long e)
+{
+	igraph_bool_t dag;
+	assert(g != NULL);
+	assert((unsigned long)igraph_vcount(g) == v);
+	assert((unsigned long)igraph_ecount(g) == e);
+	igraph_is_dag(g,&dag);
+	assert(dag);
+	igraph_destroy(g);
+	free(g);
+}
+
+/* same edges, in the same order, and same vertex attribute */
+static void check_same(igraph_t *a, igraph_t *b, const char *attr)
+{
+	igraph_integer_t f1,t1,f2,t2;
+	igraph_strvector_t names;
+	igraph_vector_t ta,tb;
+	long i;
+	assert(a != NULL && b != NULL);
+	assert(igraph_vcount(a) == igraph_vcount(b));
+	assert(igraph_ecount(a) == igraph_ecount(b));
+	for(i = 0; i < igraph_ecount(a); i++)
+	{
+		igraph_edge(a,i,&f1,&t1);
+		igraph_edge(b,i,&f2,&t2);
+		assert(f1 == f2 && t1 == t2);
+	}
+	if(attr != NULL)
+		for(i = 0; i < igraph_vcount(a); i++)
+			assert(VAN(a,attr,i) == VAN(b,attr,i));
+	else
+	{
+		igraph_strvector_init(&names,0);
+		igraph_vector_init(&ta,0);
+		igraph_vector_init(&tb,0);
+		assert(ggen_get_kernels(a,&names,&ta) == 0);
+		assert(ggen_get_kernels(b,&names,&tb) == 0);
+		assert(igraph_vector_all_e(&ta,&tb));
+		igraph_vector_destroy(&ta);
+		igraph_vector_destroy(&tb);
+		igraph_strvector_destroy(&names);
+	}
+	igraph_destroy(a);
+	igraph_destroy(b);
+	free(a);
+	free(b);
+}
+
+int main()
+{
+	igraph_t *g;
+	unsigned long n,c,v,e;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+
+	// invalid parameters and sizes too big to count
+	assert(ggen_count_fibonacci(5,6,&v,&e) != 0);
+	assert(ggen_generate_fibonacci(5,6) == NULL);
+	assert(ggen_count_fibonacci(200,0,&v,&e) != 0);
+	assert(ggen_count_forkjoin(1,1,NULL,&e) != 0);
+	assert(ggen_count_strassen(1UL << 40,30,0,&v,&e) != 0);
+
+	// fibonacci: known values, a tree
+	assert(ggen_count_fibonacci(0,0,&v,&e) == 0 && v == 1 && e == 0);
+	assert(ggen_count_fibonacci(3,0,&v,&e) == 0 && v == 5 && e == 4);
+	assert(ggen_count_fibonacci(10,2,&v,&e) == 0 && v == 109 && e == 108);
+	for(n = 0; n < 15; n++)
+		for(c = 0; c <= n; c++)
+		{
+			assert(ggen_count_fibonacci(n,c,&v,&e) == 0);
+			g = ggen_generate_fibonacci(n,c);
+			assert(VAN(g,"n",0) == n);
+			check_size(g,v,e);
+		}
+
+	// fork-join
+	assert(ggen_count_forkjoin(3,4,&v,&e) == 0 && v == 16 && e == 24);
+	for(n = 0; n < 5; n++)
+		for(c = 0; c < 5; c++)
+		{
+			assert(ggen_count_forkjoin(n,c,&v,&e) == 0);
+			check_size(ggen_generate_forkjoin(n,c),v,e);
+		}
+
+	// strassen: each recursion level multiplies by 7
+	assert(ggen_count_strassen(1024,4,16,&v,&e) == 0 && v == 1141 && e == 2394);
+	assert(ggen_count_strassen(1024,1,16,&v,&e) == 0 && v == 1 && e == 0);
+	for(n = 1; n <= 64; n *= 4)
+		for(c = 0; c < 5; c++)
+		{
+			assert(ggen_count_strassen(n,c,4,&v,&e) == 0);
+			g = ggen_generate_strassen(n,c,4);
+			assert(kernel_is(g,0,"strassen"));
+			check_size(g,v,e);
+		}
+
+	// recursive graphs built by several threads are the same
+	for(n = 1; n <= 5; n += 2)
+	{
+		for(c = 0; c <= 4; c++)
+		{
+			assert(ggen_set_threads(1) == 0);
+			g = ggen_generate_fibonacci(17,c);
+			assert(ggen_set_threads(n) == 0);
+			check_same(g,ggen_generate_fibonacci(17,c),"n");
+		}
+		assert(ggen_set_threads(1) == 0);
+		g = ggen_generate_strassen(256,5,2);
+		assert(ggen_set_threads(n) == 0);
+		check_same(g,ggen_generate_strassen(256,5,2),NULL);
+	}
+	return 0;
+}
@@ -0,0 +1,246 @@
+/* Copyright Swann Perarnau 2009
+ *
+ *   contributor(s) :
+ *
+ *   contact : Swann.Perarnau@imag.fr
+ *
+ * This software is a computer program whose purpose is to help the
+ * random generation of graph structures and adding various properties
+ * on those structures.
+ *
+ * This software is governed by the CeCILL  license under French law and
+ * abiding by the rules of distribution of free software.  You can  use,
+ * modify and/ or redistribute the software under the terms of the CeCILL
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and  rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty  and the software's author,  the holder of the
+ * economic rights,  and the successive licensors  have only  limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading,  using,  modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean  that it is complicated to manipulate,  and  that  also
+ * therefore means  that it is reserved for developers  and  experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and,  more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL license and that you accept its terms.
+ */
+
+/* This file tests the summary analysis against the individual analyses and
+ * brute force: degrees and levels are recounted from igraph, the width and
+ * the critical path must match their own functions, and each transitive edge
+ * is confirmed by a search avoiding it.
+ */
+
+#include "ggen.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* is there a path from u to v not using the edge (u,v) */
+static int is_transitive(igraph_adjlist_t *adj, long u, long v, char *seen,
+			 long *stack)
+{
+	igraph_vector_int_t *succ;
+	long top = 0, i, w, x;
+	long n = igraph_adjlist_size(adj);
+
+	memset(seen,0,n);
+	succ = igraph_adjlist_get(adj,u);
+	for(i = 0; i < igraph_vector_int_size(succ); i++)
+	{
+		w = VECTOR(*succ)[i];
+		if(w != v && !seen[w])
+		{
+			seen[w] = 1;
+			stack[top++] = w;
+		}
+	}
+	while(top > 0)
+	{
+		w = stack[--top];
+		if(w == v)
+			return 1;
+		succ = igraph_adjlist_get(adj,w);
+		for(i = 0; i < igraph_vector_int_size(succ); i++)
+		{
+			x = VECTOR(*succ)[i];
+			if(!seen[x])
+			{
+				seen[x] = 1;
+				stack[top++] = x;
+			}
+		}
+	}
+	return 0;
+}
+
+static void check(igraph_t *g, const char *vw, const char *ew)
+{
+	struct ggen_summary s,t;
+	igraph_vector_t in,out,level,order;
+	igraph_adjlist_t adj;
+	igraph_integer_t from,to;
+	unsigned long n = igraph_vcount(g), e, v, i, width, sources = 0,
+		      sinks = 0, trans = 0, depth = 0, maxin = 0, maxout = 0;
+	double length;
+	char *seen;
+	long *stack;
+
+	assert(ggen_analyze_summary(g,GGEN_SUMMARY_ALL,vw,ew,&s) == 0);
+	assert(s.vertices == n);
+	assert(s.edges == (unsigned long)igraph_ecount(g));
+
+	// degree distributions and ends
+	igraph_vector_init(&in,0);
+	igraph_vector_init(&out,0);
+	igraph_degree(g,&in,igraph_vss_all(),IGRAPH_IN,0);
+	igraph_degree(g,&out,igraph_vss_all(),IGRAPH_OUT,0);
+	for(v = 0; v < n; v++)
+	{
+		if(VECTOR(in)[v] > maxin)
+			maxin = VECTOR(in)[v];
+		if(VECTOR(out)[v] > maxout)
+			maxout = VECTOR(out)[v];
+		sources += VECTOR(in)[v] == 0;
+		sinks += VECTOR(out)[v] == 0;
+	}
+	assert(s.sources == sources && s.sinks == sinks);
+	assert((unsigned long)igraph_vector_size(&s.in_degrees) ==
+	       (n ? maxin + 1 : 0));
+	assert((unsigned long)igraph_vector_size(&s.out_degrees) ==
+	       (n ? maxout + 1 : 0));
+	for(v = 0; v < n; v++)
+	{
+		VECTOR(s.in_degrees)[(long)VECTOR(in)[v]]--;
+		VECTOR(s.out_degrees)[(long)VECTOR(out)[v]]--;
+	}
+	assert(igraph_vector_isnull(&s.in_degrees));
+	assert(igraph_vector_isnull(&s.out_degrees));
+
+	// levels, relaxed in topological order
+	igraph_vector_init(&order,0);
+	igraph_vector_init(&level,n);
+	igraph_topological_sorting(g,&order,IGRAPH_OUT);
+	for(i = 0; i < n; i++)
+	{
+		v = VECTOR(order)[i];
+		for(e = 0; e < (unsigned long)igraph_ecount(g); e++)
+		{
+			igraph_edge(g,e,&from,&to);
+			if((unsigned long)to == v && VECTOR(level)[from] + 1 > VECTOR(level)[v])
+				VECTOR(level)[v] = VECTOR(level)[from] + 1;
+		}
+		if(VECTOR(level)[v] + 1 > depth)
+			depth = VECTOR(level)[v] + 1;
+	}
+	assert(s.depth == depth);
+	assert((unsigned long)igraph_vector_size(&s.levels) == depth);
+	for(v = 0; v < n; v++)
+		VECTOR(s.levels)[(long)VECTOR(level)[v]]--;
+	assert(igraph_vector_isnull(&s.levels));
+
+	// the individual analyses
+	assert(ggen_analyze_critical_path(g,vw,ew,NULL,NULL,NULL,NULL,
+					  &length) == 0);
+	assert(s.critical_path == length);
+	assert(ggen_analyze_chain_decomposition(g,NULL,NULL,&width) == 0);
+	assert(s.width == width);
+
+	// transitive edges
+	seen = malloc(n+1);
+	stack = malloc((n+1)*sizeof(long));
+	igraph_adjlist_init(g,&adj,IGRAPH_OUT);
+	for(e = 0; e < (unsigned long)igraph_ecount(g); e++)
+	{
+		igraph_edge(g,e,&from,&to);
+		trans += is_transitive(&adj,from,to,seen,stack);
+	}
+	if(igraph_ecount(g) == 0)
+		assert(s.transitive == 0);
+	else
+		assert(s.transitive == (double)trans/igraph_ecount(g));
+	igraph_adjlist_destroy(&adj);
+	free(stack);
+	free(seen);
+
+	// a subset of the metrics leaves the others empty
+	assert(ggen_analyze_summary(g,GGEN_SUMMARY_WIDTH|GGEN_SUMMARY_ENDS,
+				    vw,ew,&t) == 0);
+	assert(t.width == width && t.sources == sources && t.sinks == sinks);
+	assert(t.vertices == 0 && t.depth == 0 && t.transitive == 0);
+	assert(igraph_vector_size(&t.levels) == 0);
+	assert(igraph_vector_size(&t.in_degrees) == 0);
+	ggen_summary_destroy(&t);
+
+	igraph_vector_destroy(&level);
+	igraph_vector_destroy(&order);
+	igraph_vector_destroy(&out);
+	igraph_vector_destroy(&in);
+	ggen_summary_destroy(&s);
+}
+
+int main()
+{
+	igraph_t g,*r;
+	igraph_vector_t w;
+	struct ggen_summary s;
+	gsl_rng *rng;
+	unsigned long n,i;
+	double prob;
+
+	igraph_i_set_attribute_table(&igraph_cattribute_table);
+	rng = gsl_rng_alloc(gsl_rng_mt19937);
+	igraph_vector_init(&w,0);
+
+	// all ggen methods should fail on incorrect arguments
+	igraph_small(&g,3,1,0,1,1,2,-1);
+	assert(ggen_analyze_summary(NULL,GGEN_SUMMARY_ALL,NULL,NULL,&s) != 0);
+	assert(ggen_analyze_summary(&g,GGEN_SUMMARY_ALL,NULL,NULL,NULL) != 0);
+	assert(ggen_analyze_summary(&g,GGEN_SUMMARY_ALL+1,NULL,NULL,&s) != 0);
+	assert(ggen_analyze_summary(&g,GGEN_SUMMARY_CRITICAL_PATH,"nope",NULL,
+				    &s) != 0);
+	igraph_destroy(&g);
+
+	// cycles
+	igraph_small(&g,3,1,0,1,1,2,2,0,-1);
+	assert(ggen_analyze_summary(&g,GGEN_SUMMARY_ALL,NULL,NULL,&s) != 0);
+	igraph_destroy(&g);
+
+	// a diamond with a shortcut: one transitive edge out of five
+	igraph_small(&g,4,1,0,1,0,2,1,3,2,3,0,3,-1);
+	assert(ggen_analyze_summary(&g,GGEN_SUMMARY_ALL,NULL,NULL,&s) == 0);
+	assert(s.depth == 3 && s.width == 2 && s.transitive == 0.2);
+	assert(s.sources == 1 && s.sinks == 1);
+	ggen_summary_destroy(&s);
+	check(&g,NULL,NULL);
+	igraph_destroy(&g);
+
+	for(n = 0; n < 150; n += 11)
+		for(prob = 0.01; prob < 0.5; prob *= 3)
+		{
+			r = ggen_generate_erdos_gnp(rng,n,prob);
+			assert(r != NULL);
+			check(r,NULL,NULL);
+			igraph_vector_resize(&w,n);
+			for(i = 0; i < n; i++)
+				VECTOR(w)[i] = gsl_rng_uniform(rng)*10;
+			SETVANV(r,"w",&w);
+			if(n > 0)
+				check(r,"w",NULL);
+			igraph_destroy(r);
+			free(r);
+		}
+	igraph_vector_destroy(&w);
+	gsl_rng_free(rng);
+	return 0;
+}